@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/navmeshdiskcache.hpp>
+#include <components/detournavigator/navmeshtilescache.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    const osg::Vec3f agentHalfExtents(29, 29, 66);
+    const TilePosition tilePosition(0, 0);
+    constexpr std::size_t maxDiskCacheSize = 64 * 1024 * 1024;
+
+    Settings makeSettings()
+    {
+        Settings settings;
+        settings.mBorderSize = 16;
+        settings.mCellHeight = 0.2f;
+        settings.mCellSize = 0.2f;
+        settings.mDetailSampleDist = 6;
+        settings.mDetailSampleMaxError = 1;
+        settings.mMaxClimb = 34;
+        settings.mMaxSimplificationError = 1.3f;
+        settings.mMaxSlope = 49;
+        settings.mRecastScaleFactor = 0.017647058823529415f;
+        settings.mSwimHeightScale = 0.89999997615814208984375f;
+        settings.mMaxEdgeLen = 12;
+        settings.mMaxNavMeshQueryNodes = 2048;
+        settings.mMaxVertsPerPoly = 6;
+        settings.mRegionMergeSize = 20;
+        settings.mRegionMinSize = 8;
+        settings.mTileSize = 64;
+        settings.mWaitUntilMinDistanceToPlayer = std::numeric_limits<int>::max();
+        settings.mAsyncNavMeshUpdaterThreads = 1;
+        settings.mMaxNavMeshTilesCacheSize = 64 * 1024 * 1024;
+        settings.mMaxPolygonPathSize = 1024;
+        settings.mMaxSmoothPathSize = 1024;
+        settings.mMaxPolys = 4096;
+        settings.mMaxTilesNumber = 512;
+        settings.mMinUpdateInterval = std::chrono::milliseconds(50);
+        return settings;
+    }
+
+    // Hilly ground a bit wider than the tile, in recast coordinates
+    RecastMesh makeRecastMesh(const Settings& settings)
+    {
+        const int quads = 64;
+        const float tileSize = settings.mTileSize * settings.mCellSize;
+        const float min = -0.25f * tileSize;
+        const float step = 1.5f * tileSize / quads;
+
+        std::vector<float> vertices;
+        for (int z = 0; z <= quads; ++z)
+        {
+            for (int x = 0; x <= quads; ++x)
+            {
+                vertices.push_back(min + x * step);
+                vertices.push_back(std::sin(x * 0.3f) * std::cos(z * 0.2f));
+                vertices.push_back(min + z * step);
+            }
+        }
+
+        std::vector<int> indices;
+        for (int z = 0; z < quads; ++z)
+        {
+            for (int x = 0; x < quads; ++x)
+            {
+                const int first = z * (quads + 1) + x;
+                const int next = first + quads + 1;
+                indices.insert(indices.end(), {first, next, first + 1, first + 1, next, next + 1});
+            }
+        }
+
+        std::vector<AreaType> areaTypes(indices.size() / 3, AreaType_ground);
+
+        return RecastMesh(0, 0, std::move(indices), std::move(vertices), std::move(areaTypes), {});
+    }
+
+    struct TemporaryDirectory
+    {
+        const boost::filesystem::path mPath = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-navmeshdiskcache-benchmark-%%%%-%%%%-%%%%");
+
+        ~TemporaryDirectory()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(mPath, ec);
+        }
+    };
+
+    // A tile requested for the first time in a session, so the in-memory cache is empty
+    UpdateNavMeshStatus updateTile(const Settings& settings, const RecastMesh& recastMesh,
+        NavMeshDiskCache* navMeshDiskCache)
+    {
+        NavMeshTilesCache navMeshTilesCache(settings.mMaxNavMeshTilesCacheSize);
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(settings), 1);
+        return updateNavMesh(agentHalfExtents, &recastMesh, tilePosition, tilePosition, {}, settings,
+            navMeshCacheItem, navMeshTilesCache, navMeshDiskCache);
+    }
+
+    void updateNavMeshColdStart(benchmark::State& state)
+    {
+        const Settings settings = makeSettings();
+        const RecastMesh recastMesh = makeRecastMesh(settings);
+
+        for (auto _ : state)
+        {
+            const auto status = updateTile(settings, recastMesh, nullptr);
+            benchmark::DoNotOptimize(status);
+        }
+    }
+
+    void updateNavMeshColdStartWithDiskCache(benchmark::State& state)
+    {
+        const Settings settings = makeSettings();
+        const RecastMesh recastMesh = makeRecastMesh(settings);
+        const TemporaryDirectory directory;
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            // A new directory each time to always miss
+            state.PauseTiming();
+            auto navMeshDiskCache = std::make_unique<NavMeshDiskCache>(
+                (directory.mPath / std::to_string(n++)).string(), maxDiskCacheSize, settings);
+            state.ResumeTiming();
+
+            const auto status = updateTile(settings, recastMesh, navMeshDiskCache.get());
+            benchmark::DoNotOptimize(status);
+
+            state.PauseTiming();
+            navMeshDiskCache.reset();
+            state.ResumeTiming();
+        }
+    }
+
+    void updateNavMeshWarmStart(benchmark::State& state)
+    {
+        const Settings settings = makeSettings();
+        const RecastMesh recastMesh = makeRecastMesh(settings);
+        const TemporaryDirectory directory;
+
+        NavMeshDiskCache navMeshDiskCache(directory.mPath.string(), maxDiskCacheSize, settings);
+        updateTile(settings, recastMesh, &navMeshDiskCache);
+        navMeshDiskCache.wait();
+
+        for (auto _ : state)
+        {
+            const auto status = updateTile(settings, recastMesh, &navMeshDiskCache);
+            benchmark::DoNotOptimize(status);
+        }
+    }
+} // namespace
+
+BENCHMARK(updateNavMeshColdStart)->Unit(benchmark::kMillisecond);
+BENCHMARK(updateNavMeshColdStartWithDiskCache)->Unit(benchmark::kMillisecond);
+BENCHMARK(updateNavMeshWarmStart)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
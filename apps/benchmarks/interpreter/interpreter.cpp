@@ -0,0 +1,281 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/exception.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/nullerrorhandler.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Local scripts shaped like the ones in the vanilla game: a doOnce guard, a timer advanced every frame,
+    // a small state machine and checks of global variables. Only the core language is used, because the
+    // game's own instructions need a world to run in.
+
+    const std::string timerScript = R"(
+begin BenchTimer
+
+short doOnce
+short state
+float timer
+
+if ( doOnce == 0 )
+    set doOnce to 1
+    set timer to 0
+endif
+
+set timer to ( timer + 0.016 )
+
+if ( timer > 5 )
+    set timer to 0
+    if ( state < 3 )
+        set state to ( state + 1 )
+    else
+        set state to 0
+    endif
+endif
+
+end
+)";
+
+    const std::string globalsScript = R"(
+begin BenchGlobals
+
+short nightTime
+long visits
+
+if ( GameHour > 20 )
+    set nightTime to 1
+elseif ( GameHour < 6 )
+    set nightTime to 1
+else
+    set nightTime to 0
+endif
+
+if ( nightTime == 1 )
+    set visits to ( visits + 1 )
+    set Day to ( Day + 0 )
+endif
+
+set GameHour to ( GameHour + 0.001 )
+
+if ( GameHour >= 24 )
+    set GameHour to 0
+endif
+
+end
+)";
+
+    const std::string arithmeticScript = R"(
+begin BenchArithmetic
+
+float x
+float y
+float distance
+long counter
+short result
+
+set x to ( x + 1.5 )
+set y to ( y * 0.5 + 2 )
+set distance to ( x * x + y * y )
+set counter to ( counter + 1 )
+
+if ( distance > 10000 )
+    set x to 0
+    set y to 0
+endif
+
+if ( counter > 1000 )
+    set counter to 0
+endif
+
+set result to ( ( counter * 3 + 7 ) / 2 - counter )
+
+end
+)";
+
+    class CompilerContext : public Compiler::Context
+    {
+        public:
+
+            bool canDeclareLocals() const override
+            {
+                return true;
+            }
+
+            char getGlobalType (const std::string& name) const override
+            {
+                if (name=="gamehour")
+                    return 'f';
+                if (name=="day")
+                    return 's';
+                return ' ';
+            }
+
+            std::pair<char, bool> getMemberType (const std::string& name, const std::string& id) const override
+            {
+                return std::make_pair (' ', false);
+            }
+
+            bool isId (const std::string& name) const override
+            {
+                return false;
+            }
+
+            bool isJournalId (const std::string& name) const override
+            {
+                return false;
+            }
+    };
+
+    class InterpreterContext : public Interpreter::Context
+    {
+            std::vector<int> mShorts;
+            std::vector<int> mLongs;
+            std::vector<float> mFloats;
+            std::map<std::string, float> mGlobals;
+
+        public:
+
+            InterpreterContext (const Compiler::Locals& locals)
+                : mShorts (locals.get ('s').size())
+                , mLongs (locals.get ('l').size())
+                , mFloats (locals.get ('f').size())
+                , mGlobals {{"gamehour", 21.f}, {"day", 1.f}}
+            {}
+
+            unsigned short getContextType() const override { return SCRIPT_LOCAL; }
+            std::string getCurrentScriptName() const override { return std::string(); }
+            void trackContextType (unsigned short interpreterType) override {}
+            void trackCurrentScriptName (const std::string& name) override {}
+
+            int getLocalShort (int index) const override { return mShorts[index]; }
+            int getLocalLong (int index) const override { return mLongs[index]; }
+            float getLocalFloat (int index) const override { return mFloats[index]; }
+            void setLocalShort (int index, int value) override { mShorts[index] = value; }
+            void setLocalLong (int index, int value) override { mLongs[index] = value; }
+            void setLocalFloat (int index, float value) override { mFloats[index] = value; }
+
+            void messageBox (const std::string& message, const std::vector<std::string>& buttons) override {}
+            void report (const std::string& message) override {}
+
+            int getGlobalShort (const std::string& name) const override { return static_cast<int> (mGlobals.at (name)); }
+            int getGlobalLong (const std::string& name) const override { return static_cast<int> (mGlobals.at (name)); }
+            float getGlobalFloat (const std::string& name) const override { return mGlobals.at (name); }
+            void setGlobalShort (const std::string& name, int value) override { mGlobals[name] = static_cast<float> (value); }
+            void setGlobalLong (const std::string& name, int value) override { mGlobals[name] = static_cast<float> (value); }
+            void setGlobalFloat (const std::string& name, float value) override { mGlobals[name] = value; }
+            std::vector<std::string> getGlobals() const override { return {"day", "gamehour"}; }
+            char getGlobalType (const std::string& name) const override { return name=="gamehour" ? 'f' : 's'; }
+
+            std::string getActionBinding (const std::string& action) const override { return std::string(); }
+            std::string getActorName() const override { return std::string(); }
+            std::string getNPCRace() const override { return std::string(); }
+            std::string getNPCClass() const override { return std::string(); }
+            std::string getNPCFaction() const override { return std::string(); }
+            std::string getNPCRank() const override { return std::string(); }
+            std::string getPCName() const override { return std::string(); }
+            std::string getPCRace() const override { return std::string(); }
+            std::string getPCClass() const override { return std::string(); }
+            std::string getPCRank() const override { return std::string(); }
+            std::string getPCNextRank() const override { return std::string(); }
+            int getPCBounty() const override { return 0; }
+            std::string getCurrentCellName() const override { return std::string(); }
+
+            int getMemberShort (const std::string& id, const std::string& name, bool global) const override { return 0; }
+            int getMemberLong (const std::string& id, const std::string& name, bool global) const override { return 0; }
+            float getMemberFloat (const std::string& id, const std::string& name, bool global) const override { return 0; }
+            void setMemberShort (const std::string& id, const std::string& name, int value, bool global) override {}
+            void setMemberLong (const std::string& id, const std::string& name, int value, bool global) override {}
+            void setMemberFloat (const std::string& id, const std::string& name, float value, bool global) override {}
+    };
+
+    struct Script
+    {
+        std::vector<Interpreter::Type_Code> mCode;
+        Compiler::Locals mLocals;
+    };
+
+    Script compile (const std::string& source)
+    {
+        Compiler::NullErrorHandler errorHandler;
+        Compiler::Extensions extensions;
+        CompilerContext context;
+        context.setExtensions (&extensions);
+
+        Compiler::FileParser parser (errorHandler, context);
+        std::istringstream input (source);
+        Compiler::Scanner scanner (errorHandler, input, &extensions);
+        scanner.scan (parser);
+
+        if (!errorHandler.isGood())
+            throw std::runtime_error ("failed to compile benchmark script");
+
+        Script result;
+        parser.getCode (result.mCode);
+        result.mLocals = parser.getLocals();
+        return result;
+    }
+
+    // The counter is per opcode in the script's code block. Each run goes through most of it.
+    void setOpcodesProcessed (benchmark::State& state, const Script& script)
+    {
+        state.counters["opcode"] = benchmark::Counter (static_cast<double> (script.mCode[0]),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    template <const std::string& source>
+    void runByteCode (benchmark::State& state)
+    {
+        const Script script = compile (source);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes (interpreter);
+        InterpreterContext context (script.mLocals);
+
+        for (auto _ : state)
+            interpreter.run (script.mCode.data(), static_cast<int> (script.mCode.size()), context);
+
+        setOpcodesProcessed (state, script);
+    }
+
+    template <const std::string& source>
+    void runProgram (benchmark::State& state)
+    {
+        const Script script = compile (source);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes (interpreter);
+        const Interpreter::Program program = interpreter.decode (script.mCode.data(), static_cast<int> (script.mCode.size()));
+        InterpreterContext context (script.mLocals);
+
+        for (auto _ : state)
+            interpreter.run (program, context);
+
+        setOpcodesProcessed (state, script);
+    }
+
+    constexpr auto runByteCode_timer = runByteCode<timerScript>;
+    constexpr auto runByteCode_globals = runByteCode<globalsScript>;
+    constexpr auto runByteCode_arithmetic = runByteCode<arithmeticScript>;
+    constexpr auto runProgram_timer = runProgram<timerScript>;
+    constexpr auto runProgram_globals = runProgram<globalsScript>;
+    constexpr auto runProgram_arithmetic = runProgram<arithmeticScript>;
+} // namespace
+
+BENCHMARK(runByteCode_timer);
+BENCHMARK(runByteCode_globals);
+BENCHMARK(runByteCode_arithmetic);
+BENCHMARK(runProgram_timer);
+BENCHMARK(runProgram_globals);
+BENCHMARK(runProgram_arithmetic);
+
+BENCHMARK_MAIN();
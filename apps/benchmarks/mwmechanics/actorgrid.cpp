@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw/mwmechanics/actorgrid.hpp>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace MWMechanics;
+
+    typedef ActorGrid<int> Grid;
+
+    // Stands in for the RefData an actor's position is read from through its Ptr
+    struct Reference
+    {
+        osg::Vec3f mPosition;
+        char mOtherData[128];
+    };
+
+    // Actors::mActors, a map from Ptr to Actor
+    typedef std::map<int, std::unique_ptr<Reference>> ActorMap;
+
+    constexpr std::size_t actorCount = 500;
+    constexpr float cellSize = 8192.f;
+    constexpr float gridCellSize = 4096.f;
+
+    // Default "actors processing range", the range combat is engaged in
+    constexpr float processingRange = 7168.f;
+    // The range collisions are avoided in
+    constexpr float collisionRange = 200.f;
+
+    // Actors spread over the 6x6 exterior cells that several players next to each other keep loaded
+    std::vector<osg::Vec3f> makePositions()
+    {
+        std::vector<osg::Vec3f> positions;
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> horizontal(0, 6 * cellSize);
+        std::uniform_real_distribution<float> vertical(0, 1024);
+
+        for (std::size_t i = 0; i < actorCount; ++i)
+            positions.emplace_back(horizontal(random), horizontal(random), vertical(random));
+
+        return positions;
+    }
+
+    ActorMap makeActorMap(const std::vector<osg::Vec3f>& positions)
+    {
+        ActorMap actors;
+
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            actors.emplace(static_cast<int>(i), std::make_unique<Reference>(Reference {positions[i], {}}));
+
+        return actors;
+    }
+
+    Grid makeGrid(const std::vector<osg::Vec3f>& positions)
+    {
+        Grid grid(gridCellSize);
+
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            grid.update(static_cast<int>(i), positions[i]);
+
+        return grid;
+    }
+
+    // What Actors did before it had an index: go through all actors for every actor
+    void getInRangeScanned(const ActorMap& actors, const Grid&, const osg::Vec3f& position,
+        float radius, std::vector<int>& out)
+    {
+        for (const auto& actor : actors)
+        {
+            if ((actor.second->mPosition - position).length2() <= radius * radius)
+                out.push_back(actor.first);
+        }
+    }
+
+    void getInRangeIndexed(const ActorMap&, const Grid& grid, const osg::Vec3f& position,
+        float radius, std::vector<int>& out)
+    {
+        grid.getInRange(position, radius, out);
+    }
+
+    typedef void (*GetInRange)(const ActorMap&, const Grid&, const osg::Vec3f&, float, std::vector<int>&);
+
+    // One pass of an Actors::update() check that pairs every actor with the ones around it, e.g. engageCombat()
+    // with the processing range or predictAndAvoidCollisions() with the collision range
+    template <const float& radius, GetInRange getInRange>
+    void pairActors(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = makePositions();
+        const ActorMap actors = makeActorMap(positions);
+        const Grid grid = makeGrid(positions);
+        std::vector<int> neighbors;
+
+        for (auto _ : state)
+        {
+            std::size_t pairs = 0;
+
+            for (const osg::Vec3f& position : positions)
+            {
+                neighbors.clear();
+                getInRange(actors, grid, position, radius, neighbors);
+                pairs += neighbors.size();
+            }
+
+            benchmark::DoNotOptimize(pairs);
+        }
+
+        state.SetItemsProcessed(state.iterations() * positions.size());
+    }
+
+    // Every actor moving a frame's worth of walking, which is what keeping the index up to date costs
+    void updatePositions(benchmark::State& state)
+    {
+        std::vector<osg::Vec3f> positions = makePositions();
+        Grid grid = makeGrid(positions);
+        const osg::Vec3f step(2.5f, 1.5f, 0);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                positions[i] += step;
+                grid.update(static_cast<int>(i), positions[i]);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * positions.size());
+    }
+
+    constexpr auto pairActorsScanned_processingRange = pairActors<processingRange, getInRangeScanned>;
+    constexpr auto pairActorsIndexed_processingRange = pairActors<processingRange, getInRangeIndexed>;
+    constexpr auto pairActorsScanned_collisionRange = pairActors<collisionRange, getInRangeScanned>;
+    constexpr auto pairActorsIndexed_collisionRange = pairActors<collisionRange, getInRangeIndexed>;
+} // namespace
+
+BENCHMARK(pairActorsScanned_processingRange);
+BENCHMARK(pairActorsIndexed_processingRange);
+BENCHMARK(pairActorsScanned_collisionRange);
+BENCHMARK(pairActorsIndexed_collisionRange);
+BENCHMARK(updatePositions);
+
+BENCHMARK_MAIN();
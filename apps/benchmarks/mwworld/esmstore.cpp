@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw/mwworld/esmstore.hpp>
+#include <apps/openmw/mwmechanics/spelllist.hpp>
+
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace MWMechanics
+{
+    SpellList::SpellList(const std::string& id, int type) : mId(id), mType(type) {}
+}
+
+namespace
+{
+    // A master file with roughly the mix of records of Morrowind.esm, without cells and landscape.
+    // NPCs, creatures, books, spells and statics are parsed on worker threads, dialogue is loaded
+    // on the main thread in between.
+    constexpr int npcCount = 2500;
+    constexpr int creatureCount = 500;
+    constexpr int bookCount = 600;
+    constexpr int spellCount = 1000;
+    constexpr int staticCount = 3000;
+    constexpr int dialogueCount = 500;
+    constexpr int infosPerDialogue = 5;
+
+    std::string makeId(const char* prefix, int index)
+    {
+        return prefix + std::to_string(index);
+    }
+
+    std::string makeText(std::size_t size)
+    {
+        std::string text;
+        while (text.size() < size)
+            text += "The quick brown fox jumps over the lazy dog. ";
+        return text;
+    }
+
+    template <class T>
+    void save(ESM::ESMWriter& writer, const T& record)
+    {
+        writer.startRecord(T::sRecordId);
+        record.save(writer);
+        writer.endRecord(T::sRecordId);
+    }
+
+    std::string makeContentFile()
+    {
+        ESM::ESMWriter writer;
+        std::ostringstream stream;
+        writer.setFormat(0);
+        writer.save(stream);
+
+        for (int i = 0; i < staticCount; ++i)
+        {
+            ESM::Static record;
+            record.blank();
+            record.mId = makeId("Static", i);
+            record.mModel = "x\\ex_common_" + record.mId + ".nif";
+            save(writer, record);
+        }
+
+        for (int i = 0; i < spellCount; ++i)
+        {
+            ESM::Spell record;
+            record.blank();
+            record.mId = makeId("Spell", i);
+            record.mName = "Spell " + std::to_string(i);
+            record.mEffects.mList.resize(1 + i % 3, ESM::ENAMstruct {static_cast<short>(i % 100), -1, -1, 0, 0, 10, 5, 20});
+            save(writer, record);
+        }
+
+        for (int i = 0; i < npcCount; ++i)
+        {
+            ESM::NPC record;
+            record.blank();
+            record.mId = makeId("Npc", i);
+            record.mName = "Npc " + std::to_string(i);
+            record.mModel = "base_anim.nif";
+            record.mRace = "Dark Elf";
+            record.mClass = "Commoner";
+            record.mHead = "b_n_dark elf_m_head_01";
+            record.mHair = "b_n_dark elf_m_hair_01";
+            for (int j = 0; j < 5; ++j)
+                record.mInventory.mList.push_back(ESM::ContItem {1, makeId("Item", j)});
+            for (int j = 0; j < 3; ++j)
+                record.mSpells.mList.push_back(makeId("Spell", (i + j) % spellCount));
+            save(writer, record);
+        }
+
+        for (int i = 0; i < creatureCount; ++i)
+        {
+            ESM::Creature record;
+            record.blank();
+            record.mId = makeId("Creature", i);
+            record.mName = "Creature " + std::to_string(i);
+            record.mModel = "r\\creature.nif";
+            record.mInventory.mList.push_back(ESM::ContItem {1, "ingred_bread_01"});
+            save(writer, record);
+        }
+
+        for (int i = 0; i < bookCount; ++i)
+        {
+            ESM::Book record;
+            record.blank();
+            record.mId = makeId("Book", i);
+            record.mName = "Book " + std::to_string(i);
+            record.mModel = "m\\text_octavo_01.nif";
+            record.mText = makeText(2048);
+            save(writer, record);
+        }
+
+        const std::string response = makeText(200);
+
+        for (int i = 0; i < dialogueCount; ++i)
+        {
+            ESM::Dialogue dialogue;
+            dialogue.blank();
+            dialogue.mId = makeId("Topic", i);
+            save(writer, dialogue);
+
+            for (int j = 0; j < infosPerDialogue; ++j)
+            {
+                ESM::DialInfo info;
+                info.blank();
+                info.mId = makeId("Info", i * infosPerDialogue + j);
+                info.mResponse = response;
+                save(writer, info);
+            }
+        }
+
+        return stream.str();
+    }
+
+    const std::string& getContentFile()
+    {
+        static const std::string contentFile = makeContentFile();
+        return contentFile;
+    }
+
+    // Loading a content file the way the game does at startup, from memory so the disk doesn't count
+    template <std::size_t threads>
+    void loadContentFile(benchmark::State& state)
+    {
+        const std::string& contentFile = getContentFile();
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        Loading::Listener listener;
+
+        for (auto _ : state)
+        {
+            std::unique_ptr<MWWorld::ESMStore> store = std::make_unique<MWWorld::ESMStore>();
+            store->setLoadingThreads(threads);
+
+            std::vector<ESM::ESMReader> readers(1);
+            ESM::ESMReader& reader = readers.front();
+            reader.setEncoder(&encoder);
+            reader.setGlobalReaderList(&readers);
+            reader.open(std::make_shared<Files::IMemStream>(contentFile.data(), contentFile.size()), "Morrowind.esm");
+
+            store->load(reader, &listener);
+            benchmark::DoNotOptimize(store->get<ESM::NPC>().getSize());
+
+            state.PauseTiming();
+            store.reset();
+            readers.clear();
+            state.ResumeTiming();
+        }
+
+        state.SetBytesProcessed(state.iterations() * contentFile.size());
+    }
+
+    constexpr auto loadContentFile_0 = loadContentFile<0>;
+    constexpr auto loadContentFile_1 = loadContentFile<1>;
+    constexpr auto loadContentFile_2 = loadContentFile<2>;
+    constexpr auto loadContentFile_4 = loadContentFile<4>;
+} // namespace
+
+BENCHMARK(loadContentFile_0)->Unit(benchmark::kMillisecond);
+BENCHMARK(loadContentFile_1)->Unit(benchmark::kMillisecond);
+BENCHMARK(loadContentFile_2)->Unit(benchmark::kMillisecond);
+BENCHMARK(loadContentFile_4)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,173 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw/mwworld/refnumindex.hpp>
+
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace MWWorld;
+
+    // Stands in for a LiveCellRefBase, with the fields CellStore::searchExact() looks at
+    struct Reference
+    {
+        unsigned int mRefNum;
+        unsigned int mMpNum;
+        int mCount;
+    };
+
+    struct ObjectKey
+    {
+        unsigned int mRefNum;
+        unsigned int mMpNum;
+    };
+
+    // A loaded cell: references owned by type-specific lists, plus the merged list CellStore iterates over
+    struct Cell
+    {
+        std::list<Reference> mReferences;
+        std::vector<Reference*> mMergedRefs;
+    };
+
+    Cell makeCell(std::size_t referenceCount)
+    {
+        Cell cell;
+
+        for (std::size_t i = 0; i < referenceCount; ++i)
+        {
+            // Most references come from content files, while the rest were placed by players
+            if (i % 4 != 0)
+                cell.mReferences.push_back(Reference {static_cast<unsigned int>(i + 1), 0, 1});
+            else
+                cell.mReferences.push_back(Reference {0, static_cast<unsigned int>(i + 1), 1});
+        }
+
+        for (Reference& reference : cell.mReferences)
+            cell.mMergedRefs.push_back(&reference);
+
+        return cell;
+    }
+
+    std::vector<ObjectKey> makeObjectList(const Cell& cell, std::size_t objectCount)
+    {
+        std::vector<ObjectKey> objects;
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, cell.mMergedRefs.size() - 1);
+
+        for (std::size_t i = 0; i < objectCount; ++i)
+        {
+            const Reference* reference = cell.mMergedRefs[distribution(random)];
+            objects.push_back(ObjectKey {reference->mRefNum, reference->mMpNum});
+        }
+
+        return objects;
+    }
+
+    struct Numbers
+    {
+        static unsigned int getRefNum(const Reference& reference) { return reference.mRefNum; }
+        static unsigned int getMpNum(const Reference& reference) { return reference.mMpNum; }
+    };
+
+    typedef RefNumIndex<Reference, Numbers> Index;
+
+    bool matches(const Reference* reference, const ObjectKey& object)
+    {
+        return reference->mRefNum == object.mRefNum && reference->mMpNum == object.mMpNum;
+    }
+
+    // What CellStore::searchExact() did for every object before it had an index
+    Reference* searchScanned(Cell& cell, const Index&, const ObjectKey& object)
+    {
+        for (Reference* reference : cell.mMergedRefs)
+        {
+            if (reference->mCount > 0 && matches(reference, object))
+                return reference;
+        }
+
+        return nullptr;
+    }
+
+    Reference* searchIndexed(Cell& cell, const Index& index, const ObjectKey& object)
+    {
+        Reference* found;
+
+        if (index.search(object.mRefNum, object.mMpNum, found) == Index::Search_Ambiguous)
+            return searchScanned(cell, index, object);
+
+        return found != nullptr && found->mCount > 0 ? found : nullptr;
+    }
+
+    // Packets that only change existing objects, such as ID_OBJECT_STATE or ID_CONTAINER
+    template <std::size_t referenceCount, std::size_t objectCount, Reference* (*search)(Cell&, const Index&, const ObjectKey&)>
+    void applyObjectList(benchmark::State& state)
+    {
+        Cell cell = makeCell(referenceCount);
+        const std::vector<ObjectKey> objects = makeObjectList(cell, objectCount);
+        Index index;
+
+        while (state.KeepRunning())
+        {
+            // Assume something in the cell has changed since the last packet, which is the worst case
+            // for the index since it then has to be rebuilt
+            index.invalidate();
+
+            if (search == searchIndexed)
+                index.rebuild(cell.mMergedRefs);
+
+            for (const ObjectKey& object : objects)
+                benchmark::DoNotOptimize(search(cell, index, object));
+        }
+    }
+
+    // Packets that check every object is missing before placing it and then setting its mpNum, such as
+    // ID_OBJECT_PLACE
+    template <std::size_t referenceCount, std::size_t objectCount, Reference* (*search)(Cell&, const Index&, const ObjectKey&)>
+    void placeObjectList(benchmark::State& state)
+    {
+        Cell cell = makeCell(referenceCount);
+        Index index;
+        std::vector<Reference> placed;
+        placed.reserve(objectCount);
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            cell.mMergedRefs.resize(referenceCount);
+            placed.clear();
+            index.rebuild(cell.mMergedRefs);
+            state.ResumeTiming();
+
+            for (std::size_t i = 0; i < objectCount; ++i)
+            {
+                const ObjectKey object {0, static_cast<unsigned int>(referenceCount + i + 1)};
+
+                if (search(cell, index, object) != nullptr)
+                    continue;
+
+                placed.push_back(Reference {0, 0, 1});
+                cell.mMergedRefs.push_back(&placed.back());
+                index.add(&placed.back());
+                placed.back().mMpNum = object.mMpNum;
+            }
+        }
+    }
+
+    constexpr auto applyObjectListScanned_3k_200 = applyObjectList<3000, 200, searchScanned>;
+    constexpr auto applyObjectListIndexed_3k_200 = applyObjectList<3000, 200, searchIndexed>;
+    constexpr auto applyObjectListScanned_300_20 = applyObjectList<300, 20, searchScanned>;
+    constexpr auto applyObjectListIndexed_300_20 = applyObjectList<300, 20, searchIndexed>;
+    constexpr auto placeObjectListScanned_3k_200 = placeObjectList<3000, 200, searchScanned>;
+    constexpr auto placeObjectListIndexed_3k_200 = placeObjectList<3000, 200, searchIndexed>;
+} // namespace
+
+BENCHMARK(applyObjectListScanned_3k_200);
+BENCHMARK(applyObjectListIndexed_3k_200);
+BENCHMARK(applyObjectListScanned_300_20);
+BENCHMARK(applyObjectListIndexed_300_20);
+BENCHMARK(placeObjectListScanned_3k_200);
+BENCHMARK(placeObjectListIndexed_3k_200);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,245 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/Packets/Actor/PacketActorAnimFlags.hpp>
+#include <components/openmw-mp/Packets/Actor/PacketActorPosition.hpp>
+#include <components/openmw-mp/Packets/Actor/PacketActorSpeech.hpp>
+#include <components/openmw-mp/Packets/Actor/PacketActorStatsDynamic.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace
+{
+    std::size_t allocationCount = 0;
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocationCount;
+
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    using namespace mwmp;
+
+    ESM::Cell makeCell()
+    {
+        ESM::Cell cell;
+        cell.blank();
+        cell.mName = "Balmora, Hlaalu Council Manor";
+        return cell;
+    }
+
+    // Stands in for the LocalActors of a cell, which ActorList is handed one at a time
+    std::vector<BaseActor> makeLocalActors(std::size_t actorCount)
+    {
+        std::vector<BaseActor> actors(actorCount);
+
+        for (std::size_t i = 0; i < actorCount; ++i)
+        {
+            BaseActor &actor = actors[i];
+            actor.refId = "ex_vivec_arena_combatant";
+            actor.refNum = static_cast<unsigned int>(i + 1);
+            actor.mpNum = 0;
+            actor.cell = makeCell();
+
+            for (Item &item : actor.equipmentItems)
+                item.refId = "expensive_shirt_01";
+        }
+
+        return actors;
+    }
+
+    // Every actor moves, while only some of them change their animation flags or stats or speak
+    template <class Batches>
+    void addActors(Batches &batches, std::vector<BaseActor> &localActors, int tick)
+    {
+        for (std::size_t i = 0; i < localActors.size(); ++i)
+        {
+            BaseActor &actor = localActors[i];
+            actor.position.pos[0] = static_cast<float>(tick);
+            batches.addPosition(actor);
+
+            if ((i + tick) % 3 == 0)
+                batches.addAnimFlags(actor);
+
+            if ((i + tick) % 5 == 0)
+                batches.addStatsDynamic(actor);
+
+            if ((i + tick) % 10 == 0)
+            {
+                actor.sound = "Vo\\d\\m\\Atk_DM001.mp3";
+                batches.addSpeech(actor);
+                actor.sound.clear();
+            }
+        }
+    }
+
+    struct Packets
+    {
+        Packets() : position(nullptr), animFlags(nullptr), statsDynamic(nullptr), speech(nullptr) {}
+
+        PacketActorPosition position;
+        PacketActorAnimFlags animFlags;
+        PacketActorStatsDynamic statsDynamic;
+        PacketActorSpeech speech;
+        RakNet::BitStream bitStream;
+
+        void send(ActorPacket &packet, BaseActorList &actorList)
+        {
+            bitStream.Reset();
+            packet.setActorList(&actorList);
+            packet.Packet(&bitStream, true);
+        }
+    };
+
+    // What ActorList did before it batched actors: a vector of copies for each packet, which was
+    // copied into baseActors to be sent and then copied again by ActorPacket for every actor
+    struct CopiedBatches
+    {
+        BaseActorList actorList;
+        std::vector<BaseActor> positionActors;
+        std::vector<BaseActor> animFlagsActors;
+        std::vector<BaseActor> statsDynamicActors;
+        std::vector<BaseActor> speechActors;
+
+        void reset()
+        {
+            actorList.baseActors.clear();
+            positionActors.clear();
+            animFlagsActors.clear();
+            statsDynamicActors.clear();
+            speechActors.clear();
+        }
+
+        void addPosition(BaseActor actor) { positionActors.push_back(actor); }
+        void addAnimFlags(BaseActor actor) { animFlagsActors.push_back(actor); }
+        void addStatsDynamic(BaseActor actor) { statsDynamicActors.push_back(actor); }
+        void addSpeech(BaseActor actor) { speechActors.push_back(actor); }
+
+        void send(Packets &packets, ActorPacket &packet, const std::vector<BaseActor> &actors)
+        {
+            if (actors.empty())
+                return;
+
+            actorList.baseActors = actors;
+
+            BaseActor actor;
+
+            for (const BaseActor &baseActor : actorList.baseActors)
+            {
+                actor = baseActor;
+                benchmark::DoNotOptimize(actor);
+            }
+
+            packets.send(packet, actorList);
+        }
+
+        void sendAll(Packets &packets)
+        {
+            send(packets, packets.position, positionActors);
+            send(packets, packets.animFlags, animFlagsActors);
+            send(packets, packets.statsDynamic, statsDynamicActors);
+            send(packets, packets.speech, speechActors);
+        }
+    };
+
+    // What ActorList does now: copies in a pool that's reused from one update to the next, with
+    // each packet sent straight from the indexes of its batch
+    struct PooledBatches
+    {
+        BaseActorList actorList;
+        std::vector<unsigned int> positionActors;
+        std::vector<unsigned int> animFlagsActors;
+        std::vector<unsigned int> statsDynamicActors;
+        std::vector<unsigned int> speechActors;
+
+        void reset()
+        {
+            actorList.baseActors.clear();
+            actorList.clearBatches();
+            positionActors.clear();
+            animFlagsActors.clear();
+            statsDynamicActors.clear();
+            speechActors.clear();
+        }
+
+        void addPosition(const BaseActor &actor) { actorList.addToBatch(positionActors, actor); }
+        void addAnimFlags(const BaseActor &actor) { actorList.addToBatch(animFlagsActors, actor); }
+        void addStatsDynamic(const BaseActor &actor) { actorList.addToBatch(statsDynamicActors, actor); }
+        void addSpeech(const BaseActor &actor) { actorList.addToBatch(speechActors, actor); }
+
+        void send(Packets &packets, ActorPacket &packet, const std::vector<unsigned int> &batch)
+        {
+            if (batch.empty())
+                return;
+
+            actorList.setSentBatch(&batch);
+            packets.send(packet, actorList);
+            actorList.setSentBatch(nullptr);
+        }
+
+        void sendAll(Packets &packets)
+        {
+            send(packets, packets.position, positionActors);
+            send(packets, packets.animFlags, animFlagsActors);
+            send(packets, packets.statsDynamic, statsDynamicActors);
+            send(packets, packets.speech, speechActors);
+        }
+    };
+
+    // One 25 ms Cell::updateLocal() tick of a cell whose actors are all under our authority
+    template <class Batches, std::size_t actorCount>
+    void updateLocal(benchmark::State& state)
+    {
+        std::vector<BaseActor> localActors = makeLocalActors(actorCount);
+        Packets packets;
+        Batches batches;
+        int tick = 0;
+        std::size_t allocations = 0;
+
+        while (state.KeepRunning())
+        {
+            const std::size_t allocationsBefore = allocationCount;
+
+            batches.reset();
+            batches.actorList.cell = localActors.front().cell;
+            addActors(batches, localActors, tick++);
+            batches.sendAll(packets);
+
+            allocations += allocationCount - allocationsBefore;
+        }
+
+        state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocations),
+            benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations() * actorCount);
+    }
+
+    constexpr auto updateLocalCopied_20 = updateLocal<CopiedBatches, 20>;
+    constexpr auto updateLocalPooled_20 = updateLocal<PooledBatches, 20>;
+    constexpr auto updateLocalCopied_100 = updateLocal<CopiedBatches, 100>;
+    constexpr auto updateLocalPooled_100 = updateLocal<PooledBatches, 100>;
+} // namespace
+
+BENCHMARK(updateLocalCopied_20);
+BENCHMARK(updateLocalPooled_20);
+BENCHMARK(updateLocalCopied_100);
+BENCHMARK(updateLocalPooled_100);
+
+BENCHMARK_MAIN();
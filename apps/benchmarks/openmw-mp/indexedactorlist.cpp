@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/IndexedActorList.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    mwmp::BaseActor makeActor(unsigned int refNum, unsigned int mpNum)
+    {
+        mwmp::BaseActor actor;
+        actor.refId = "ex_vivec_arena_combatant";
+        actor.refNum = refNum;
+        actor.mpNum = mpNum;
+        actor.position.pos[0] = static_cast<float>(refNum);
+        return actor;
+    }
+
+    template <typename Random>
+    std::vector<mwmp::BaseActor> makeUpdate(const std::vector<mwmp::BaseActor> &actors, Random &random)
+    {
+        std::vector<mwmp::BaseActor> update(actors);
+        std::shuffle(update.begin(), update.end(), random);
+        return update;
+    }
+
+    // What the server did for every actor of an ID_ACTOR_POSITION packet before cell actors
+    // were indexed: scan for the actor while copying each entry, then scan again to get it
+    bool containsScanned(const std::vector<mwmp::BaseActor> &actors, unsigned int refNum, unsigned int mpNum)
+    {
+        for (unsigned int i = 0; i < actors.size(); i++)
+        {
+            mwmp::BaseActor actor = actors.at(i);
+
+            if (actor.refNum == refNum && actor.mpNum == mpNum)
+                return true;
+        }
+        return false;
+    }
+
+    mwmp::BaseActor *getScanned(std::vector<mwmp::BaseActor> &actors, unsigned int refNum, unsigned int mpNum)
+    {
+        for (auto &actor : actors)
+        {
+            if (actor.refNum == refNum && actor.mpNum == mpNum)
+                return &actor;
+        }
+        return nullptr;
+    }
+
+    template <std::size_t actorCount>
+    void updateScannedCell(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<mwmp::BaseActor> cellActors;
+
+        for (unsigned int i = 0; i < actorCount; i++)
+            cellActors.push_back(makeActor(i, 0));
+
+        const std::vector<mwmp::BaseActor> update = makeUpdate(cellActors, random);
+
+        while (state.KeepRunning())
+        {
+            for (const auto &newActor : update)
+            {
+                if (containsScanned(cellActors, newActor.refNum, newActor.mpNum))
+                    getScanned(cellActors, newActor.refNum, newActor.mpNum)->position = newActor.position;
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * actorCount);
+    }
+
+    template <std::size_t actorCount>
+    void updateIndexedCell(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        IndexedActorList cellActors;
+        std::vector<mwmp::BaseActor> actors;
+
+        for (unsigned int i = 0; i < actorCount; i++)
+        {
+            actors.push_back(makeActor(i, 0));
+            cellActors.add(actors.back());
+        }
+
+        const std::vector<mwmp::BaseActor> update = makeUpdate(actors, random);
+
+        while (state.KeepRunning())
+        {
+            for (const auto &newActor : update)
+            {
+                mwmp::BaseActor *cellActor = cellActors.get(newActor.refNum, newActor.mpNum);
+
+                if (cellActor != nullptr)
+                    cellActor->position = newActor.position;
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * actorCount);
+    }
+
+    // Actors leaving and entering a crowded cell one at a time
+    template <std::size_t actorCount>
+    void replaceIndexedActor(benchmark::State& state)
+    {
+        IndexedActorList cellActors;
+
+        for (unsigned int i = 0; i < actorCount; i++)
+            cellActors.add(makeActor(i, 0));
+
+        const mwmp::BaseActor spawnedActor = makeActor(0, 0);
+        unsigned int n = 0;
+
+        while (state.KeepRunning())
+        {
+            cellActors.remove(n % actorCount, n / actorCount);
+            mwmp::BaseActor actor = spawnedActor;
+            actor.refNum = n % actorCount;
+            actor.mpNum = n / actorCount + 1;
+            benchmark::DoNotOptimize(cellActors.add(actor));
+            n++;
+        }
+    }
+
+    constexpr auto updateScannedCell_100 = updateScannedCell<100>;
+    constexpr auto updateScannedCell_300 = updateScannedCell<300>;
+    constexpr auto updateScannedCell_1000 = updateScannedCell<1000>;
+    constexpr auto updateIndexedCell_100 = updateIndexedCell<100>;
+    constexpr auto updateIndexedCell_300 = updateIndexedCell<300>;
+    constexpr auto updateIndexedCell_1000 = updateIndexedCell<1000>;
+    constexpr auto replaceIndexedActor_300 = replaceIndexedActor<300>;
+} // namespace
+
+BENCHMARK(updateScannedCell_100);
+BENCHMARK(updateScannedCell_300);
+BENCHMARK(updateScannedCell_1000);
+BENCHMARK(updateIndexedCell_100);
+BENCHMARK(updateIndexedCell_300);
+BENCHMARK(updateIndexedCell_1000);
+BENCHMARK(replaceIndexedActor_300);
+
+BENCHMARK_MAIN();
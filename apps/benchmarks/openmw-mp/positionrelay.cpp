@@ -0,0 +1,189 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/InterestBands.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace mwmp;
+
+    // Header, GUID and the compressed position and direction of an ID_PLAYER_POSITION packet
+    constexpr std::size_t positionPacketSize = 57;
+    constexpr float cellSize = 8192.0f;
+
+    struct Sample
+    {
+        unsigned int msec;
+        unsigned int playerId;
+        float pos[3];
+    };
+
+    struct Trace
+    {
+        unsigned int playerCount = 0;
+        unsigned int durationMsec = 0;
+        std::vector<Sample> samples;
+    };
+
+    // Read a recorded trace with one "msec,playerId,x,y,z" line per position update received
+    // by the server, sorted by time
+    bool loadTrace(const std::string& path, Trace& trace)
+    {
+        std::ifstream file(path);
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream stream(line);
+            Sample sample;
+
+            if (!(stream >> sample.msec >> sample.playerId >> sample.pos[0] >> sample.pos[1] >> sample.pos[2]))
+                continue;
+
+            trace.playerCount = std::max(trace.playerCount, sample.playerId + 1);
+            trace.durationMsec = std::max(trace.durationMsec, sample.msec);
+            trace.samples.push_back(sample);
+        }
+
+        return !trace.samples.empty();
+    }
+
+    // Players wandering around a few exterior cells, sending an update every 15 ms as
+    // LocalPlayer does while moving
+    Trace generateTrace(unsigned int playerCount, unsigned int durationMsec)
+    {
+        Trace trace;
+        trace.playerCount = playerCount;
+        trace.durationMsec = durationMsec;
+
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> start(-3 * cellSize, 3 * cellSize);
+        std::uniform_real_distribution<float> turn(-0.3f, 0.3f);
+        std::uniform_real_distribution<float> heading(0.0f, 6.2831853f);
+
+        std::vector<Sample> players(playerCount);
+        std::vector<float> headings(playerCount);
+
+        for (unsigned int i = 0; i < playerCount; i++)
+        {
+            players[i] = Sample {0, i, {start(random), start(random), 0.0f}};
+            headings[i] = heading(random);
+        }
+
+        for (unsigned int msec = 0; msec < durationMsec; msec += 15)
+        {
+            for (unsigned int i = 0; i < playerCount; i++)
+            {
+                // Running speed of roughly 300 units per second
+                headings[i] += turn(random);
+                players[i].pos[0] += std::cos(headings[i]) * 4.5f;
+                players[i].pos[1] += std::sin(headings[i]) * 4.5f;
+                players[i].msec = msec;
+                trace.samples.push_back(players[i]);
+            }
+        }
+
+        return trace;
+    }
+
+    const Trace& getTrace()
+    {
+        static const Trace trace = []
+        {
+            Trace loaded;
+            const char* path = std::getenv("TES3MP_POSITION_TRACE");
+
+            if (path != nullptr && loadTrace(path, loaded))
+                return loaded;
+
+            return generateTrace(64, 30000);
+        }();
+
+        return trace;
+    }
+
+    bool sharesLoadedCells(const Sample& left, const Sample& right)
+    {
+        // Exterior players keep a 3x3 grid loaded, so their grids overlap up to two cells apart
+        const int dx = static_cast<int>(std::floor(left.pos[0] / cellSize)) - static_cast<int>(std::floor(right.pos[0] / cellSize));
+        const int dy = static_cast<int>(std::floor(left.pos[1] / cellSize)) - static_cast<int>(std::floor(right.pos[1] / cellSize));
+        return std::abs(dx) <= 2 && std::abs(dy) <= 2;
+    }
+
+    void replay(benchmark::State& state, const InterestBands& bands)
+    {
+        const Trace& trace = getTrace();
+        std::size_t bytesSent = 0;
+
+        while (state.KeepRunning())
+        {
+            std::vector<Sample> latest(trace.playerCount, Sample {0, 0, {0, 0, 0}});
+            std::vector<unsigned int> updateCounts(trace.playerCount, 0);
+            bytesSent = 0;
+
+            for (const Sample& sample : trace.samples)
+            {
+                latest[sample.playerId] = sample;
+                const unsigned int updateCount = ++updateCounts[sample.playerId];
+
+                for (unsigned int recipientId = 0; recipientId < trace.playerCount; recipientId++)
+                {
+                    if (recipientId == sample.playerId || !sharesLoadedCells(sample, latest[recipientId]))
+                        continue;
+
+                    float distanceSquared = 0;
+                    for (int i = 0; i < 3; i++)
+                        distanceSquared += (sample.pos[i] - latest[recipientId].pos[i]) * (sample.pos[i] - latest[recipientId].pos[i]);
+
+                    if (bands.shouldRelay(distanceSquared, updateCount, recipientId, false))
+                        bytesSent += positionPacketSize;
+                }
+            }
+
+            benchmark::DoNotOptimize(bytesSent);
+        }
+
+        const double seconds = std::max(1u, trace.durationMsec) / 1000.0;
+        state.counters["bytesPerSecondPerClient"] = bytesSent / seconds / trace.playerCount;
+        state.counters["clients"] = trace.playerCount;
+    }
+
+    void relayUnfiltered(benchmark::State& state)
+    {
+        replay(state, InterestBands());
+    }
+
+    void relayBanded(benchmark::State& state)
+    {
+        InterestBands bands;
+        bands.addBand(2048, 1);
+        bands.addBand(8192, 3);
+        bands.addBand(16384, 6);
+        replay(state, bands);
+    }
+
+    void relayBandedAggressive(benchmark::State& state)
+    {
+        InterestBands bands;
+        bands.addBand(1024, 1);
+        bands.addBand(4096, 4);
+        bands.addBand(8192, 8);
+        bands.addBand(16384, 16);
+        replay(state, bands);
+    }
+} // namespace
+
+BENCHMARK(relayUnfiltered)->Unit(benchmark::kMillisecond);
+BENCHMARK(relayBanded)->Unit(benchmark::kMillisecond);
+BENCHMARK(relayBandedAggressive)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
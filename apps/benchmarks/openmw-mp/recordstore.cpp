@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/RecordStore.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+    using namespace mwmp;
+
+    // Stands in for a cell's JSON file, with one entry per object that has changed in it
+    std::string makeCellData(std::size_t objectCount)
+    {
+        std::string data = "{\"entry\":{\"creationTime\":1650000000},\"objectData\":{";
+
+        for (std::size_t i = 0; i < objectCount; ++i)
+        {
+            data += "\"0-" + std::to_string(i) + "\":{\"refId\":\"misc_com_bottle_01\",\"location\":{\"posX\":" +
+                std::to_string(i * 16) + ",\"posY\":-1024.5,\"posZ\":512.25,\"rotX\":0,\"rotY\":0,\"rotZ\":1.57}},";
+        }
+
+        data += "}}";
+        return data;
+    }
+
+    std::string getPath(const char *name)
+    {
+        return (boost::filesystem::temp_directory_path() / name).string();
+    }
+
+    // What saving a cell took before: its whole file rewritten by the thread running scripts
+    template <std::size_t objectCount>
+    void saveCellRewritten(benchmark::State& state)
+    {
+        const std::string path = getPath("openmw_mp_recordstore_benchmark.json");
+        const std::string data = makeCellData(objectCount);
+
+        while (state.KeepRunning())
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            stream.close();
+        }
+
+        boost::filesystem::remove(path);
+    }
+
+    // The same save through a RecordStore, which leaves the writing to its worker thread
+    template <std::size_t objectCount>
+    void saveCellStored(benchmark::State& state)
+    {
+        const std::string path = getPath("openmw_mp_recordstore_benchmark.store");
+        boost::filesystem::remove(path);
+
+        const std::string data = makeCellData(objectCount);
+
+        RecordStore recordStore;
+        recordStore.open(path);
+
+        while (state.KeepRunning())
+            recordStore.set("Balmora, Guild of Mages", data);
+
+        recordStore.close();
+        boost::filesystem::remove(path);
+    }
+
+    constexpr auto saveCellRewritten_100 = saveCellRewritten<100>;
+    constexpr auto saveCellStored_100 = saveCellStored<100>;
+    constexpr auto saveCellRewritten_2000 = saveCellRewritten<2000>;
+    constexpr auto saveCellStored_2000 = saveCellStored<2000>;
+} // namespace
+
+BENCHMARK(saveCellRewritten_100);
+BENCHMARK(saveCellStored_100);
+BENCHMARK(saveCellRewritten_2000);
+BENCHMARK(saveCellStored_2000);
+
+BENCHMARK_MAIN();
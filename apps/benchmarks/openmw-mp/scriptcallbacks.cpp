@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/Script/Types.hpp>
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined (ENABLE_LUA)
+#include <lua.hpp>
+#endif
+
+namespace
+{
+    constexpr std::size_t callbackCount = 64;
+    constexpr unsigned int calledSlot = 37;
+
+    int calls = 0;
+
+    void nativeCallback()
+    {
+        benchmark::DoNotOptimize(++calls);
+    }
+
+    FunctionEllipsis<void> resolve(unsigned int index)
+    {
+        // Scripts usually only define a few of the available callbacks
+        return index % 4 == 1 ? reinterpret_cast<FunctionEllipsis<void>>(&nativeCallback) : nullptr;
+    }
+
+    // The dispatch done by Script::Call before callbacks were kept in slots: every call probes
+    // each script's map twice, keyed by the hash of the callback's name
+    struct ProbedScript
+    {
+        std::unordered_map<unsigned int, FunctionEllipsis<void>> callbacks;
+    };
+
+    template <std::size_t scriptCount>
+    void dispatchProbed(benchmark::State& state)
+    {
+        const unsigned int key = Utils::hash("OnPlayerCellChange");
+        std::vector<ProbedScript> scripts(scriptCount);
+
+        for (auto& script : scripts)
+        {
+            for (unsigned int i = 0; i < callbackCount; i++)
+            {
+                const std::string name = "OnCallback" + std::to_string(i);
+                script.callbacks.emplace(i == calledSlot ? key : Utils::hash(name.c_str(), name.size()), resolve(i));
+            }
+        }
+
+        while (state.KeepRunning())
+        {
+            for (auto& script : scripts)
+            {
+                if (!script.callbacks.count(key))
+                    script.callbacks.emplace(key, resolve(calledSlot));
+
+                auto callback = script.callbacks[key];
+
+                if (!callback)
+                    continue;
+
+                reinterpret_cast<void (*)()>(callback)();
+            }
+        }
+    }
+
+    template <std::size_t scriptCount>
+    void dispatchSlotted(benchmark::State& state)
+    {
+        std::vector<std::array<ScriptCallbackSlot, callbackCount>> scripts(scriptCount);
+
+        while (state.KeepRunning())
+        {
+            for (auto& slots : scripts)
+            {
+                ScriptCallbackSlot &slot = slots[calledSlot];
+
+                if (!slot.isResolved)
+                {
+                    slot.function = resolve(calledSlot);
+                    slot.isResolved = true;
+                }
+
+                if (!slot.function)
+                    continue;
+
+                reinterpret_cast<void (*)()>(slot.function)();
+            }
+        }
+    }
+
+#if defined (ENABLE_LUA)
+    lua_State* createLuaState()
+    {
+        lua_State* lua = luaL_newstate();
+        luaL_openlibs(lua);
+        luaL_dostring(lua, "count = 0 function OnPlayerCellChange(pid) count = count + pid end");
+        return lua;
+    }
+
+    // Looking the callback up in the globals table by name, as LangLua::Call does
+    void dispatchLuaByName(benchmark::State& state)
+    {
+        lua_State* lua = createLuaState();
+
+        while (state.KeepRunning())
+        {
+            lua_getglobal(lua, "OnPlayerCellChange");
+
+            if (!lua_isfunction(lua, -1))
+            {
+                lua_pop(lua, 1);
+                continue;
+            }
+
+            lua_pushinteger(lua, 1);
+            lua_pcall(lua, 1, 0, 0);
+        }
+
+        lua_close(lua);
+    }
+
+    // Calling a registry reference resolved once, as LangLua::CallCallback does
+    void dispatchLuaByHandle(benchmark::State& state)
+    {
+        lua_State* lua = createLuaState();
+        lua_getglobal(lua, "OnPlayerCellChange");
+        const int handle = luaL_ref(lua, LUA_REGISTRYINDEX);
+
+        while (state.KeepRunning())
+        {
+            lua_rawgeti(lua, LUA_REGISTRYINDEX, handle);
+            lua_pushinteger(lua, 1);
+            lua_pcall(lua, 1, 0, 0);
+        }
+
+        luaL_unref(lua, LUA_REGISTRYINDEX, handle);
+        lua_close(lua);
+    }
+#endif
+
+    constexpr auto dispatchProbed_1 = dispatchProbed<1>;
+    constexpr auto dispatchProbed_8 = dispatchProbed<8>;
+    constexpr auto dispatchSlotted_1 = dispatchSlotted<1>;
+    constexpr auto dispatchSlotted_8 = dispatchSlotted<8>;
+} // namespace
+
+BENCHMARK(dispatchProbed_1);
+BENCHMARK(dispatchProbed_8);
+BENCHMARK(dispatchSlotted_1);
+BENCHMARK(dispatchSlotted_8);
+
+#if defined (ENABLE_LUA)
+BENCHMARK(dispatchLuaByName);
+BENCHMARK(dispatchLuaByHandle);
+#endif
+
+BENCHMARK_MAIN();
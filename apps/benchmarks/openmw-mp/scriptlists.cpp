@@ -0,0 +1,300 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/Networking.hpp>
+#include <apps/openmw-mp/Player.hpp>
+#include <apps/openmw-mp/Script/Functions/Objects.hpp>
+#include <apps/openmw-mp/Script/LangLua/LuaLists.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+extern mwmp::BaseObjectList *readObjectList;
+extern mwmp::BaseObjectList writeObjectList;
+
+// Only the object functions are linked in, so the parts of the server they reach for are left
+// out. Nothing benchmarked sends packets or looks up players
+namespace mwmp
+{
+    const Networking &Networking::get()
+    {
+        std::abort();
+    }
+
+    Networking *Networking::getPtr()
+    {
+        std::abort();
+    }
+
+    ObjectPacketController *Networking::getObjectPacketController() const
+    {
+        std::abort();
+    }
+
+    BaseObjectList *Networking::getReceivedObjectList()
+    {
+        std::abort();
+    }
+}
+
+Player *Players::getPlayer(RakNet::RakNetGUID)
+{
+    return nullptr;
+}
+
+Player *Players::getPlayer(unsigned short)
+{
+    return nullptr;
+}
+
+unsigned short Player::getId()
+{
+    std::abort();
+}
+
+namespace
+{
+    // Each object's fields are read by its own call, the way scripts read object lists through
+    // GetObjectRefId, GetObjectCount and so on
+    const char *const perFieldScript = R"(
+        function readObjects()
+            local total = 0
+            for index = 0, tes3mp.GetObjectListSize() - 1 do
+                local refId = tes3mp.GetObjectRefId(index)
+                total = total + tes3mp.GetObjectRefNum(index) + tes3mp.GetObjectMpNum(index) +
+                    tes3mp.GetObjectCount(index) + tes3mp.GetObjectCharge(index) +
+                    tes3mp.GetObjectPosX(index) + tes3mp.GetObjectPosY(index) + tes3mp.GetObjectPosZ(index) +
+                    tes3mp.GetObjectRotX(index) + tes3mp.GetObjectRotY(index) + tes3mp.GetObjectRotZ(index) + #refId
+            end
+            return total
+        end
+
+        function addObjects(count)
+            for index = 1, count do
+                tes3mp.SetObjectRefId("misc_com_bottle_01")
+                tes3mp.SetObjectRefNum(index)
+                tes3mp.SetObjectMpNum(0)
+                tes3mp.SetObjectCount(1)
+                tes3mp.SetObjectCharge(-1)
+                tes3mp.SetObjectPosition(index, index * 2, 64)
+                tes3mp.SetObjectRotation(0, 0, 1.5)
+                tes3mp.AddObject()
+            end
+        end
+    )";
+
+    const char *const tableScript = R"(
+        function readObjects()
+            local total = 0
+            for _, object in ipairs(tes3mp.GetObjectListTable()) do
+                total = total + object.refNum + object.mpNum + object.count + object.charge +
+                    object.posX + object.posY + object.posZ + object.rotX + object.rotY + object.rotZ + #object.refId
+            end
+            return total
+        end
+
+        function addObjects(count)
+            local objects = {}
+            for index = 1, count do
+                objects[index] = { refId = "misc_com_bottle_01", refNum = index, mpNum = 0, count = 1, charge = -1,
+                    posX = index, posY = index * 2, posZ = 64, rotX = 0, rotY = 0, rotZ = 1.5 }
+            end
+            tes3mp.AddObjects(objects)
+        end
+    )";
+
+    mwmp::BaseObjectList receivedObjectList;
+
+    // Adapters doing the argument conversions of the generated wrappers around the server's own
+    // ObjectFunctions, which work on the same object lists as the scripts do
+    int getObjectListSize(lua_State *lua)
+    {
+        lua_pushinteger(lua, ObjectFunctions::GetObjectListSize());
+        return 1;
+    }
+
+    unsigned int getIndex(lua_State *lua)
+    {
+        return static_cast<unsigned int>(lua_tointeger(lua, 1));
+    }
+
+    int getObjectRefId(lua_State *lua)
+    {
+        lua_pushstring(lua, ObjectFunctions::GetObjectRefId(getIndex(lua)));
+        return 1;
+    }
+
+    template <typename T, T (*function)(unsigned int) noexcept>
+    int getObjectField(lua_State *lua)
+    {
+        lua_pushnumber(lua, function(getIndex(lua)));
+        return 1;
+    }
+
+    int setObjectRefId(lua_State *lua)
+    {
+        ObjectFunctions::SetObjectRefId(lua_tostring(lua, 1));
+        return 0;
+    }
+
+    template <void (*function)(int) noexcept>
+    int setObjectField(lua_State *lua)
+    {
+        function(static_cast<int>(lua_tointeger(lua, 1)));
+        return 0;
+    }
+
+    template <void (*function)(double, double, double) noexcept>
+    int setObjectVector(lua_State *lua)
+    {
+        function(lua_tonumber(lua, 1), lua_tonumber(lua, 2), lua_tonumber(lua, 3));
+        return 0;
+    }
+
+    int addObject(lua_State *)
+    {
+        ObjectFunctions::AddObject();
+        return 0;
+    }
+
+    void registerFunction(lua_State *lua, const char *name, lua_CFunction function)
+    {
+        lua_pushcfunction(lua, function);
+        lua_setfield(lua, -2, name);
+    }
+
+    lua_State *createLuaState(const char *script)
+    {
+        lua_State *lua = luaL_newstate();
+        luaL_openlibs(lua);
+
+        lua_newtable(lua);
+        registerFunction(lua, "GetObjectListSize", getObjectListSize);
+        registerFunction(lua, "GetObjectRefId", getObjectRefId);
+        registerFunction(lua, "GetObjectRefNum", getObjectField<unsigned int, ObjectFunctions::GetObjectRefNum>);
+        registerFunction(lua, "GetObjectMpNum", getObjectField<unsigned int, ObjectFunctions::GetObjectMpNum>);
+        registerFunction(lua, "GetObjectCount", getObjectField<int, ObjectFunctions::GetObjectCount>);
+        registerFunction(lua, "GetObjectCharge", getObjectField<int, ObjectFunctions::GetObjectCharge>);
+        registerFunction(lua, "GetObjectPosX", getObjectField<double, ObjectFunctions::GetObjectPosX>);
+        registerFunction(lua, "GetObjectPosY", getObjectField<double, ObjectFunctions::GetObjectPosY>);
+        registerFunction(lua, "GetObjectPosZ", getObjectField<double, ObjectFunctions::GetObjectPosZ>);
+        registerFunction(lua, "GetObjectRotX", getObjectField<double, ObjectFunctions::GetObjectRotX>);
+        registerFunction(lua, "GetObjectRotY", getObjectField<double, ObjectFunctions::GetObjectRotY>);
+        registerFunction(lua, "GetObjectRotZ", getObjectField<double, ObjectFunctions::GetObjectRotZ>);
+        registerFunction(lua, "SetObjectRefId", setObjectRefId);
+        registerFunction(lua, "SetObjectRefNum", setObjectField<ObjectFunctions::SetObjectRefNum>);
+        registerFunction(lua, "SetObjectMpNum", setObjectField<ObjectFunctions::SetObjectMpNum>);
+        registerFunction(lua, "SetObjectCount", setObjectField<ObjectFunctions::SetObjectCount>);
+        registerFunction(lua, "SetObjectCharge", setObjectField<ObjectFunctions::SetObjectCharge>);
+        registerFunction(lua, "SetObjectPosition", setObjectVector<ObjectFunctions::SetObjectPosition>);
+        registerFunction(lua, "SetObjectRotation", setObjectVector<ObjectFunctions::SetObjectRotation>);
+        registerFunction(lua, "AddObject", addObject);
+        registerFunction(lua, "GetObjectListTable", ObjectFunctions::GetObjectListTable);
+        registerFunction(lua, "AddObjects", ObjectFunctions::AddObjects);
+        lua_setglobal(lua, "tes3mp");
+
+        luaL_dostring(lua, script);
+        return lua;
+    }
+
+    void generateObjects(std::size_t count)
+    {
+        std::vector<mwmp::BaseObject> &objects = receivedObjectList.baseObjects;
+        objects.assign(count, mwmp::BaseObject());
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            mwmp::BaseObject &object = objects[i];
+            object.refId = "misc_com_bottle_0" + std::to_string(i % 10);
+            object.refNum = static_cast<unsigned int>(i);
+            object.mpNum = static_cast<unsigned int>(i * 7);
+            object.count = 1;
+            object.charge = -1;
+            object.position.pos[0] = static_cast<float>(i);
+            object.position.pos[1] = static_cast<float>(i * 2);
+            object.position.pos[2] = 64;
+            object.position.rot[2] = 1.5f;
+        }
+
+        receivedObjectList.baseObjectCount = static_cast<unsigned int>(count);
+        readObjectList = &receivedObjectList;
+    }
+
+    template <std::size_t objectCount>
+    void readObjects(benchmark::State& state, const char *script)
+    {
+        generateObjects(objectCount);
+        lua_State *lua = createLuaState(script);
+
+        while (state.KeepRunning())
+        {
+            lua_getglobal(lua, "readObjects");
+            lua_pcall(lua, 0, 1, 0);
+            benchmark::DoNotOptimize(lua_tonumber(lua, -1));
+            lua_pop(lua, 1);
+        }
+
+        lua_close(lua);
+    }
+
+    template <std::size_t objectCount>
+    void addObjects(benchmark::State& state, const char *script)
+    {
+        lua_State *lua = createLuaState(script);
+
+        while (state.KeepRunning())
+        {
+            ObjectFunctions::ClearObjectList();
+            lua_getglobal(lua, "addObjects");
+            lua_pushinteger(lua, objectCount);
+            lua_pcall(lua, 1, 0, 0);
+            benchmark::DoNotOptimize(writeObjectList.baseObjects.data());
+        }
+
+        lua_close(lua);
+    }
+
+    template <std::size_t objectCount>
+    void readPerField(benchmark::State& state)
+    {
+        readObjects<objectCount>(state, perFieldScript);
+    }
+
+    template <std::size_t objectCount>
+    void readTable(benchmark::State& state)
+    {
+        readObjects<objectCount>(state, tableScript);
+    }
+
+    template <std::size_t objectCount>
+    void addPerField(benchmark::State& state)
+    {
+        addObjects<objectCount>(state, perFieldScript);
+    }
+
+    template <std::size_t objectCount>
+    void addTable(benchmark::State& state)
+    {
+        addObjects<objectCount>(state, tableScript);
+    }
+
+    constexpr auto readPerField_100 = readPerField<100>;
+    constexpr auto readPerField_2000 = readPerField<2000>;
+    constexpr auto readTable_100 = readTable<100>;
+    constexpr auto readTable_2000 = readTable<2000>;
+    constexpr auto addPerField_100 = addPerField<100>;
+    constexpr auto addPerField_2000 = addPerField<2000>;
+    constexpr auto addTable_100 = addTable<100>;
+    constexpr auto addTable_2000 = addTable<2000>;
+} // namespace
+
+BENCHMARK(readPerField_100);
+BENCHMARK(readPerField_2000);
+BENCHMARK(readTable_100);
+BENCHMARK(readTable_2000);
+BENCHMARK(addPerField_100);
+BENCHMARK(addPerField_2000);
+BENCHMARK(addTable_100);
+BENCHMARK(addTable_2000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw-mp/Script/API/TimerSchedule.hpp>
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    using namespace mwmp;
+
+    typedef TimerSchedule::Clock Clock;
+
+    // The per-tick work done by the server before timers were kept in a schedule: every timer
+    // in the map is visited and reads the clock on its own
+    struct ScannedTimer
+    {
+        double startTime;
+        double targetMsec;
+        bool isEnded;
+    };
+
+    double nowMsec()
+    {
+        const auto duration = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    }
+
+    template <std::size_t timerCount>
+    void tickScannedIdle(benchmark::State& state)
+    {
+        std::unordered_map<int, ScannedTimer*> timers;
+        std::vector<ScannedTimer> storage(timerCount, ScannedTimer {nowMsec(), 3600000, false});
+
+        for (std::size_t i = 0; i < timerCount; i++)
+            timers[static_cast<int>(i)] = &storage[i];
+
+        while (state.KeepRunning())
+        {
+            int fired = 0;
+
+            for (auto timer : timers)
+            {
+                if (timer.second == nullptr || timer.second->isEnded)
+                    continue;
+
+                if (nowMsec() - timer.second->startTime >= timer.second->targetMsec)
+                    fired++;
+            }
+
+            benchmark::DoNotOptimize(fired);
+        }
+    }
+
+    template <std::size_t timerCount>
+    void tickScheduledIdle(benchmark::State& state)
+    {
+        TimerSchedule schedule;
+        std::minstd_rand random;
+        std::uniform_int_distribution<int> distribution(60000, 3600000);
+        const auto start = Clock::now();
+
+        for (std::size_t i = 0; i < timerCount; i++)
+            schedule.schedule(schedule.allocate(), start + std::chrono::milliseconds(distribution(random)));
+
+        std::vector<int> expired;
+
+        while (state.KeepRunning())
+        {
+            expired.clear();
+            const auto now = Clock::now();
+            schedule.popExpired(now, expired);
+            benchmark::DoNotOptimize(schedule.msecUntilNext(now));
+            benchmark::DoNotOptimize(expired.size());
+        }
+    }
+
+    // Every timer expires once and is started again, as regen and AFK check timers do
+    template <std::size_t timerCount>
+    void tickScheduledRestarting(benchmark::State& state)
+    {
+        TimerSchedule schedule;
+        std::vector<int> expired;
+        auto now = Clock::now();
+
+        for (std::size_t i = 0; i < timerCount; i++)
+            schedule.schedule(schedule.allocate(), now + std::chrono::milliseconds(i % 1000));
+
+        while (state.KeepRunning())
+        {
+            now += std::chrono::milliseconds(1);
+            expired.clear();
+            schedule.popExpired(now, expired);
+
+            for (int id : expired)
+                schedule.schedule(id, now + std::chrono::milliseconds(1000));
+
+            benchmark::DoNotOptimize(expired.size());
+        }
+    }
+
+    template <std::size_t timerCount>
+    void createAndFree(benchmark::State& state)
+    {
+        TimerSchedule schedule;
+        std::vector<int> ids;
+        const auto start = Clock::now();
+
+        for (std::size_t i = 0; i < timerCount; i++)
+            ids.push_back(schedule.allocate());
+
+        std::size_t n = 0;
+
+        while (state.KeepRunning())
+        {
+            int &id = ids[n++ % ids.size()];
+            schedule.release(id);
+            id = schedule.allocate();
+            schedule.schedule(id, start + std::chrono::milliseconds(n % 10000));
+            benchmark::DoNotOptimize(id);
+        }
+    }
+
+    constexpr auto tickScannedIdle_1k = tickScannedIdle<1000>;
+    constexpr auto tickScannedIdle_10k = tickScannedIdle<10000>;
+    constexpr auto tickScheduledIdle_1k = tickScheduledIdle<1000>;
+    constexpr auto tickScheduledIdle_10k = tickScheduledIdle<10000>;
+    constexpr auto tickScheduledRestarting_10k = tickScheduledRestarting<10000>;
+    constexpr auto createAndFree_10k = createAndFree<10000>;
+} // namespace
+
+BENCHMARK(tickScannedIdle_1k);
+BENCHMARK(tickScannedIdle_10k);
+BENCHMARK(tickScheduledIdle_1k);
+BENCHMARK(tickScheduledIdle_10k);
+BENCHMARK(tickScheduledRestarting_10k);
+BENCHMARK(createAndFree_10k);
+
+BENCHMARK_MAIN();
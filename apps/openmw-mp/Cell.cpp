@@ -8,7 +8,7 @@
 
 Cell::Cell(ESM::Cell cell) : cell(cell)
 {
-    cellActorList.count = 0;
+
 }
 
 Cell::Iterator Cell::begin() const
@@ -78,13 +78,11 @@ void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newA
 {
     for (unsigned int i = 0; i < newActorList->count; i++)
     {
-        mwmp::BaseActor newActor = newActorList->baseActors.at(i);
-        mwmp::BaseActor *cellActor;
+        const mwmp::BaseActor &newActor = newActorList->baseActors.at(i);
+        mwmp::BaseActor *cellActor = cellActors.get(newActor.refNum, newActor.mpNum);
 
-        if (containsActor(newActor.refNum, newActor.mpNum))
+        if (cellActor != nullptr)
         {
-            cellActor = getActor(newActor.refNum, newActor.mpNum);
-
             switch (packetID)
             {
             case ID_ACTOR_POSITION:
@@ -103,62 +101,27 @@ void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newA
             }
         }
         else
-            cellActorList.baseActors.push_back(newActor);
+            cellActors.add(newActor);
     }
-
-    cellActorList.count = cellActorList.baseActors.size();
 }
 
 bool Cell::containsActor(int refNum, int mpNum)
 {
-    for (unsigned int i = 0; i < cellActorList.baseActors.size(); i++)
-    {
-        mwmp::BaseActor actor = cellActorList.baseActors.at(i);
-
-        if (actor.refNum == refNum && actor.mpNum == mpNum)
-            return true;
-    }
-    return false;
+    return cellActors.contains(refNum, mpNum);
 }
 
 mwmp::BaseActor *Cell::getActor(int refNum, int mpNum)
 {
-    for (unsigned int i = 0; i < cellActorList.baseActors.size(); i++)
-    {
-        mwmp::BaseActor *actor = &cellActorList.baseActors.at(i);
-
-        if (actor->refNum == refNum && actor->mpNum == mpNum)
-            return actor;
-    }
-    return 0;
+    return cellActors.get(refNum, mpNum);
 }
 
 void Cell::removeActors(const mwmp::BaseActorList *newActorList)
 {
-    for (std::vector<mwmp::BaseActor>::iterator it = cellActorList.baseActors.begin(); it != cellActorList.baseActors.end();)
+    for (unsigned int i = 0; i < newActorList->count; i++)
     {
-        int refNum = (*it).refNum;
-        int mpNum = (*it).mpNum;
-
-        bool foundActor = false;
-
-        for (unsigned int i = 0; i < newActorList->count; i++)
-        {
-            mwmp::BaseActor newActor = newActorList->baseActors.at(i);
-
-            if (newActor.refNum == refNum && newActor.mpNum == mpNum)
-            {
-                it = cellActorList.baseActors.erase(it);
-                foundActor = true;
-                break;
-            }
-        }
-
-        if (!foundActor)
-            it++;
+        const mwmp::BaseActor &newActor = newActorList->baseActors.at(i);
+        cellActors.remove(newActor.refNum, newActor.mpNum);
     }
-
-    cellActorList.count = cellActorList.baseActors.size();
 }
 
 RakNet::RakNetGUID *Cell::getAuthority()
@@ -173,7 +136,7 @@ void Cell::setAuthority(const RakNet::RakNetGUID& guid)
 
 mwmp::BaseActorList *Cell::getActorList()
 {
-    return &cellActorList;
+    return cellActors.getActorList();
 }
 
 Cell::TPlayers Cell::getPlayers() const
@@ -197,15 +160,18 @@ void Cell::sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *bas
     plList.sort();
     plList.unique();
 
+    std::vector<RakNet::RakNetGUID> recipients;
+
     for (auto pl : plList)
     {
         if (pl->guid == baseActorList->guid) continue;
 
-        actorPacket->setActorList(baseActorList);
-
-        // Send the packet to this eligible guid
-        actorPacket->Send(pl->guid);
+        recipients.push_back(pl->guid);
     }
+
+    // Serialize the packet once and send it to every eligible guid
+    actorPacket->setActorList(baseActorList);
+    actorPacket->Send(recipients);
 }
 
 void Cell::sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *baseObjectList) const
@@ -224,15 +190,18 @@ void Cell::sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *
     plList.sort();
     plList.unique();
 
+    std::vector<RakNet::RakNetGUID> recipients;
+
     for (auto pl : plList)
     {
         if (pl->guid == baseObjectList->guid) continue;
 
-        objectPacket->setObjectList(baseObjectList);
-
-        // Send the packet to this eligible guid
-        objectPacket->Send(pl->guid);
+        recipients.push_back(pl->guid);
     }
+
+    // Serialize the packet once and send it to every eligible guid
+    objectPacket->setObjectList(baseObjectList);
+    objectPacket->Send(recipients);
 }
 
 std::string Cell::getShortDescription() const
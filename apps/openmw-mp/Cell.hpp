@@ -8,6 +8,7 @@
 #include <components/openmw-mp/Base/BaseObject.hpp>
 #include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
 #include <components/openmw-mp/Packets/Object/ObjectPacket.hpp>
+#include "IndexedActorList.hpp"
 
 class Player;
 class Cell;
@@ -47,7 +48,7 @@ private:
     ESM::Cell cell;
 
     RakNet::RakNetGUID authorityGuid;
-    mwmp::BaseActorList cellActorList;
+    IndexedActorList cellActors;
 };
 
 
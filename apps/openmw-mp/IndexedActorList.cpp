@@ -0,0 +1,71 @@
+#include "IndexedActorList.hpp"
+
+IndexedActorList::IndexedActorList()
+{
+    actorList.count = 0;
+}
+
+mwmp::BaseActorList *IndexedActorList::getActorList()
+{
+    return &actorList;
+}
+
+bool IndexedActorList::contains(unsigned int refNum, unsigned int mpNum) const
+{
+    return indices.find(makeKey(refNum, mpNum)) != indices.end();
+}
+
+mwmp::BaseActor *IndexedActorList::get(unsigned int refNum, unsigned int mpNum)
+{
+    auto it = indices.find(makeKey(refNum, mpNum));
+
+    if (it == indices.end())
+        return nullptr;
+
+    return &actorList.baseActors[it->second];
+}
+
+mwmp::BaseActor *IndexedActorList::add(const mwmp::BaseActor &actor)
+{
+    auto result = indices.emplace(makeKey(actor.refNum, actor.mpNum), actorList.baseActors.size());
+
+    if (result.second)
+    {
+        actorList.baseActors.push_back(actor);
+        actorList.count = actorList.baseActors.size();
+    }
+
+    return &actorList.baseActors[result.first->second];
+}
+
+bool IndexedActorList::remove(unsigned int refNum, unsigned int mpNum)
+{
+    auto it = indices.find(makeKey(refNum, mpNum));
+
+    if (it == indices.end())
+        return false;
+
+    std::size_t index = it->second;
+    std::size_t lastIndex = actorList.baseActors.size() - 1;
+
+    indices.erase(it);
+
+    if (index != lastIndex)
+    {
+        mwmp::BaseActor &lastActor = actorList.baseActors[lastIndex];
+        indices[makeKey(lastActor.refNum, lastActor.mpNum)] = index;
+        actorList.baseActors[index] = std::move(lastActor);
+    }
+
+    actorList.baseActors.pop_back();
+    actorList.count = actorList.baseActors.size();
+
+    return true;
+}
+
+void IndexedActorList::clear()
+{
+    indices.clear();
+    actorList.baseActors.clear();
+    actorList.count = 0;
+}
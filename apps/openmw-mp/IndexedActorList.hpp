@@ -0,0 +1,43 @@
+#ifndef OPENMW_INDEXEDACTORLIST_HPP
+#define OPENMW_INDEXEDACTORLIST_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <components/openmw-mp/Base/BaseActor.hpp>
+
+/**
+ * A BaseActorList whose actors can be looked up by refNum and mpNum in constant time.
+ *
+ * The actors stay in the list's baseActors vector, so scripts can keep reading them by index,
+ * while a hash map keeps track of each actor's position in it. Removing an actor moves the last
+ * one into its place. Pointers returned by get() and add() remain valid until the next call that
+ * adds or removes an actor.
+ */
+class IndexedActorList
+{
+public:
+    IndexedActorList();
+
+    mwmp::BaseActorList *getActorList();
+
+    bool contains(unsigned int refNum, unsigned int mpNum) const;
+    mwmp::BaseActor *get(unsigned int refNum, unsigned int mpNum);
+
+    // Add a copy of an actor unless one with the same refNum and mpNum is already present,
+    // returning the actor stored in the list either way
+    mwmp::BaseActor *add(const mwmp::BaseActor &actor);
+    bool remove(unsigned int refNum, unsigned int mpNum);
+
+    void clear();
+
+private:
+    static uint64_t makeKey(unsigned int refNum, unsigned int mpNum)
+    {
+        return (static_cast<uint64_t>(refNum) << 32) | mpNum;
+    }
+
+    mwmp::BaseActorList actorList;
+    std::unordered_map<uint64_t, std::size_t> indices;
+};
+
+#endif //OPENMW_INDEXEDACTORLIST_HPP
@@ -0,0 +1,63 @@
+#include "InterestBands.hpp"
+
+#include <algorithm>
+
+using namespace mwmp;
+
+void InterestBands::clear()
+{
+    bands.clear();
+}
+
+void InterestBands::addBand(float maxDistance, unsigned int interval)
+{
+    Band band {maxDistance, std::max(1u, interval)};
+
+    // Keep the bands sorted by distance, replacing any band with the same distance
+    auto it = std::lower_bound(bands.begin(), bands.end(), band,
+                               [] (const Band &left, const Band &right) { return left.maxDistance < right.maxDistance; });
+
+    if (it != bands.end() && it->maxDistance == maxDistance)
+        *it = band;
+    else
+        bands.insert(it, band);
+}
+
+bool InterestBands::isEnabled() const
+{
+    return !bands.empty();
+}
+
+const std::vector<InterestBands::Band> &InterestBands::getBands() const
+{
+    return bands;
+}
+
+unsigned int InterestBands::getInterval(float distanceSquared) const
+{
+    if (bands.empty())
+        return 1;
+
+    for (const auto &band : bands)
+    {
+        if (distanceSquared <= band.maxDistance * band.maxDistance)
+            return band.interval;
+    }
+
+    return bands.back().interval;
+}
+
+bool InterestBands::shouldRelay(float distanceSquared, unsigned int updateCount, unsigned int recipientId,
+                                bool endsMovement) const
+{
+    // No later update would make up for skipping this one
+    if (endsMovement)
+        return true;
+
+    unsigned int interval = getInterval(distanceSquared);
+
+    if (interval <= 1)
+        return true;
+
+    return (updateCount + recipientId) % interval == 0;
+}
@@ -0,0 +1,53 @@
+#ifndef OPENMW_INTERESTBANDS_HPP
+#define OPENMW_INTERESTBANDS_HPP
+
+#include <vector>
+
+namespace mwmp
+{
+    /**
+     * Distance-tiered update rates for relaying a player's position to the players around them.
+     *
+     * Each band covers recipients up to a certain distance and relays every Nth position update
+     * to them. Recipients farther away than the last band use that band's interval. Without any
+     * bands, every update is relayed to everyone.
+     *
+     * Clients stop sending positions once they stand still, so the update that ends a movement
+     * is relayed to everyone whatever their band. Otherwise far recipients would keep showing
+     * the sender where an earlier update left them, still moving.
+     */
+    class InterestBands
+    {
+    public:
+        struct Band
+        {
+            float maxDistance;
+            unsigned int interval;
+        };
+
+        void clear();
+        void addBand(float maxDistance, unsigned int interval);
+
+        bool isEnabled() const;
+        const std::vector<Band> &getBands() const;
+
+        unsigned int getInterval(float distanceSquared) const;
+
+        /**
+         * Whether a position update should be relayed to a recipient.
+         *
+         * \param distanceSquared The squared distance between sender and recipient.
+         * \param updateCount The number of position updates received from the sender so far.
+         * \param recipientId A number identifying the recipient, used to spread the relayed
+         *                    updates of one sender across different ticks for different recipients.
+         * \param endsMovement Whether the update leaves the sender standing still.
+         */
+        bool shouldRelay(float distanceSquared, unsigned int updateCount, unsigned int recipientId,
+                         bool endsMovement) const;
+
+    private:
+        std::vector<Band> bands;
+    };
+}
+
+#endif //OPENMW_INTERESTBANDS_HPP
@@ -20,6 +20,7 @@
 #include "MasterClient.hpp"
 #include "Cell.hpp"
 #include "CellController.hpp"
+#include "Telemetry.hpp"
 #include "processors/PlayerProcessor.hpp"
 #include "processors/ActorProcessor.hpp"
 #include "processors/ObjectProcessor.hpp"
@@ -36,7 +37,18 @@ static bool dataFileEnforcementState = true;
 static bool scriptErrorIgnoringState = false;
 bool killLoop = false;
 
-Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
+// Only players who listed BaseSystem::STRING_TABLE in their handshake are sent strings by index
+static StringTables *getStringTables(const RakNet::AddressOrGUID &connection)
+{
+    Player *player = Players::getPlayer(connection.rakNetGuid);
+
+    if (player == nullptr || !player->hasCapability(BaseSystem::STRING_TABLE))
+        return nullptr;
+
+    return &player->getStringTables();
+}
+
+Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr), packetDecoder(peer), packetBatcher(peer)
 {
     sThis = this;
     this->peer = peer;
@@ -57,6 +69,9 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     objectPacketController->SetStream(0, &bsOut);
     worldstatePacketController->SetStream(0, &bsOut);
 
+    BasePacket::setStringTablesLookup(getStringTables);
+    BasePacket::setPacketBatcher(&packetBatcher);
+
     running = true;
     exitCode = 0;
 
@@ -65,14 +80,23 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     serverPassword = TES3MP_DEFAULT_PASSW;
 
     ProcessorInitializer();
+    initDispatchTable();
 }
 
 Networking::~Networking()
 {
     Script::Call<Script::CallbackIdentity("OnServerExit")>(false);
+    packetBatcher.flush();
+
+    // Write whatever scripts saved last before the server goes away
+    if (!recordStore.close())
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "%s", recordStore.getError().c_str());
 
     CellController::destroy();
 
+    BasePacket::setStringTablesLookup(nullptr);
+    BasePacket::setPacketBatcher(nullptr);
+
     sThis = 0;
     delete systemPacketController;
     delete playerPacketController;
@@ -132,11 +156,12 @@ void Networking::processSystemPacket(RakNet::Packet *packet)
             }
         }
         player->setHandshake();
+        player->setCapabilities(baseSystem.capabilities);
         return;
     }
 }
 
-void Networking::processPlayerPacket(RakNet::Packet *packet)
+void Networking::processPlayerPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket)
 {
     Player *player = Players::getPlayer(packet->guid);
 
@@ -190,31 +215,40 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
     }
 
 
-    if (!PlayerProcessor::Process(*packet))
+    if (decodedPacket != nullptr)
+        PacketDecoder::applyPlayerData(*decodedPacket, *player);
+
+    if (!PlayerProcessor::Process(*packet, decodedPacket != nullptr))
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled PlayerPacket with identifier %i has arrived", packet->data[0]);
 
 }
 
-void Networking::processActorPacket(RakNet::Packet *packet)
+void Networking::processActorPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!ActorProcessor::Process(*packet, baseActorList))
+    if (decodedPacket != nullptr)
+        baseActorList = std::move(*decodedPacket->actorList);
+
+    if (!ActorProcessor::Process(*packet, baseActorList, decodedPacket != nullptr))
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
 
 }
 
-void Networking::processObjectPacket(RakNet::Packet *packet)
+void Networking::processObjectPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!ObjectProcessor::Process(*packet, baseObjectList))
+    if (decodedPacket != nullptr)
+        baseObjectList = std::move(*decodedPacket->objectList);
+
+    if (!ObjectProcessor::Process(*packet, baseObjectList, decodedPacket != nullptr))
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
 
 }
@@ -304,35 +338,59 @@ bool Networking::preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn)
     return false;
 }
 
-void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn)
+void Networking::initDispatchTable()
 {
-    if (systemPacketController->ContainsPacket(packet->data[0]))
+    for (unsigned int packetID = 0; packetID < packetGroups.size(); packetID++)
     {
-        systemPacketController->SetStream(&bsIn, nullptr);
-        processSystemPacket(packet);
+        RakNet::MessageID id = static_cast<RakNet::MessageID>(packetID);
+
+        if (systemPacketController->ContainsPacket(id))
+            packetGroups[packetID] = PacketGroup::SYSTEM;
+        else if (playerPacketController->ContainsPacket(id))
+            packetGroups[packetID] = PacketGroup::PLAYER;
+        else if (actorPacketController->ContainsPacket(id))
+            packetGroups[packetID] = PacketGroup::ACTOR;
+        else if (objectPacketController->ContainsPacket(id))
+            packetGroups[packetID] = PacketGroup::OBJECT;
+        else if (worldstatePacketController->ContainsPacket(id))
+            packetGroups[packetID] = PacketGroup::WORLDSTATE;
+        else
+            packetGroups[packetID] = PacketGroup::NONE;
     }
-    else if (playerPacketController->ContainsPacket(packet->data[0]))
-    {
-        playerPacketController->SetStream(&bsIn, nullptr);
-        processPlayerPacket(packet);
-    }
-    else if (actorPacketController->ContainsPacket(packet->data[0]))
-    {
-        actorPacketController->SetStream(&bsIn, 0);
-        processActorPacket(packet);
-    }
-    else if (objectPacketController->ContainsPacket(packet->data[0]))
-    {
-        objectPacketController->SetStream(&bsIn, 0);
-        processObjectPacket(packet);
-    }
-    else if (worldstatePacketController->ContainsPacket(packet->data[0]))
+}
+
+void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn, PacketDecoder::DecodedPacket *decodedPacket)
+{
+    RakNet::MessageID packetID = packet->data[0];
+
+    // Only the packet being processed reads from this stream, so there's no need to hand it
+    // to every other packet of the same controller
+    switch (packetGroups[packetID])
     {
-        worldstatePacketController->SetStream(&bsIn, 0);
-        processWorldstatePacket(packet);
+        case PacketGroup::SYSTEM:
+            systemPacketController->GetPacket(packetID)->SetReadStream(&bsIn);
+            processSystemPacket(packet);
+            break;
+        case PacketGroup::PLAYER:
+            playerPacketController->GetPacket(packetID)->SetReadStream(&bsIn);
+            processPlayerPacket(packet, decodedPacket);
+            break;
+        case PacketGroup::ACTOR:
+            actorPacketController->GetPacket(packetID)->SetReadStream(&bsIn);
+            processActorPacket(packet, decodedPacket);
+            break;
+        case PacketGroup::OBJECT:
+            objectPacketController->GetPacket(packetID)->SetReadStream(&bsIn);
+            processObjectPacket(packet, decodedPacket);
+            break;
+        case PacketGroup::WORLDSTATE:
+            worldstatePacketController->GetPacket(packetID)->SetReadStream(&bsIn);
+            processWorldstatePacket(packet);
+            break;
+        default:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packetID);
+            break;
     }
-    else
-        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packet->data[0]);
 }
 
 void Networking::newPlayer(RakNet::RakNetGUID guid)
@@ -391,6 +449,14 @@ void Networking::disconnectPlayer(RakNet::RakNetGUID guid)
     playerPacketController->GetPacket(ID_USER_DISCONNECTED)->setPlayer(player);
     playerPacketController->GetPacket(ID_USER_DISCONNECTED)->Send(true);
     Players::deletePlayer(guid);
+
+    for (auto it = positionKeyframeReceipts.begin(); it != positionKeyframeReceipts.end();)
+    {
+        if (it->second.recipient == guid || it->second.subject == guid)
+            it = positionKeyframeReceipts.erase(it);
+        else
+            ++it;
+    }
 }
 
 PlayerPacketController *Networking::getPlayerPacketController() const
@@ -511,6 +577,91 @@ BOOL WINAPI sigIntHandler(_In_ DWORD dwCtrlType) {
 }
 #endif
 
+void Networking::processPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket)
+{
+    if (getMasterClient()->Process(packet))
+        return;
+
+    switch (packet->data[0])
+    {
+        case ID_REMOTE_DISCONNECTION_NOTIFICATION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has disconnected", packet->systemAddress.ToString());
+            break;
+        case ID_REMOTE_CONNECTION_LOST:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
+            break;
+        case ID_REMOTE_NEW_INCOMING_CONNECTION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has connected", packet->systemAddress.ToString());
+            break;
+        case ID_CONNECTION_REQUEST_ACCEPTED:    // client to server
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Our connection request has been accepted");
+            break;
+        }
+        case ID_NEW_INCOMING_CONNECTION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "A connection is incoming from %s", packet->systemAddress.ToString());
+            break;
+        case ID_NO_FREE_INCOMING_CONNECTIONS:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "The server is full");
+            break;
+        case ID_DISCONNECTION_NOTIFICATION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN,  "Client at %s has disconnected", packet->systemAddress.ToString());
+            disconnectPlayer(packet->guid);
+            break;
+        case ID_CONNECTION_LOST:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
+            disconnectPlayer(packet->guid);
+            break;
+        case ID_SND_RECEIPT_ACKED:
+        case ID_SND_RECEIPT_LOSS:
+            processSendReceipt(packet);
+            break;
+        case ID_CONNECTED_PING:
+        case ID_UNCONNECTED_PING:
+            break;
+        default:
+        {
+            RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+            bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+            Telemetry::PacketScope telemetryScope(packet->data[0], packet->length);
+
+            if (Players::doesPlayerExist(packet->guid))
+                update(packet, bsIn, decodedPacket);
+            else
+                preInit(packet, bsIn);
+            break;
+        }
+    }
+}
+
+void Networking::processSendReceipt(RakNet::Packet *packet)
+{
+    RakNet::BitStream bsIn(packet->data, packet->length, false);
+    bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+
+    uint32_t receipt;
+    if (!bsIn.Read(receipt))
+        return;
+
+    auto it = positionKeyframeReceipts.find(receipt);
+    if (it == positionKeyframeReceipts.end())
+        return;
+
+    // A lost keyframe needs nothing else, because it keeps being sent until one gets through,
+    // and an acknowledgement arriving after the subject has moved on to a new keyframe is useless
+    if (packet->data[0] == ID_SND_RECEIPT_ACKED && Players::doesPlayerExist(it->second.subject))
+    {
+        Player *subject = Players::getPlayer(it->second.subject);
+        Player *recipient = Players::getPlayer(it->second.recipient);
+
+        if (recipient != nullptr && subject->positionBaseline.keyframeId == it->second.keyframeId)
+            recipient->setPositionKeyframeAcked(it->second.subject, it->second.keyframeId);
+    }
+
+    positionKeyframeReceipts.erase(it);
+}
+
 int Networking::mainLoop()
 {
     RakNet::Packet *packet;
@@ -529,62 +680,42 @@ int Networking::mainLoop()
     
     while (running and !killLoop)
     {
+        tickScheduler.beginTick();
         mwmp_input::handler();
-        for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
+
+        // Receive the whole batch first, so large packets further down can be decoded by the
+        // PacketDecoder's threads while the ones before them are being processed
+        while (receivedPackets.size() < tickScheduler.getMaxPacketsPerTick() && (packet = peer->Receive()) != nullptr)
         {
-            if (getMasterClient()->Process(packet))
-                continue;
+            // Strings defined by a packet have to be known before it's decoded, and regardless of
+            // whether it ends up being read at all
+            if (Player *player = Players::getPlayer(packet->guid))
+                player->getStringTables().readDefinitions(*packet);
 
-            switch (packet->data[0])
-            {
-                case ID_REMOTE_DISCONNECTION_NOTIFICATION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has disconnected", packet->systemAddress.ToString());
-                    break;
-                case ID_REMOTE_CONNECTION_LOST:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
-                    break;
-                case ID_REMOTE_NEW_INCOMING_CONNECTION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has connected", packet->systemAddress.ToString());
-                    break;
-                case ID_CONNECTION_REQUEST_ACCEPTED:    // client to server
-                {
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Our connection request has been accepted");
-                    break;
-                }
-                case ID_NEW_INCOMING_CONNECTION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "A connection is incoming from %s", packet->systemAddress.ToString());
-                    break;
-                case ID_NO_FREE_INCOMING_CONNECTIONS:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "The server is full");
-                    break;
-                case ID_DISCONNECTION_NOTIFICATION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN,  "Client at %s has disconnected", packet->systemAddress.ToString());
-                    disconnectPlayer(packet->guid);
-                    break;
-                case ID_CONNECTION_LOST:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
-                    disconnectPlayer(packet->guid);
-                    break;
-                case ID_SND_RECEIPT_ACKED:
-                case ID_CONNECTED_PING:
-                case ID_UNCONNECTED_PING:
-                    break;
-                default:
-                {
-                    RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
-                    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+            receivedPackets.emplace_back(packet, packetDecoder.submit(packet));
+        }
 
+        unsigned int packetCount = static_cast<unsigned int>(receivedPackets.size());
 
-                    if (Players::doesPlayerExist(packet->guid))
-                        update(packet, bsIn);
-                    else
-                        preInit(packet, bsIn);
-                    break;
-                }
-            }
+        for (auto &receivedPacket : receivedPackets)
+        {
+            PacketDecoder::DecodedPacket *decodedPacket = receivedPacket.second.get();
+
+            if (decodedPacket != nullptr)
+                packetDecoder.wait(*decodedPacket);
+
+            processPacket(receivedPacket.first, decodedPacket);
+            peer->DeallocatePacket(receivedPacket.first);
         }
+
+        receivedPackets.clear();
+
         TimerAPI::Tick();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Telemetry::update();
+
+        // Send everything the tick has batched up before sleeping until the next one
+        packetBatcher.flush();
+        tickScheduler.endTick(packetCount, peer->NumberOfConnections() > 0, TimerAPI::GetMsecUntilNextTimer());
     }
 
     TimerAPI::Terminate();
@@ -593,6 +724,8 @@ int Networking::mainLoop()
 
 void Networking::kickPlayer(RakNet::RakNetGUID guid, bool sendNotification)
 {
+    // Whatever the player was sent before being kicked, such as the reason why, still has to reach them
+    packetBatcher.flush(guid);
     peer->CloseConnection(guid, sendNotification);
 }
 
@@ -626,6 +759,42 @@ unsigned short Networking::getPort() const
     return peer->GetMyBoundAddress().GetPort();
 }
 
+TickScheduler &Networking::getTickScheduler()
+{
+    return tickScheduler;
+}
+
+const TickScheduler &Networking::getTickScheduler() const
+{
+    return tickScheduler;
+}
+
+InterestBands &Networking::getPositionInterestBands()
+{
+    return positionInterestBands;
+}
+
+const InterestBands &Networking::getPositionInterestBands() const
+{
+    return positionInterestBands;
+}
+
+PacketDecoder &Networking::getPacketDecoder()
+{
+    return packetDecoder;
+}
+
+RecordStore &Networking::getRecordStore()
+{
+    return recordStore;
+}
+
+void Networking::addPositionKeyframeReceipt(uint32_t receipt, RakNet::RakNetGUID recipient, RakNet::RakNetGUID subject,
+                                            uint8_t keyframeId)
+{
+    positionKeyframeReceipts[receipt] = {recipient, subject, keyframeId};
+}
+
 MasterClient *Networking::getMasterClient()
 {
     return mclient;
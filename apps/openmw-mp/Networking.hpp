@@ -1,13 +1,21 @@
 #ifndef OPENMW_NETWORKING_HPP
 #define OPENMW_NETWORKING_HPP
 
+#include <array>
+#include <unordered_map>
+
 #include <components/openmw-mp/Controllers/SystemPacketController.hpp>
 #include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
 #include <components/openmw-mp/Controllers/ActorPacketController.hpp>
 #include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
 #include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+#include <components/openmw-mp/Packets/PacketBatcher.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
 #include "Player.hpp"
+#include "InterestBands.hpp"
+#include "PacketDecoder.hpp"
+#include "RecordStore.hpp"
+#include "TickScheduler.hpp"
 
 class MasterClient;
 namespace  mwmp
@@ -27,11 +35,11 @@ namespace  mwmp
         RakNet::SystemAddress getSystemAddress(RakNet::RakNetGUID guid);
 
         void processSystemPacket(RakNet::Packet *packet);
-        void processPlayerPacket(RakNet::Packet *packet);
-        void processActorPacket(RakNet::Packet *packet);
-        void processObjectPacket(RakNet::Packet *packet);
+        void processPlayerPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket = nullptr);
+        void processActorPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket = nullptr);
+        void processObjectPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket = nullptr);
         void processWorldstatePacket(RakNet::Packet *packet);
-        void update(RakNet::Packet *packet, RakNet::BitStream &bsIn);
+        void update(RakNet::Packet *packet, RakNet::BitStream &bsIn, PacketDecoder::DecodedPacket *decodedPacket = nullptr);
 
         unsigned short numberOfConnections() const;
         unsigned int maxConnections() const;
@@ -40,6 +48,21 @@ namespace  mwmp
 
         int mainLoop();
 
+        TickScheduler &getTickScheduler();
+        const TickScheduler &getTickScheduler() const;
+
+        InterestBands &getPositionInterestBands();
+        const InterestBands &getPositionInterestBands() const;
+
+        PacketDecoder &getPacketDecoder();
+
+        RecordStore &getRecordStore();
+
+        // Remember which position keyframe went out in the message with this receipt, so the
+        // recipient can be switched over to deltas once RakNet reports it as delivered
+        void addPositionKeyframeReceipt(uint32_t receipt, RakNet::RakNetGUID recipient, RakNet::RakNetGUID subject,
+                                        uint8_t keyframeId);
+
         void stopServer(int code);
 
         SystemPacketController *getSystemPacketController() const;
@@ -74,7 +97,21 @@ namespace  mwmp
 
         PacketPreInit::PluginContainer &getSamples();
     private:
+        // The controller that handles each packet ID
+        enum class PacketGroup : unsigned char
+        {
+            NONE = 0,
+            SYSTEM,
+            PLAYER,
+            ACTOR,
+            OBJECT,
+            WORLDSTATE
+        };
+
         bool preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn);
+        void processPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decodedPacket = nullptr);
+        void processSendReceipt(RakNet::Packet *packet);
+        void initDispatchTable();
         std::string serverPassword;
         static Networking *sThis;
 
@@ -94,6 +131,28 @@ namespace  mwmp
         ObjectPacketController *objectPacketController;
         WorldstatePacketController *worldstatePacketController;
 
+        std::array<PacketGroup, 256> packetGroups;
+
+        TickScheduler tickScheduler;
+        InterestBands positionInterestBands;
+        PacketDecoder packetDecoder;
+        // Packets sent to a player during a tick go out together at the end of it
+        PacketBatcher packetBatcher;
+        RecordStore recordStore;
+
+        struct PositionKeyframeReceipt
+        {
+            RakNet::RakNetGUID recipient;
+            RakNet::RakNetGUID subject;
+            uint8_t keyframeId;
+        };
+
+        // Position keyframes that haven't been acknowledged or reported lost yet, by receipt
+        std::unordered_map<uint32_t, PositionKeyframeReceipt> positionKeyframeReceipts;
+
+        // Packets received during the current tick, along with their contents if they're being decoded
+        std::vector<std::pair<RakNet::Packet *, std::shared_ptr<PacketDecoder::DecodedPacket>>> receivedPackets;
+
         bool running;
         int exitCode;
         PacketPreInit::PluginContainer samples;
@@ -0,0 +1,230 @@
+#include "PacketDecoder.hpp"
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
+
+#include <BitStream.h>
+
+#include "Player.hpp"
+#include "processors/ActorProcessor.hpp"
+#include "processors/ObjectProcessor.hpp"
+#include "processors/PlayerProcessor.hpp"
+
+using namespace mwmp;
+
+// Packets keep a pointer to the list they read into, so every thread needs packets of its own
+struct PacketDecoder::Controllers
+{
+    Controllers(RakNet::RakPeerInterface *peer) : player(peer), actor(peer), object(peer)
+    {
+
+    }
+
+    PlayerPacketController player;
+    ActorPacketController actor;
+    ObjectPacketController object;
+};
+
+PacketDecoder::PacketDecoder(RakNet::RakPeerInterface *peer) : peer(peer), mainControllers(new Controllers(peer)),
+    isStopping(false)
+{
+
+}
+
+PacketDecoder::~PacketDecoder()
+{
+    stopThreads();
+}
+
+void PacketDecoder::setThreadCount(unsigned int threadCount)
+{
+    stopThreads();
+
+    for (unsigned int i = 0; i < threadCount; i++)
+        threads.emplace_back(&PacketDecoder::workerLoop, this);
+}
+
+unsigned int PacketDecoder::getThreadCount() const
+{
+    return static_cast<unsigned int>(threads.size());
+}
+
+std::shared_ptr<PacketDecoder::DecodedPacket> PacketDecoder::submit(RakNet::Packet *packet)
+{
+    if (threads.empty() || packet->length < minimumPacketLength || getPacketType(packet->data[0]) == NONE)
+        return nullptr;
+
+    Player *player = Players::getPlayer(packet->guid);
+
+    // Packets from unknown connections are for the master server or still need to be preinitialized
+    if (player == nullptr)
+        return nullptr;
+
+    std::shared_ptr<DecodedPacket> decodedPacket = std::make_shared<DecodedPacket>();
+    decodedPacket->packet = packet;
+    decodedPacket->stringTables = player->shareStringTables();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(decodedPacket);
+    }
+
+    queueCondition.notify_one();
+    return decodedPacket;
+}
+
+void PacketDecoder::wait(DecodedPacket &decodedPacket)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (decodedPacket.state == DecodedPacket::QUEUED)
+    {
+        // Rather than wait for a worker to get to it, decode it right away; the worker that
+        // eventually pops it from the queue will skip it
+        decodedPacket.state = DecodedPacket::DECODING;
+        lock.unlock();
+
+        decode(*mainControllers, decodedPacket);
+
+        lock.lock();
+        decodedPacket.state = DecodedPacket::DECODED;
+        return;
+    }
+
+    decodedCondition.wait(lock, [&decodedPacket] { return decodedPacket.state == DecodedPacket::DECODED; });
+}
+
+void PacketDecoder::applyPlayerData(DecodedPacket &decodedPacket, BasePlayer &player)
+{
+    switch (decodedPacket.packet->data[0])
+    {
+        case ID_PLAYER_INVENTORY:
+            player.inventoryChanges = std::move(decodedPacket.player->inventoryChanges);
+            break;
+        default:
+            break;
+    }
+}
+
+PacketDecoder::PACKET_TYPE PacketDecoder::getPacketType(RakNet::MessageID packetID)
+{
+    // Processors that read packets on their own need them to be read on the main thread
+    if (ObjectProcessor *processor = ObjectProcessor::GetProcessor(packetID))
+        return processor->GetAvoidReading() ? NONE : OBJECT;
+
+    if (ActorProcessor *processor = ActorProcessor::GetProcessor(packetID))
+        return processor->GetAvoidReading() ? NONE : ACTOR;
+
+    // Player packets read straight into the Player, so only the ones that replace a single
+    // list of changes, which applyPlayerData() can then move over, are decoded separately
+    if (packetID == ID_PLAYER_INVENTORY)
+    {
+        PlayerProcessor *processor = PlayerProcessor::GetProcessor(packetID);
+        return processor != nullptr && !processor->GetAvoidReading() ? PLAYER : NONE;
+    }
+
+    return NONE;
+}
+
+void PacketDecoder::decode(Controllers &controllers, DecodedPacket &decodedPacket)
+{
+    RakNet::Packet *packet = decodedPacket.packet;
+    RakNet::MessageID packetID = packet->data[0];
+
+    RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+    switch (getPacketType(packetID))
+    {
+        case OBJECT:
+        {
+            decodedPacket.objectList.reset(new BaseObjectList(packet->guid));
+            decodedPacket.objectList->cell.blank();
+            decodedPacket.objectList->isValid = true;
+
+            ObjectPacket *objectPacket = controllers.object.GetPacket(packetID);
+            objectPacket->SetReadStream(&bsIn);
+            objectPacket->setStringTables(decodedPacket.stringTables.get());
+            objectPacket->setObjectList(decodedPacket.objectList.get());
+            objectPacket->Read();
+            break;
+        }
+        case ACTOR:
+        {
+            decodedPacket.actorList.reset(new BaseActorList());
+            decodedPacket.actorList->guid = packet->guid;
+            decodedPacket.actorList->cell.blank();
+            decodedPacket.actorList->isValid = true;
+
+            ActorPacket *actorPacket = controllers.actor.GetPacket(packetID);
+            actorPacket->SetReadStream(&bsIn);
+            actorPacket->setStringTables(decodedPacket.stringTables.get());
+            actorPacket->setActorList(decodedPacket.actorList.get());
+            actorPacket->Read();
+            break;
+        }
+        case PLAYER:
+        {
+            decodedPacket.player.reset(new BasePlayer(packet->guid));
+
+            PlayerPacket *playerPacket = controllers.player.GetPacket(packetID);
+            playerPacket->SetReadStream(&bsIn);
+            playerPacket->setStringTables(decodedPacket.stringTables.get());
+            playerPacket->setPlayer(decodedPacket.player.get());
+            playerPacket->Read();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void PacketDecoder::stopThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    queueCondition.notify_all();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    threads.clear();
+    queue.clear();
+    isStopping = false;
+}
+
+void PacketDecoder::workerLoop()
+{
+    Controllers controllers(peer);
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        queueCondition.wait(lock, [this] { return isStopping || !queue.empty(); });
+
+        if (isStopping)
+            return;
+
+        std::shared_ptr<DecodedPacket> decodedPacket = std::move(queue.front());
+        queue.pop_front();
+
+        // The main thread may have decoded it already while waiting for it
+        if (decodedPacket->state != DecodedPacket::QUEUED)
+            continue;
+
+        decodedPacket->state = DecodedPacket::DECODING;
+        lock.unlock();
+
+        decode(controllers, *decodedPacket);
+
+        lock.lock();
+        decodedPacket->state = DecodedPacket::DECODED;
+        decodedCondition.notify_all();
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef OPENMW_PACKETDECODER_HPP
+#define OPENMW_PACKETDECODER_HPP
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+#include <components/openmw-mp/Base/BasePlayer.hpp>
+#include <components/openmw-mp/Packets/StringTables.hpp>
+
+#include <RakNetTypes.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RakNet
+{
+    class RakPeerInterface;
+}
+
+namespace mwmp
+{
+    /**
+     * Decodes large incoming object, actor and inventory packets on worker threads.
+     *
+     * The main thread submits packets in the order it receives them, and each submitted packet
+     * is read into lists owned by its own DecodedPacket rather than the ones shared by the
+     * processors. The main thread then takes the results back in that same order, moving them
+     * into the shared lists right before running the packet's processor, so every connection's
+     * packets are still applied and passed to scripts in the order they arrived while later
+     * packets are being decoded.
+     *
+     * Small packets aren't worth handing over to another thread and are read on the main
+     * thread as before, as are packets of every other type.
+     */
+    class PacketDecoder
+    {
+    public:
+        // Packets shorter than this are cheaper to read than to hand over
+        static const unsigned int minimumPacketLength = 512;
+
+        struct DecodedPacket
+        {
+            enum STATE
+            {
+                QUEUED = 0,
+                DECODING,
+                DECODED
+            };
+
+            RakNet::Packet *packet = nullptr;
+            // Shared with the sender, who can be deleted by an earlier packet of the same tick
+            std::shared_ptr<StringTables> stringTables;
+            STATE state = QUEUED;
+
+            // Only the one matching the packet's type is set
+            std::unique_ptr<BaseObjectList> objectList;
+            std::unique_ptr<BaseActorList> actorList;
+            std::unique_ptr<BasePlayer> player;
+        };
+
+        PacketDecoder(RakNet::RakPeerInterface *peer);
+        ~PacketDecoder();
+
+        // Start this many worker threads, with 0 reading every packet on the main thread
+        void setThreadCount(unsigned int threadCount);
+        unsigned int getThreadCount() const;
+
+        /**
+         * Queue a received packet for decoding.
+         *
+         * \return The packet's eventual contents, or nullptr if it should be read on the main
+         *         thread. The RakNet::Packet must stay allocated until wait() has returned.
+         */
+        std::shared_ptr<DecodedPacket> submit(RakNet::Packet *packet);
+
+        // Block until a submitted packet is decoded, decoding it here if no worker has started on it
+        void wait(DecodedPacket &decodedPacket);
+
+        // Move the data read by a decoded player packet into the packet's player
+        static void applyPlayerData(DecodedPacket &decodedPacket, BasePlayer &player);
+
+    private:
+        struct Controllers;
+
+        enum PACKET_TYPE
+        {
+            NONE = 0,
+            OBJECT,
+            ACTOR,
+            PLAYER
+        };
+
+        static PACKET_TYPE getPacketType(RakNet::MessageID packetID);
+        static void decode(Controllers &controllers, DecodedPacket &decodedPacket);
+
+        void stopThreads();
+        void workerLoop();
+
+        RakNet::RakPeerInterface *peer;
+        std::unique_ptr<Controllers> mainControllers;
+
+        std::vector<std::thread> threads;
+        std::deque<std::shared_ptr<DecodedPacket>> queue;
+        std::mutex mutex;
+        std::condition_variable queueCondition;
+        std::condition_variable decodedCondition;
+        bool isStopping;
+    };
+}
+
+#endif //OPENMW_PACKETDECODER_HPP
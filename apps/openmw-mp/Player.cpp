@@ -1,6 +1,10 @@
 #include "Player.hpp"
 #include "Networking.hpp"
 
+#include <cmath>
+
+#include <components/misc/stringops.hpp>
+
 TPlayers Players::players;
 TSlots Players::slots;
 
@@ -12,6 +16,8 @@ void Players::deletePlayer(RakNet::RakNetGUID guid)
     {
         CellController::get()->deletePlayer(players[guid]);
 
+        forgetPositionKeyframes(guid);
+
         LOG_APPEND(TimedLog::LOG_INFO, "- Emptying slot %i", players[guid]->getId());
 
         slots[players[guid]->getId()] = 0;
@@ -46,6 +52,15 @@ void Players::newPlayer(RakNet::RakNetGUID guid)
     }
 }
 
+void Players::forgetPositionKeyframes(RakNet::RakNetGUID subjectGuid)
+{
+    for (auto &player : players)
+    {
+        if (player.second != 0)
+            player.second->forgetPositionKeyframes(subjectGuid);
+    }
+}
+
 Player *Players::getPlayer(RakNet::RakNetGUID guid)
 {
     auto it = players.find(guid);
@@ -68,6 +83,10 @@ Player::Player(RakNet::RakNetGUID guid) : BasePlayer(guid)
 {
     handshakeCounter = 0;
     loadState = NOTLOADED;
+    positionUpdateCount = 0;
+    lastUpdatePosition = ESM::Position();
+    capabilities = 0;
+    stringTables = std::make_shared<mwmp::StringTables>();
 }
 
 Player::~Player()
@@ -140,12 +159,16 @@ void Player::sendToLoaded(mwmp::PlayerPacket *myPacket)
     plList.sort();
     plList.unique();
 
+    std::vector<RakNet::RakNetGUID> recipients;
+
     for (auto pl : plList)
     {
         if (pl == this) continue;
-        myPacket->setPlayer(this);
-        myPacket->Send(pl->guid);
+        recipients.push_back(pl->guid);
     }
+
+    myPacket->setPlayer(this);
+    myPacket->Send(recipients);
 }
 
 void Player::forEachLoaded(std::function<void(Player *pl, Player *other)> func)
@@ -175,3 +198,84 @@ bool Players::doesPlayerExist(RakNet::RakNetGUID guid)
 {
     return players.find(guid) != players.end();
 }
+
+unsigned int Player::incrementPositionUpdateCount()
+{
+    return ++positionUpdateCount;
+}
+
+bool Player::updateEndsMovement()
+{
+    bool hasDirection = false;
+    bool hasMoved = false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        // A NaN turning speed is sent for turning that isn't known, not for turning
+        if ((direction.pos[i] != 0 && !std::isnan(direction.pos[i])) || (direction.rot[i] != 0 && !std::isnan(direction.rot[i])))
+            hasDirection = true;
+
+        if (position.pos[i] != lastUpdatePosition.pos[i])
+            hasMoved = true;
+    }
+
+    lastUpdatePosition = position;
+
+    return !hasDirection || !hasMoved;
+}
+
+float Player::getDistanceSquared(const Player *other) const
+{
+    // Positions in different interiors can't be compared, so treat those players as being close
+    if (!cell.isExterior() || !other->cell.isExterior())
+    {
+        if (cell.isExterior() != other->cell.isExterior() || !Misc::StringUtils::ciEqual(cell.mName, other->cell.mName))
+            return 0;
+    }
+
+    float distanceSquared = 0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        float delta = position.pos[i] - other->position.pos[i];
+        distanceSquared += delta * delta;
+    }
+
+    return distanceSquared;
+}
+
+void Player::setCapabilities(uint32_t capabilities)
+{
+    this->capabilities = capabilities;
+}
+
+bool Player::hasCapability(uint32_t capability) const
+{
+    return (capabilities & capability) != 0;
+}
+
+mwmp::StringTables &Player::getStringTables()
+{
+    return *stringTables;
+}
+
+std::shared_ptr<mwmp::StringTables> Player::shareStringTables() const
+{
+    return stringTables;
+}
+
+bool Player::hasPositionKeyframe(RakNet::RakNetGUID subjectGuid, uint8_t keyframeId) const
+{
+    auto it = positionKeyframesAcked.find(subjectGuid.g);
+    return it != positionKeyframesAcked.end() && it->second == keyframeId;
+}
+
+void Player::setPositionKeyframeAcked(RakNet::RakNetGUID subjectGuid, uint8_t keyframeId)
+{
+    positionKeyframesAcked[subjectGuid.g] = keyframeId;
+}
+
+void Player::forgetPositionKeyframes(RakNet::RakNetGUID subjectGuid)
+{
+    positionKeyframesAcked.erase(subjectGuid.g);
+}
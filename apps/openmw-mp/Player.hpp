@@ -2,8 +2,10 @@
 #define OPENMW_PLAYER_HPP
 
 #include <map>
+#include <memory>
 #include <string>
 #include <chrono>
+#include <unordered_map>
 #include <RakNetTypes.h>
 
 #include <components/esm/npcstats.hpp>
@@ -13,6 +15,7 @@
 
 #include <components/openmw-mp/TimedLog.hpp>
 #include <components/openmw-mp/Base/BasePlayer.hpp>
+#include <components/openmw-mp/Packets/StringTables.hpp>
 #include <components/openmw-mp/Packets/Player/PlayerPacket.hpp>
 #include "Cell.hpp"
 #include "CellController.hpp"
@@ -25,6 +28,8 @@ class Players
 public:
     static void newPlayer(RakNet::RakNetGUID guid);
     static void deletePlayer(RakNet::RakNetGUID guid);
+    // Make every player need a new position keyframe for this one before getting deltas again
+    static void forgetPositionKeyframes(RakNet::RakNetGUID subjectGuid);
     static Player *getPlayer(RakNet::RakNetGUID guid);
     static Player *getPlayer(unsigned short id);
     static TPlayers *getPlayers();
@@ -69,10 +74,35 @@ public:
 
     void forEachLoaded(std::function<void(Player *pl, Player *other)> func);
 
+    unsigned int incrementPositionUpdateCount();
+    // Compare the position update just received with the one before it, returning whether it
+    // leaves the player standing still, either without a direction or where they already were
+    bool updateEndsMovement();
+    float getDistanceSquared(const Player *other) const;
+
+    void setCapabilities(uint32_t capabilities);
+    bool hasCapability(uint32_t capability) const;
+
+    mwmp::StringTables &getStringTables();
+    // The string tables, kept alive for packets still being decoded after the player is deleted
+    std::shared_ptr<mwmp::StringTables> shareStringTables() const;
+
+    // Whether this player has acknowledged receiving the given position keyframe for another
+    // player, so it can be sent deltas against it; acknowledgements only ever hold the subject's
+    // current keyframe, because they are all forgotten whenever a new one starts
+    bool hasPositionKeyframe(RakNet::RakNetGUID subjectGuid, uint8_t keyframeId) const;
+    void setPositionKeyframeAcked(RakNet::RakNetGUID subjectGuid, uint8_t keyframeId);
+    void forgetPositionKeyframes(RakNet::RakNetGUID subjectGuid);
+
 private:
     CellController::TContainer cells;
     int loadState;
     int handshakeCounter;
+    unsigned int positionUpdateCount;
+    ESM::Position lastUpdatePosition;
+    uint32_t capabilities;
+    std::unordered_map<uint64_t, uint8_t> positionKeyframesAcked;
+    std::shared_ptr<mwmp::StringTables> stringTables;
 
 };
 
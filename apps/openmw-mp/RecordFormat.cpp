@@ -0,0 +1,658 @@
+#include "RecordFormat.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace mwmp;
+
+namespace
+{
+    // Numbers are written little-endian with fixed sizes, and strings and lists with their
+    // length in front of them
+    class RecordWriter
+    {
+    public:
+        RecordWriter(std::string &record) : record(record)
+        {
+
+        }
+
+        void writeNumber(uint64_t value, int size)
+        {
+            for (int i = 0; i < size; ++i)
+                record.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+
+        void write(bool value) { writeNumber(value ? 1 : 0, 1); }
+        void write(uint8_t value) { writeNumber(value, 1); }
+        void write(uint16_t value) { writeNumber(value, 2); }
+        void write(int32_t value) { writeNumber(static_cast<uint32_t>(value), 4); }
+        void write(uint32_t value) { writeNumber(static_cast<uint64_t>(value), 4); }
+        void write(uint64_t value) { writeNumber(value, 8); }
+
+        void write(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write(bits);
+        }
+
+        void write(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write(bits);
+        }
+
+        void write(const std::string &value)
+        {
+            write(static_cast<uint32_t>(value.size()));
+            record.append(value);
+        }
+
+        void write(const ESM::Position &position)
+        {
+            for (int i = 0; i < 3; ++i)
+                write(position.pos[i]);
+
+            for (int i = 0; i < 3; ++i)
+                write(position.rot[i]);
+        }
+
+        void write(const ESM::Cell &cell)
+        {
+            write(static_cast<int32_t>(cell.mData.mFlags));
+            write(static_cast<int32_t>(cell.mData.mX));
+            write(static_cast<int32_t>(cell.mData.mY));
+            write(cell.mName);
+            write(cell.mRegion);
+        }
+
+        void write(const ESM::StatState<float> &stat)
+        {
+            write(stat.mBase);
+            write(stat.mMod);
+            write(stat.mCurrent);
+            write(stat.mDamage);
+            write(stat.mProgress);
+        }
+
+        void write(const Target &target)
+        {
+            write(target.isPlayer);
+            write(target.refId);
+            write(static_cast<uint32_t>(target.refNum));
+            write(static_cast<uint32_t>(target.mpNum));
+            write(target.name);
+            write(static_cast<uint64_t>(target.guid.g));
+        }
+
+    private:
+        std::string &record;
+    };
+
+    // Reading past the end of a record leaves every value read from then on zeroed and the
+    // reader invalid, so a record only has to be checked once it has been read completely
+    class RecordReader
+    {
+    public:
+        RecordReader(const std::string &record, std::size_t offset) : record(record), offset(offset), isValid(true)
+        {
+
+        }
+
+        bool isGood() const
+        {
+            return isValid;
+        }
+
+        bool isAtEnd() const
+        {
+            return isValid && offset == record.size();
+        }
+
+        uint64_t readNumber(int size)
+        {
+            if (!isValid || record.size() - offset < static_cast<std::size_t>(size))
+            {
+                isValid = false;
+                return 0;
+            }
+
+            uint64_t value = 0;
+
+            for (int i = 0; i < size; ++i)
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(record[offset + i])) << (i * 8);
+
+            offset += size;
+            return value;
+        }
+
+        void read(bool &value) { value = readNumber(1) != 0; }
+        void read(uint8_t &value) { value = static_cast<uint8_t>(readNumber(1)); }
+        void read(uint16_t &value) { value = static_cast<uint16_t>(readNumber(2)); }
+        void read(int32_t &value) { value = static_cast<int32_t>(static_cast<uint32_t>(readNumber(4))); }
+        void read(uint32_t &value) { value = static_cast<uint32_t>(readNumber(4)); }
+        void read(uint64_t &value) { value = readNumber(8); }
+
+        void read(float &value)
+        {
+            uint32_t bits = static_cast<uint32_t>(readNumber(4));
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+
+        void read(double &value)
+        {
+            uint64_t bits = readNumber(8);
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+
+        void read(std::string &value)
+        {
+            uint32_t size = readCount();
+            value.assign(isValid ? record.substr(offset, size) : std::string());
+            offset += size;
+        }
+
+        // Read the length of a string or list, which can't be longer than what's left of the record,
+        // so lists are read an element at a time instead of being sized by it up front
+        uint32_t readCount()
+        {
+            uint32_t count;
+            read(count);
+
+            if (count > record.size() - offset)
+            {
+                isValid = false;
+                return 0;
+            }
+
+            return count;
+        }
+
+        template<typename T, typename Stored>
+        void readAs(T &value)
+        {
+            Stored stored;
+            read(stored);
+            value = static_cast<T>(stored);
+        }
+
+        void read(ESM::Position &position)
+        {
+            for (int i = 0; i < 3; ++i)
+                read(position.pos[i]);
+
+            for (int i = 0; i < 3; ++i)
+                read(position.rot[i]);
+        }
+
+        void read(ESM::Cell &cell)
+        {
+            readAs<int, int32_t>(cell.mData.mFlags);
+            readAs<int, int32_t>(cell.mData.mX);
+            readAs<int, int32_t>(cell.mData.mY);
+            read(cell.mName);
+            read(cell.mRegion);
+        }
+
+        void read(ESM::StatState<float> &stat)
+        {
+            read(stat.mBase);
+            read(stat.mMod);
+            read(stat.mCurrent);
+            read(stat.mDamage);
+            read(stat.mProgress);
+        }
+
+        void read(Target &target)
+        {
+            read(target.isPlayer);
+            read(target.refId);
+            readAs<unsigned int, uint32_t>(target.refNum);
+            readAs<unsigned int, uint32_t>(target.mpNum);
+            read(target.name);
+            readAs<uint64_t, uint64_t>(target.guid.g);
+        }
+
+    private:
+        const std::string &record;
+        std::size_t offset;
+        bool isValid;
+    };
+
+    // Check the version a record was written with, which can't be newer than this server's
+    bool readVersion(RecordReader &reader)
+    {
+        uint16_t recordVersion;
+        reader.read(recordVersion);
+
+        return recordVersion != 0 && recordVersion <= RecordFormat::version;
+    }
+
+    template<typename T, typename ReadElement>
+    void readList(RecordReader &reader, std::vector<T> &list, ReadElement readElement)
+    {
+        list.clear();
+        uint32_t count = reader.readCount();
+
+        for (uint32_t i = 0; i < count && reader.isGood(); ++i)
+        {
+            list.emplace_back();
+            readElement(list.back());
+        }
+    }
+
+    void writeItem(RecordWriter &writer, const Item &item)
+    {
+        writer.write(item.refId);
+        writer.write(static_cast<int32_t>(item.count));
+        writer.write(static_cast<int32_t>(item.charge));
+        writer.write(item.enchantmentCharge);
+        writer.write(item.soul);
+    }
+
+    void readItem(RecordReader &reader, Item &item)
+    {
+        reader.read(item.refId);
+        reader.readAs<int, int32_t>(item.count);
+        reader.readAs<int, int32_t>(item.charge);
+        reader.read(item.enchantmentCharge);
+        reader.read(item.soul);
+    }
+
+    void writeObject(RecordWriter &writer, const BaseObject &object)
+    {
+        writer.write(object.refId);
+        writer.write(static_cast<uint32_t>(object.refNum));
+        writer.write(static_cast<uint32_t>(object.mpNum));
+        writer.write(static_cast<int32_t>(object.count));
+        writer.write(static_cast<int32_t>(object.charge));
+        writer.write(object.enchantmentCharge);
+        writer.write(object.soul);
+        writer.write(static_cast<int32_t>(object.goldValue));
+        writer.write(object.position);
+
+        writer.write(object.objectState);
+        writer.write(static_cast<int32_t>(object.lockLevel));
+        writer.write(object.scale);
+
+        writer.write(static_cast<uint8_t>(object.dialogueChoiceType));
+        writer.write(object.topicId);
+        writer.write(static_cast<int32_t>(object.guiId));
+
+        writer.write(object.soundId);
+        writer.write(object.volume);
+        writer.write(object.pitch);
+
+        writer.write(static_cast<uint32_t>(object.goldPool));
+        writer.write(object.lastGoldRestockHour);
+        writer.write(static_cast<int32_t>(object.lastGoldRestockDay));
+
+        writer.write(static_cast<int32_t>(object.doorState));
+        writer.write(object.teleportState);
+        writer.write(object.destinationCell);
+        writer.write(object.destinationPosition);
+
+        writer.write(object.musicFilename);
+        writer.write(object.videoFilename);
+        writer.write(object.allowSkipping);
+
+        writer.write(object.animGroup);
+        writer.write(static_cast<int32_t>(object.animMode));
+
+        writer.write(object.isDisarmed);
+        writer.write(object.droppedByPlayer);
+
+        writer.write(object.activatingActor);
+        writer.write(object.hittingActor);
+        writer.write(object.hitAttack.success);
+        writer.write(object.hitAttack.block);
+        writer.write(object.hitAttack.damage);
+        writer.write(object.hitAttack.knockdown);
+
+        writer.write(object.isSummon);
+        writer.write(static_cast<int32_t>(object.summonEffectId));
+        writer.write(object.summonSpellId);
+        writer.write(object.summonDuration);
+        writer.write(object.master);
+
+        writer.write(object.hasContainer);
+
+        writer.write(static_cast<uint32_t>(object.clientLocals.size()));
+
+        for (const ClientVariable &clientLocal : object.clientLocals)
+        {
+            writer.write(clientLocal.id);
+            writer.write(static_cast<int32_t>(clientLocal.internalIndex));
+            writer.write(static_cast<uint8_t>(clientLocal.variableType));
+            writer.write(static_cast<int32_t>(clientLocal.intValue));
+            writer.write(clientLocal.floatValue);
+            writer.write(clientLocal.stringValue);
+        }
+
+        writer.write(static_cast<uint32_t>(object.containerItems.size()));
+
+        for (const ContainerItem &containerItem : object.containerItems)
+        {
+            writer.write(containerItem.refId);
+            writer.write(static_cast<int32_t>(containerItem.count));
+            writer.write(static_cast<int32_t>(containerItem.charge));
+            writer.write(containerItem.enchantmentCharge);
+            writer.write(containerItem.soul);
+            writer.write(static_cast<int32_t>(containerItem.actionCount));
+        }
+
+        writer.write(static_cast<uint64_t>(object.guid.g));
+        writer.write(object.isPlayer);
+    }
+
+    void readObject(RecordReader &reader, BaseObject &object)
+    {
+        reader.read(object.refId);
+        reader.readAs<unsigned int, uint32_t>(object.refNum);
+        reader.readAs<unsigned int, uint32_t>(object.mpNum);
+        reader.readAs<int, int32_t>(object.count);
+        reader.readAs<int, int32_t>(object.charge);
+        reader.read(object.enchantmentCharge);
+        reader.read(object.soul);
+        reader.readAs<int, int32_t>(object.goldValue);
+        reader.read(object.position);
+
+        reader.read(object.objectState);
+        reader.readAs<int, int32_t>(object.lockLevel);
+        reader.read(object.scale);
+
+        reader.readAs<unsigned char, uint8_t>(object.dialogueChoiceType);
+        reader.read(object.topicId);
+        reader.readAs<int, int32_t>(object.guiId);
+
+        reader.read(object.soundId);
+        reader.read(object.volume);
+        reader.read(object.pitch);
+
+        reader.readAs<unsigned int, uint32_t>(object.goldPool);
+        reader.read(object.lastGoldRestockHour);
+        reader.readAs<int, int32_t>(object.lastGoldRestockDay);
+
+        reader.readAs<int, int32_t>(object.doorState);
+        reader.read(object.teleportState);
+        reader.read(object.destinationCell);
+        reader.read(object.destinationPosition);
+
+        reader.read(object.musicFilename);
+        reader.read(object.videoFilename);
+        reader.read(object.allowSkipping);
+
+        reader.read(object.animGroup);
+        reader.readAs<int, int32_t>(object.animMode);
+
+        reader.read(object.isDisarmed);
+        reader.read(object.droppedByPlayer);
+
+        reader.read(object.activatingActor);
+        reader.read(object.hittingActor);
+        reader.read(object.hitAttack.success);
+        reader.read(object.hitAttack.block);
+        reader.read(object.hitAttack.damage);
+        reader.read(object.hitAttack.knockdown);
+
+        reader.read(object.isSummon);
+        reader.readAs<int, int32_t>(object.summonEffectId);
+        reader.read(object.summonSpellId);
+        reader.read(object.summonDuration);
+        reader.read(object.master);
+
+        reader.read(object.hasContainer);
+
+        readList(reader, object.clientLocals, [&reader](ClientVariable &clientLocal)
+        {
+            reader.read(clientLocal.id);
+            reader.readAs<int, int32_t>(clientLocal.internalIndex);
+            reader.readAs<char, uint8_t>(clientLocal.variableType);
+            reader.readAs<int, int32_t>(clientLocal.intValue);
+            reader.read(clientLocal.floatValue);
+            reader.read(clientLocal.stringValue);
+        });
+
+        readList(reader, object.containerItems, [&reader](ContainerItem &containerItem)
+        {
+            reader.read(containerItem.refId);
+            reader.readAs<int, int32_t>(containerItem.count);
+            reader.readAs<int, int32_t>(containerItem.charge);
+            reader.read(containerItem.enchantmentCharge);
+            reader.read(containerItem.soul);
+            reader.readAs<int, int32_t>(containerItem.actionCount);
+        });
+
+        object.containerItemCount = static_cast<unsigned int>(object.containerItems.size());
+
+        reader.readAs<uint64_t, uint64_t>(object.guid.g);
+        reader.read(object.isPlayer);
+    }
+}
+
+void RecordFormat::writePlayer(std::string &record, const BasePlayer &player)
+{
+    RecordWriter writer(record);
+    writer.write(version);
+
+    writer.write(player.npc.mName);
+    writer.write(player.npc.mModel);
+    writer.write(player.npc.mRace);
+    writer.write(player.npc.mHair);
+    writer.write(player.npc.mHead);
+    writer.write(static_cast<uint8_t>(player.npc.mFlags));
+    writer.write(player.birthsign);
+
+    writer.write(player.charClass.mId);
+    writer.write(player.charClass.mName);
+    writer.write(player.charClass.mDescription);
+
+    const ESM::Class::CLDTstruct &classData = player.charClass.mData;
+
+    for (int attribute : classData.mAttribute)
+        writer.write(static_cast<int32_t>(attribute));
+
+    writer.write(static_cast<int32_t>(classData.mSpecialization));
+
+    for (const auto &skills : classData.mSkills)
+    {
+        writer.write(static_cast<int32_t>(skills[0]));
+        writer.write(static_cast<int32_t>(skills[1]));
+    }
+
+    writer.write(static_cast<int32_t>(classData.mIsPlayable));
+    writer.write(static_cast<int32_t>(classData.mCalc));
+
+    writer.write(player.scale);
+    writer.write(player.isWerewolf);
+    writer.write(player.displayCreatureName);
+    writer.write(player.creatureRefId);
+
+    for (const auto &dynamicStat : player.creatureStats.mDynamic)
+        writer.write(dynamicStat);
+
+    for (const auto &attribute : player.creatureStats.mAttributes)
+        writer.write(attribute);
+
+    for (int skillIncrease : player.npcStats.mSkillIncrease)
+        writer.write(static_cast<int32_t>(skillIncrease));
+
+    for (const auto &skill : player.npcStats.mSkills)
+        writer.write(skill);
+
+    writer.write(static_cast<int32_t>(player.creatureStats.mLevel));
+    writer.write(static_cast<int32_t>(player.npcStats.mLevelProgress));
+    writer.write(static_cast<int32_t>(player.npcStats.mBounty));
+    writer.write(static_cast<int32_t>(player.npcStats.mReputation));
+
+    for (const Item &equipmentItem : player.equipmentItems)
+        writeItem(writer, equipmentItem);
+
+    writer.write(player.cell);
+    writer.write(player.position);
+    writer.write(player.previousCellPosition);
+
+    writer.write(static_cast<int32_t>(player.inventoryChanges.action));
+    writer.write(static_cast<uint32_t>(player.inventoryChanges.items.size()));
+
+    for (const Item &item : player.inventoryChanges.items)
+        writeItem(writer, item);
+
+    writer.write(static_cast<int32_t>(player.spellbookChanges.action));
+    writer.write(static_cast<uint32_t>(player.spellbookChanges.spells.size()));
+
+    for (const ESM::Spell &spell : player.spellbookChanges.spells)
+        writer.write(spell.mId);
+
+    writer.write(static_cast<uint32_t>(player.quickKeyChanges.size()));
+
+    for (const QuickKey &quickKey : player.quickKeyChanges)
+    {
+        writer.write(static_cast<int32_t>(quickKey.type));
+        writer.write(static_cast<uint16_t>(quickKey.slot));
+        writer.write(quickKey.itemId);
+    }
+}
+
+bool RecordFormat::readPlayer(const std::string &record, std::size_t offset, BasePlayer &player)
+{
+    RecordReader reader(record, offset);
+
+    if (!readVersion(reader))
+        return false;
+
+    reader.read(player.npc.mName);
+    reader.read(player.npc.mModel);
+    reader.read(player.npc.mRace);
+    reader.read(player.npc.mHair);
+    reader.read(player.npc.mHead);
+    reader.readAs<unsigned char, uint8_t>(player.npc.mFlags);
+    reader.read(player.birthsign);
+
+    reader.read(player.charClass.mId);
+    reader.read(player.charClass.mName);
+    reader.read(player.charClass.mDescription);
+
+    ESM::Class::CLDTstruct &classData = player.charClass.mData;
+
+    for (int &attribute : classData.mAttribute)
+        reader.readAs<int, int32_t>(attribute);
+
+    reader.readAs<int, int32_t>(classData.mSpecialization);
+
+    for (auto &skills : classData.mSkills)
+    {
+        reader.readAs<int, int32_t>(skills[0]);
+        reader.readAs<int, int32_t>(skills[1]);
+    }
+
+    reader.readAs<int, int32_t>(classData.mIsPlayable);
+    reader.readAs<int, int32_t>(classData.mCalc);
+
+    reader.read(player.scale);
+    reader.read(player.isWerewolf);
+    reader.read(player.displayCreatureName);
+    reader.read(player.creatureRefId);
+
+    for (auto &dynamicStat : player.creatureStats.mDynamic)
+        reader.read(dynamicStat);
+
+    for (auto &attribute : player.creatureStats.mAttributes)
+        reader.read(attribute);
+
+    for (int &skillIncrease : player.npcStats.mSkillIncrease)
+        reader.readAs<int, int32_t>(skillIncrease);
+
+    for (auto &skill : player.npcStats.mSkills)
+        reader.read(skill);
+
+    reader.readAs<int, int32_t>(player.creatureStats.mLevel);
+    reader.readAs<int, int32_t>(player.npcStats.mLevelProgress);
+    reader.readAs<int, int32_t>(player.npcStats.mBounty);
+    reader.readAs<int, int32_t>(player.npcStats.mReputation);
+
+    for (Item &equipmentItem : player.equipmentItems)
+        readItem(reader, equipmentItem);
+
+    reader.read(player.cell);
+    reader.read(player.position);
+    reader.read(player.previousCellPosition);
+
+    reader.readAs<int, int32_t>(player.inventoryChanges.action);
+    readList(reader, player.inventoryChanges.items, [&reader](Item &item)
+    {
+        readItem(reader, item);
+    });
+
+    reader.readAs<int, int32_t>(player.spellbookChanges.action);
+    readList(reader, player.spellbookChanges.spells, [&reader](ESM::Spell &spell)
+    {
+        reader.read(spell.mId);
+    });
+
+    readList(reader, player.quickKeyChanges, [&reader](QuickKey &quickKey)
+    {
+        reader.readAs<int, int32_t>(quickKey.type);
+        reader.readAs<unsigned short, uint16_t>(quickKey.slot);
+        reader.read(quickKey.itemId);
+    });
+
+    return reader.isAtEnd();
+}
+
+void RecordFormat::writeObjectList(std::string &record, const BaseObjectList &objectList, uint16_t packetID)
+{
+    RecordWriter writer(record);
+    writer.write(version);
+    writer.write(packetID);
+
+    writer.write(objectList.cell);
+    writer.write(static_cast<uint8_t>(objectList.packetOrigin));
+    writer.write(objectList.originClientScript);
+    writer.write(static_cast<uint8_t>(objectList.action));
+    writer.write(static_cast<uint8_t>(objectList.containerSubAction));
+    writer.write(objectList.consoleCommand);
+
+    writer.write(static_cast<uint32_t>(objectList.baseObjects.size()));
+
+    for (const BaseObject &object : objectList.baseObjects)
+        writeObject(writer, object);
+}
+
+bool RecordFormat::readObjectList(const std::string &record, std::size_t offset, BaseObjectList &objectList,
+    uint16_t &packetID)
+{
+    RecordReader reader(record, offset);
+
+    if (!readVersion(reader))
+        return false;
+
+    reader.read(packetID);
+
+    reader.read(objectList.cell);
+    reader.readAs<unsigned char, uint8_t>(objectList.packetOrigin);
+    reader.read(objectList.originClientScript);
+    reader.readAs<unsigned char, uint8_t>(objectList.action);
+    reader.readAs<unsigned char, uint8_t>(objectList.containerSubAction);
+    reader.read(objectList.consoleCommand);
+
+    readList(reader, objectList.baseObjects, [&reader](BaseObject &object)
+    {
+        readObject(reader, object);
+    });
+
+    objectList.baseObjectCount = static_cast<unsigned int>(objectList.baseObjects.size());
+
+    return reader.isAtEnd();
+}
+
+uint16_t RecordFormat::getVersion(const std::string &record, std::size_t offset)
+{
+    RecordReader reader(record, offset);
+
+    uint16_t recordVersion;
+    reader.read(recordVersion);
+    return recordVersion;
+}
@@ -0,0 +1,39 @@
+#ifndef OPENMW_RECORDFORMAT_HPP
+#define OPENMW_RECORDFORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <components/openmw-mp/Base/BaseObject.hpp>
+#include <components/openmw-mp/Base/BasePlayer.hpp>
+
+namespace mwmp
+{
+    /**
+     * The way players and object lists are saved in a RecordStore, written field by field instead
+     * of as packets, so that records outlive changes to the protocol.
+     *
+     * Every one of them starts with the version of this format it was written with. Anything
+     * that changes what gets saved needs a new version, and reading the older ones has to keep
+     * working.
+     */
+    namespace RecordFormat
+    {
+        const uint16_t version = 1;
+
+        void writePlayer(std::string &record, const BasePlayer &player);
+        // Read a player starting at offset, returning whether the rest of the record held one
+        bool readPlayer(const std::string &record, std::size_t offset, BasePlayer &player);
+
+        void writeObjectList(std::string &record, const BaseObjectList &objectList, uint16_t packetID);
+        // Read an object list starting at offset, returning whether the rest of the record held one
+        bool readObjectList(const std::string &record, std::size_t offset, BaseObjectList &objectList,
+            uint16_t &packetID);
+
+        // Get the version a record starting at offset was written with, or 0 if it has none
+        uint16_t getVersion(const std::string &record, std::size_t offset);
+    }
+}
+
+#endif //OPENMW_RECORDFORMAT_HPP
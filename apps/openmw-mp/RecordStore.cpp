@@ -0,0 +1,578 @@
+#include "RecordStore.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace mwmp;
+
+namespace
+{
+    const char fileMagic[4] = {'T', 'M', 'R', 'S'};
+    const uint32_t fileVersion = 1;
+    const std::size_t headerSize = sizeof(fileMagic) + sizeof(uint32_t);
+
+    // Stands in for the value size of records that erase their key
+    const uint32_t erasedValueSize = 0xFFFFFFFF;
+
+    void writeUInt32(std::string &out, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    uint32_t readUInt32(const char *data)
+    {
+        uint32_t value = 0;
+
+        for (int i = 0; i < 4; ++i)
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << (i * 8);
+
+        return value;
+    }
+
+    // FNV-1a, which is plenty to tell a record cut short or overwritten with garbage
+    uint32_t getChecksum(const char *data, std::size_t size)
+    {
+        uint32_t hash = 2166136261u;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    std::string getHeader()
+    {
+        std::string header(fileMagic, sizeof(fileMagic));
+        writeUInt32(header, fileVersion);
+        return header;
+    }
+
+    // Get the size of the complete record at an offset, or 0 if there isn't one there
+    std::size_t getValidRecordSize(const std::string &contents, std::size_t offset)
+    {
+        if (contents.size() - offset < 3 * sizeof(uint32_t))
+            return 0;
+
+        const char *data = contents.data() + offset;
+        const uint32_t keySize = readUInt32(data);
+        const uint32_t valueSize = readUInt32(data + 4);
+        const std::size_t dataSize = keySize + static_cast<std::size_t>(valueSize == erasedValueSize ? 0 : valueSize);
+
+        if (contents.size() - offset - 3 * sizeof(uint32_t) < dataSize)
+            return 0;
+
+        const std::size_t checkedSize = 2 * sizeof(uint32_t) + dataSize;
+
+        if (readUInt32(data + checkedSize) != getChecksum(data, checkedSize))
+            return 0;
+
+        return checkedSize + sizeof(uint32_t);
+    }
+
+    // Make sure what has been written to a file is on the disk
+    bool syncFile(std::FILE *file)
+    {
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Make sure a file renamed into a directory stays there, which only needs doing on POSIX
+    bool syncDirectory(const boost::filesystem::path &directory)
+    {
+#ifdef _WIN32
+        return true;
+#else
+        const int descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+
+        if (descriptor == -1)
+            return false;
+
+        const bool isSynced = fsync(descriptor) == 0;
+        ::close(descriptor);
+        return isSynced;
+#endif
+    }
+}
+
+const std::chrono::milliseconds RecordStore::flushInterval(500);
+
+RecordStore::RecordStore() : file(nullptr), liveSize(0), logSize(0), pendingSize(0), changeCount(0), writtenChangeCount(0),
+    isStopping(false), isFlushRequested(false), isCompactionRequested(false)
+{
+
+}
+
+RecordStore::~RecordStore()
+{
+    close();
+}
+
+bool RecordStore::open(const std::string &newPath)
+{
+    close();
+
+    path = newPath;
+    error.clear();
+
+    if (!load())
+    {
+        if (file != nullptr)
+        {
+            std::fclose(file);
+            file = nullptr;
+        }
+
+        records.clear();
+        path.clear();
+        return false;
+    }
+
+    worker = std::thread(&RecordStore::workerLoop, this);
+    return true;
+}
+
+bool RecordStore::close()
+{
+    if (!worker.joinable())
+        return error.empty();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    workCondition.notify_one();
+    worker.join();
+
+    if (file != nullptr)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    records.clear();
+    pending.clear();
+    pendingSize = 0;
+    path.clear();
+    liveSize = 0;
+    logSize = 0;
+    isStopping = false;
+    isFlushRequested = false;
+    isCompactionRequested = false;
+
+    return error.empty();
+}
+
+bool RecordStore::isOpen() const
+{
+    return worker.joinable();
+}
+
+const std::string &RecordStore::getPath() const
+{
+    return path;
+}
+
+bool RecordStore::has(const std::string &key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return records.find(key) != records.end();
+}
+
+std::shared_ptr<const std::string> RecordStore::get(const std::string &key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = records.find(key);
+    return it != records.end() ? it->second : nullptr;
+}
+
+void RecordStore::set(const std::string &key, std::string value)
+{
+    if (!isOpen())
+        return;
+
+    auto newValue = std::make_shared<const std::string>(std::move(value));
+    bool isPendingFull;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &record = records[key];
+
+        if (record)
+            liveSize -= getRecordSize(key, record.get());
+
+        record = newValue;
+        liveSize += getRecordSize(key, newValue.get());
+
+        append(key, newValue);
+        isPendingFull = pendingSize >= maxPendingSize;
+    }
+
+    if (isPendingFull)
+        workCondition.notify_one();
+}
+
+void RecordStore::erase(const std::string &key)
+{
+    if (!isOpen())
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = records.find(key);
+
+    if (it == records.end())
+        return;
+
+    liveSize -= getRecordSize(key, it->second.get());
+    records.erase(it);
+
+    append(key, nullptr);
+}
+
+std::size_t RecordStore::getRecordCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return records.size();
+}
+
+std::size_t RecordStore::getLogSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return logSize;
+}
+
+bool RecordStore::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (!worker.joinable())
+        return false;
+
+    const uint64_t flushedChangeCount = changeCount;
+    isFlushRequested = true;
+    workCondition.notify_one();
+
+    writtenCondition.wait(lock, [this, flushedChangeCount] { return writtenChangeCount >= flushedChangeCount; });
+    return error.empty();
+}
+
+void RecordStore::compact()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isCompactionRequested = true;
+    }
+
+    workCondition.notify_one();
+}
+
+std::string RecordStore::getError() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+void RecordStore::append(const std::string &key, const std::shared_ptr<const std::string> &value)
+{
+    pending.emplace_back(key, value);
+
+    const std::size_t size = getRecordSize(key, value.get());
+    pendingSize += size;
+    logSize += size;
+    ++changeCount;
+}
+
+bool RecordStore::load()
+{
+    std::string contents;
+
+    {
+        std::ifstream stream(path, std::ios::binary);
+
+        if (stream)
+            contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    records.clear();
+
+    if (contents.empty())
+    {
+        file = std::fopen(path.c_str(), "wb");
+        const std::string header = getHeader();
+
+        if (file == nullptr || std::fwrite(header.data(), 1, header.size(), file) != header.size() ||
+            std::fflush(file) != 0)
+        {
+            error = "Could not create " + path;
+            return false;
+        }
+
+        liveSize = logSize = headerSize;
+        return true;
+    }
+
+    // Refuse to touch anything that isn't a store of ours
+    if (contents.size() < headerSize || contents.compare(0, headerSize, getHeader()) != 0)
+    {
+        error = path + " is not a record store";
+        return false;
+    }
+
+    std::size_t offset = headerSize;
+    liveSize = headerSize;
+
+    while (const std::size_t recordSize = getValidRecordSize(contents, offset))
+    {
+        const char *data = contents.data() + offset;
+        const uint32_t keySize = readUInt32(data);
+        const uint32_t valueSize = readUInt32(data + 4);
+
+        std::string key(data + 8, keySize);
+        auto it = records.find(key);
+
+        if (it != records.end())
+        {
+            liveSize -= getRecordSize(key, it->second.get());
+            records.erase(it);
+        }
+
+        if (valueSize != erasedValueSize)
+        {
+            auto value = std::make_shared<const std::string>(data + 8 + keySize, valueSize);
+            liveSize += getRecordSize(key, value.get());
+            records.emplace(std::move(key), std::move(value));
+        }
+
+        offset += recordSize;
+    }
+
+    if (offset < contents.size())
+    {
+        // Records are only ever appended, so a crash can only leave the last one incomplete. Any
+        // complete record after the one that can't be read means the file was damaged some other
+        // way, and is left alone for someone to look at instead of losing what follows
+        for (std::size_t nextOffset = offset + 1; nextOffset < contents.size(); ++nextOffset)
+        {
+            if (getValidRecordSize(contents, nextOffset) != 0)
+            {
+                records.clear();
+                error = path + " is damaged at byte " + std::to_string(offset) + " and was left as it is";
+                return false;
+            }
+        }
+
+        // Drop whatever was left of the record being written when the server went down, so new
+        // ones don't end up after it
+        boost::system::error_code errorCode;
+        boost::filesystem::resize_file(path, offset, errorCode);
+
+        if (errorCode)
+        {
+            error = "Could not truncate " + path + ": " + errorCode.message();
+            return false;
+        }
+    }
+
+    logSize = offset;
+    file = std::fopen(path.c_str(), "ab");
+
+    if (file == nullptr)
+    {
+        error = "Could not open " + path;
+        return false;
+    }
+
+    return true;
+}
+
+bool RecordStore::needsCompaction() const
+{
+    return logSize >= minCompactionSize && logSize > 2 * liveSize;
+}
+
+void RecordStore::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        workCondition.wait_for(lock, flushInterval, [this] {
+            return isStopping || isFlushRequested || isCompactionRequested || pendingSize >= maxPendingSize;
+        });
+
+        if (isCompactionRequested || needsCompaction())
+            rewrite(lock);
+        else if (!pending.empty())
+            writePending(lock);
+
+        // Changes made while writing are picked up right away if someone is waiting for them
+        if (pending.empty())
+            isFlushRequested = false;
+
+        writtenCondition.notify_all();
+
+        if (isStopping && pending.empty())
+            return;
+    }
+}
+
+void RecordStore::writePending(std::unique_lock<std::mutex> &lock)
+{
+    std::vector<Change> writing;
+    writing.swap(pending);
+    pendingSize = 0;
+    const uint64_t writingChangeCount = changeCount;
+
+    lock.unlock();
+
+    const bool isWritten = writeChanges(writing);
+
+    lock.lock();
+
+    if (!isWritten)
+        error = "Could not write to " + path;
+
+    writtenChangeCount = writingChangeCount;
+}
+
+void RecordStore::rewrite(std::unique_lock<std::mutex> &lock)
+{
+    isCompactionRequested = false;
+
+    // The snapshot already holds every pending change, so those only need writing if it fails
+    Records snapshot = records;
+    std::vector<Change> writing;
+    writing.swap(pending);
+    pendingSize = 0;
+    const uint64_t writingChangeCount = changeCount;
+
+    lock.unlock();
+
+    const std::string temporaryPath = path + ".tmp";
+    std::string buffer = getHeader();
+    std::size_t rewrittenSize = 0;
+    bool isRewritten = false;
+
+    if (std::FILE *temporaryFile = std::fopen(temporaryPath.c_str(), "wb"))
+    {
+        bool isWritten = true;
+
+        for (const auto &record : snapshot)
+        {
+            encodeRecord(buffer, record.first, record.second.get());
+
+            if (buffer.size() >= maxPendingSize)
+            {
+                isWritten = isWritten && std::fwrite(buffer.data(), 1, buffer.size(), temporaryFile) == buffer.size();
+                rewrittenSize += buffer.size();
+                buffer.clear();
+            }
+        }
+
+        isWritten = isWritten && std::fwrite(buffer.data(), 1, buffer.size(), temporaryFile) == buffer.size();
+        rewrittenSize += buffer.size();
+        // The new file has to be on the disk before it replaces the old one, or a crash could
+        // leave neither
+        isWritten = std::fflush(temporaryFile) == 0 && isWritten;
+        isWritten = isWritten && syncFile(temporaryFile);
+        isWritten = std::fclose(temporaryFile) == 0 && isWritten;
+
+        if (isWritten)
+        {
+            if (file != nullptr)
+            {
+                std::fclose(file);
+                file = nullptr;
+            }
+
+            boost::system::error_code errorCode;
+            boost::filesystem::rename(temporaryPath, path, errorCode);
+            isRewritten = !errorCode;
+
+            // Until the directory is synced the rename itself can still be lost
+            if (isRewritten)
+                syncDirectory(boost::filesystem::absolute(path).parent_path());
+
+            file = std::fopen(path.c_str(), "ab");
+        }
+    }
+
+    // Fall back to appending to the log as it was
+    bool isWritten = isRewritten;
+
+    if (!isRewritten)
+    {
+        boost::system::error_code errorCode;
+        boost::filesystem::remove(temporaryPath, errorCode);
+
+        isWritten = writeChanges(writing);
+    }
+
+    lock.lock();
+
+    if (isRewritten)
+        logSize = rewrittenSize + pendingSize;
+
+    if (!isWritten || file == nullptr)
+        error = "Could not write to " + path;
+
+    writtenChangeCount = writingChangeCount;
+}
+
+bool RecordStore::writeChanges(const std::vector<Change> &changes)
+{
+    if (file == nullptr)
+        return false;
+
+    std::string buffer;
+    bool isWritten = true;
+
+    for (const Change &change : changes)
+    {
+        encodeRecord(buffer, change.first, change.second.get());
+
+        if (buffer.size() >= maxPendingSize)
+        {
+            isWritten = isWritten && std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+    }
+
+    isWritten = isWritten && std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    return std::fflush(file) == 0 && isWritten;
+}
+
+std::size_t RecordStore::getRecordSize(const std::string &key, const std::string *value)
+{
+    return 3 * sizeof(uint32_t) + key.size() + (value != nullptr ? value->size() : 0);
+}
+
+void RecordStore::encodeRecord(std::string &out, const std::string &key, const std::string *value)
+{
+    const std::size_t start = out.size();
+
+    writeUInt32(out, static_cast<uint32_t>(key.size()));
+    writeUInt32(out, value != nullptr ? static_cast<uint32_t>(value->size()) : erasedValueSize);
+    out.append(key);
+
+    if (value != nullptr)
+        out.append(*value);
+
+    writeUInt32(out, getChecksum(out.data() + start, out.size() - start));
+}
@@ -0,0 +1,115 @@
+#ifndef OPENMW_RECORDSTORE_HPP
+#define OPENMW_RECORDSTORE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mwmp
+{
+    /**
+     * A key-value store kept in a single file, for server scripts to persist the world in
+     * without stalling the main loop on disk writes.
+     *
+     * Every record is held in memory, so reading one never touches the disk. Changes are applied
+     * to memory right away and appended to the file as a log by a worker thread, at most
+     * flushInterval later. Once most of the log has been superseded, the worker rewrites the file
+     * with only the live records and swaps it in.
+     *
+     * A log cut short by a crash is loaded up to its last complete record, while one that is
+     * damaged anywhere else is refused and left untouched.
+     */
+    class RecordStore
+    {
+    public:
+        static const std::chrono::milliseconds flushInterval;
+        // Write right away instead of waiting for flushInterval once this many bytes are pending
+        static const std::size_t maxPendingSize = 4 * 1024 * 1024;
+        // Logs smaller than this are never compacted
+        static const std::size_t minCompactionSize = 1024 * 1024;
+
+        RecordStore();
+        ~RecordStore();
+
+        RecordStore(const RecordStore &) = delete;
+        RecordStore &operator=(const RecordStore &) = delete;
+
+        // Load the records in a file, creating it if it doesn't exist, after closing any open one
+        bool open(const std::string &path);
+        // Write every change made so far and stop the worker thread
+        bool close();
+        bool isOpen() const;
+        const std::string &getPath() const;
+
+        bool has(const std::string &key) const;
+        // Get a record's value, or nullptr if there is no such record
+        std::shared_ptr<const std::string> get(const std::string &key) const;
+        void set(const std::string &key, std::string value);
+        void erase(const std::string &key);
+
+        std::size_t getRecordCount() const;
+        // The size of the file once everything pending is written
+        std::size_t getLogSize() const;
+
+        // Wait until every change made so far is written, returning false if writing failed
+        bool flush();
+        // Have the worker thread rewrite the file with only the live records
+        void compact();
+
+        // The reason the last write failed, or an empty string if none has
+        std::string getError() const;
+
+    private:
+        typedef std::unordered_map<std::string, std::shared_ptr<const std::string>> Records;
+        // A change waiting to be written, with no value for a record that was erased
+        typedef std::pair<std::string, std::shared_ptr<const std::string>> Change;
+
+        void append(const std::string &key, const std::shared_ptr<const std::string> &value);
+        bool load();
+        bool needsCompaction() const;
+
+        void workerLoop();
+        void writePending(std::unique_lock<std::mutex> &lock);
+        void rewrite(std::unique_lock<std::mutex> &lock);
+
+        bool writeChanges(const std::vector<Change> &changes);
+
+        static std::size_t getRecordSize(const std::string &key, const std::string *value);
+        static void encodeRecord(std::string &out, const std::string &key, const std::string *value);
+
+        std::string path;
+        std::FILE *file;
+
+        Records records;
+        // Bytes in the log taken up by records that haven't been superseded
+        std::size_t liveSize;
+        // Bytes in the log, including what's pending
+        std::size_t logSize;
+
+        // Changes waiting to be appended, which are only encoded by the worker thread
+        std::vector<Change> pending;
+        std::size_t pendingSize;
+        uint64_t changeCount;
+        uint64_t writtenChangeCount;
+
+        bool isStopping;
+        bool isFlushRequested;
+        bool isCompactionRequested;
+        std::string error;
+
+        std::thread worker;
+        mutable std::mutex mutex;
+        std::condition_variable workCondition;
+        std::condition_variable writtenCondition;
+    };
+}
+
+#endif //OPENMW_RECORDSTORE_HPP
@@ -9,7 +9,6 @@ Timer::Timer(ScriptFunc callback, long msec, const std::string& def, std::vector
 {
     targetMsec = msec;
     this->args = args;
-    isEnded = true;
 }
 
 #if defined(ENABLE_LUA)
@@ -17,185 +16,155 @@ Timer::Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::strin
 {
     targetMsec = msec;
     this->args = args;
-    isEnded = true;
 }
 #endif
 
-void Timer::Tick()
+void Timer::Fire()
 {
-    if (isEnded)
-        return;
-
-    const auto duration = std::chrono::system_clock::now().time_since_epoch();
-    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-
-    if (time - startTime >= targetMsec)
-    {
-        isEnded = true;
-        Call(args);
-    }
+    Call(args);
 }
 
-bool Timer::IsEnded()
-{
-    return isEnded;
-}
+std::vector<Timer*> TimerAPI::timers;
+TimerSchedule TimerAPI::schedule;
+std::vector<int> TimerAPI::expired;
+std::vector<uint32_t> TimerAPI::expiredGenerations;
 
-void Timer::Stop()
+int TimerAPI::AddTimer(Timer *timer)
 {
-    isEnded = true;
-}
+    // Ids of freed timers are handed out again before new ones are created
+    int id = schedule.allocate();
 
-void Timer::Restart(int msec)
-{
-    targetMsec = msec;
-    Start();
+    if (static_cast<std::size_t>(id) >= timers.size())
+        timers.resize(id + 1, nullptr);
+
+    timers[id] = timer;
+    return id;
 }
 
-void Timer::Start()
+Timer *TimerAPI::GetTimer(int timerid)
 {
-    isEnded = false;
+    if (!schedule.isAllocated(timerid))
+        return nullptr;
 
-    const auto duration = std::chrono::system_clock::now().time_since_epoch();
-    const auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-    startTime = msec;
+    return timers[timerid];
 }
 
-int TimerAPI::pointer = 0;
-std::unordered_map<int, Timer* > TimerAPI::timers;
-
 #if defined(ENABLE_LUA)
 int TimerAPI::CreateTimerLua(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args)
 {
-    int id = -1;
-
-    for (auto timer : timers)
-    {
-        if (timer.second != nullptr)
-            continue;
-        timer.second = new Timer(lua, callback, msec, def, args);
-        id = timer.first;
-    }
-
-    if (id == -1)
-    {
-        timers[pointer] = new Timer(lua, callback, msec, def, args);
-        id = pointer;
-        pointer++;
-    }
-
-    return id;
+    return AddTimer(new Timer(lua, callback, msec, def, args));
 }
 #endif
 
 
 int TimerAPI::CreateTimer(ScriptFunc callback, long msec, const std::string &def, std::vector<boost::any> args)
 {
-    int id = -1;
-
-    for (auto timer : timers)
-    {
-        if (timer.second != nullptr)
-            continue;
-        timer.second = new Timer(callback, msec, def, args);
-        id = timer.first;
-    }
-
-    if (id == -1)
-    {
-        timers[pointer] = new Timer(callback, msec, def, args);
-        id = pointer;
-        pointer++;
-    }
-
-    return id;
+    return AddTimer(new Timer(callback, msec, def, args));
 }
 
 void TimerAPI::FreeTimer(int timerid)
 {
+    Timer *timer = GetTimer(timerid);
 
-    try
-    {
-        if (timers.at(timerid) != nullptr)
-        {
-            delete timers[timerid];
-            timers[timerid] = nullptr;
-        }
-    }
-    catch(...)
+    if (timer == nullptr)
     {
         std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return;
     }
+
+    delete timer;
+    timers[timerid] = nullptr;
+    schedule.release(timerid);
 }
 
 void TimerAPI::ResetTimer(int timerid, long msec)
 {
-    try
-    {
-        timers.at(timerid)->Restart(msec);
-    }
-    catch(...)
+    Timer *timer = GetTimer(timerid);
+
+    if (timer == nullptr)
     {
         std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return;
     }
+
+    timer->targetMsec = msec;
+    StartTimer(timerid);
 }
 
 void TimerAPI::StartTimer(int timerid)
 {
-    try
-    {
-        Timer *timer = timers.at(timerid);
-        if (timer == nullptr)
-            throw 1;
-        timer->Start();
-    }
-    catch(...)
+    Timer *timer = GetTimer(timerid);
+
+    if (timer == nullptr)
     {
         std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return;
     }
+
+    schedule.schedule(timerid, TimerSchedule::Clock::now() + std::chrono::milliseconds(timer->targetMsec));
 }
 
 void TimerAPI::StopTimer(int timerid)
 {
-    try
-    {
-        timers.at(timerid)->Stop();
-    }
-    catch(...)
+    if (GetTimer(timerid) == nullptr)
     {
         std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return;
     }
+
+    schedule.cancel(timerid);
 }
 
 bool TimerAPI::IsTimerElapsed(int timerid)
 {
-    bool ret = false;
-    try
-    {
-        ret = timers.at(timerid)->IsEnded();
-    }
-    catch(...)
+    if (GetTimer(timerid) == nullptr)
     {
         std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return false;
     }
-    return ret;
+
+    return !schedule.isScheduled(timerid);
 }
 
 void TimerAPI::Terminate()
 {
-    for (auto timer : timers)
+    for (auto &timer : timers)
     {
-        if (timer.second != nullptr)
-            delete timer.second;
-        timer.second = nullptr;
+        delete timer;
+        timer = nullptr;
     }
+
+    timers.clear();
+    schedule = TimerSchedule();
 }
 
 void TimerAPI::Tick()
 {
-    for (auto timer : timers)
+    // Collect the expired timers before running any callbacks, because those are free to
+    // start, stop or free timers themselves
+    expired.clear();
+    schedule.popExpired(TimerSchedule::Clock::now(), expired);
+
+    expiredGenerations.clear();
+    for (int timerid : expired)
+        expiredGenerations.push_back(schedule.getGeneration(timerid));
+
+    for (std::size_t i = 0; i < expired.size(); i++)
     {
-        if (timer.second != nullptr)
-            timer.second->Tick();
+        int timerid = expired[i];
+
+        // Skip timers that an earlier callback in this tick has restarted, stopped or freed
+        if (schedule.getGeneration(timerid) != expiredGenerations[i])
+            continue;
+
+        Timer *timer = GetTimer(timerid);
+
+        if (timer != nullptr)
+            timer->Fire();
     }
 }
+
+long TimerAPI::GetMsecUntilNextTimer()
+{
+    return schedule.msecUntilNext(TimerSchedule::Clock::now());
+}
@@ -2,9 +2,11 @@
 #define OPENMW_TIMERAPI_HPP
 
 #include <string>
+#include <vector>
 
 #include <Script/Script.hpp>
 #include <Script/ScriptFunction.hpp>
+#include "TimerSchedule.hpp"
 
 namespace mwmp
 {
@@ -21,18 +23,13 @@ namespace mwmp
 #if defined(ENABLE_LUA)
         Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args);
 #endif
-        void Tick();
+        void Fire();
 
-        bool IsEnded();
-        void Stop();
-        void Start();
-        void Restart(int msec);
     private:
-        double startTime, targetMsec;
+        long targetMsec;
         std::string publ, arg_types;
         std::vector<boost::any> args;
         Script *scr;
-        bool isEnded;
     };
 
     class TimerAPI
@@ -51,9 +48,17 @@ namespace mwmp
         static void Terminate();
 
         static void Tick();
+
+        // Milliseconds until the next running timer elapses, or -1 if none are running
+        static long GetMsecUntilNextTimer();
     private:
-        static std::unordered_map<int, Timer* > timers;
-        static int pointer;
+        static int AddTimer(Timer *timer);
+        static Timer *GetTimer(int timerid);
+
+        static std::vector<Timer*> timers;
+        static TimerSchedule schedule;
+        static std::vector<int> expired;
+        static std::vector<uint32_t> expiredGenerations;
     };
 }
 
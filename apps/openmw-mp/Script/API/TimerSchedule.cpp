@@ -0,0 +1,155 @@
+#include "TimerSchedule.hpp"
+
+#include <algorithm>
+#include <functional>
+
+using namespace mwmp;
+
+int TimerSchedule::allocate()
+{
+    int id;
+
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<int>(slots.size());
+        slots.emplace_back();
+    }
+
+    slots[id].allocated = true;
+    return id;
+}
+
+void TimerSchedule::release(int id)
+{
+    if (!isAllocated(id))
+        return;
+
+    cancel(id);
+    slots[id].allocated = false;
+    freeIds.push_back(id);
+}
+
+bool TimerSchedule::isAllocated(int id) const
+{
+    return id >= 0 && static_cast<std::size_t>(id) < slots.size() && slots[id].allocated;
+}
+
+void TimerSchedule::schedule(int id, Clock::time_point deadline)
+{
+    if (!isAllocated(id))
+        return;
+
+    cancel(id);
+
+    Slot &slot = slots[id];
+    slot.scheduled = true;
+    scheduled++;
+
+    heap.push_back({deadline, id, slot.generation});
+    std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+
+    // Timers that keep getting restarted before they expire leave stale entries behind
+    if (heap.size() > 64 && heap.size() > 2 * scheduled)
+        compact();
+}
+
+void TimerSchedule::cancel(int id)
+{
+    if (!isAllocated(id))
+        return;
+
+    Slot &slot = slots[id];
+    slot.generation++;
+
+    if (slot.scheduled)
+    {
+        slot.scheduled = false;
+        scheduled--;
+    }
+}
+
+bool TimerSchedule::isScheduled(int id) const
+{
+    return isAllocated(id) && slots[id].scheduled;
+}
+
+uint32_t TimerSchedule::getGeneration(int id) const
+{
+    return isAllocated(id) ? slots[id].generation : 0;
+}
+
+void TimerSchedule::popExpired(Clock::time_point now, std::vector<int> &expired)
+{
+    while (!heap.empty() && heap.front().deadline <= now)
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        Entry entry = heap.back();
+        heap.pop_back();
+
+        if (!isCurrent(entry))
+            continue;
+
+        Slot &slot = slots[entry.id];
+        slot.scheduled = false;
+        scheduled--;
+
+        expired.push_back(entry.id);
+    }
+}
+
+long TimerSchedule::msecUntilNext(Clock::time_point now)
+{
+    dropStale();
+
+    if (heap.empty())
+        return -1;
+
+    if (heap.front().deadline <= now)
+        return 0;
+
+    // Round up so that waiting this long always reaches the deadline
+    auto remaining = heap.front().deadline - now;
+    auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(remaining);
+
+    if (msec < remaining)
+        msec += std::chrono::milliseconds(1);
+
+    return static_cast<long>(msec.count());
+}
+
+std::size_t TimerSchedule::size() const
+{
+    return slots.size() - freeIds.size();
+}
+
+std::size_t TimerSchedule::scheduledCount() const
+{
+    return scheduled;
+}
+
+bool TimerSchedule::isCurrent(const Entry &entry) const
+{
+    const Slot &slot = slots[entry.id];
+    return slot.allocated && slot.scheduled && slot.generation == entry.generation;
+}
+
+void TimerSchedule::dropStale()
+{
+    while (!heap.empty() && !isCurrent(heap.front()))
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        heap.pop_back();
+    }
+}
+
+void TimerSchedule::compact()
+{
+    heap.erase(std::remove_if(heap.begin(), heap.end(), [this] (const Entry &entry) { return !isCurrent(entry); }),
+               heap.end());
+    std::make_heap(heap.begin(), heap.end(), std::greater<Entry>());
+}
@@ -0,0 +1,75 @@
+#ifndef OPENMW_TIMERSCHEDULE_HPP
+#define OPENMW_TIMERSCHEDULE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace mwmp
+{
+    /**
+     * Keeps track of timer ids and their deadlines.
+     *
+     * Ids are recycled through a free list, and running timers are kept in a min-heap ordered by
+     * deadline, so finding the expired ones only looks at the front of the heap. Stopping or
+     * rescheduling a timer bumps its generation instead of searching the heap, and entries with
+     * an outdated generation are dropped once they reach the front.
+     */
+    class TimerSchedule
+    {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        int allocate();
+        void release(int id);
+        bool isAllocated(int id) const;
+
+        void schedule(int id, Clock::time_point deadline);
+        void cancel(int id);
+        bool isScheduled(int id) const;
+
+        // Changes whenever the timer is scheduled, cancelled or released
+        uint32_t getGeneration(int id) const;
+
+        // Remove every timer whose deadline is not after now and append its id to expired,
+        // in deadline order
+        void popExpired(Clock::time_point now, std::vector<int> &expired);
+
+        // Milliseconds until the earliest deadline, or -1 if no timer is scheduled
+        long msecUntilNext(Clock::time_point now);
+
+        std::size_t size() const;
+        std::size_t scheduledCount() const;
+
+    private:
+        struct Entry
+        {
+            Clock::time_point deadline;
+            int id;
+            uint32_t generation;
+
+            bool operator>(const Entry &other) const
+            {
+                return deadline > other.deadline;
+            }
+        };
+
+        struct Slot
+        {
+            uint32_t generation = 0;
+            bool allocated = false;
+            bool scheduled = false;
+        };
+
+        bool isCurrent(const Entry &entry) const;
+        void dropStale();
+        void compact();
+
+        std::vector<Slot> slots;
+        std::vector<int> freeIds;
+        std::vector<Entry> heap;
+        std::size_t scheduled = 0;
+    };
+}
+
+#endif //OPENMW_TIMERSCHEDULE_HPP
@@ -8,6 +8,10 @@
 
 #include <components/esm/creaturestats.hpp>
 
+#if defined(ENABLE_LUA)
+#include <apps/openmw-mp/Script/LangLua/LuaLists.hpp>
+#endif
+
 #include "Actors.hpp"
 
 using namespace mwmp;
@@ -521,6 +525,30 @@ void ActorFunctions::AddActor() noexcept
     tempActor = emptyActor;
 }
 
+#if defined(ENABLE_LUA)
+int ActorFunctions::GetActorListTable(lua_State *lua)
+{
+    if (readActorList == nullptr)
+        lua_newtable(lua);
+    else
+        LuaLists::pushActors(lua, readActorList->baseActors);
+
+    return 1;
+}
+
+int ActorFunctions::AddActors(lua_State *lua)
+{
+    const unsigned int count = LuaLists::forEachEntry(lua, 1, [lua](int index) {
+        BaseActor actor = emptyActor;
+        LuaLists::readActor(lua, index, actor);
+        writeActorList.baseActors.push_back(std::move(actor));
+    });
+
+    lua_pushinteger(lua, count);
+    return 1;
+}
+#endif
+
 void ActorFunctions::SendActorList() noexcept
 {
     mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_LIST);
@@ -1,6 +1,10 @@
 #ifndef OPENMW_ACTORAPI_HPP
 #define OPENMW_ACTORAPI_HPP
 
+#if defined(ENABLE_LUA)
+struct lua_State;
+#endif
+
 #define ACTORAPI \
     {"ReadReceivedActorList",                  ActorFunctions::ReadReceivedActorList},\
     {"ReadCellActorList",                      ActorFunctions::ReadCellActorList},\
@@ -129,6 +133,11 @@
     {"GetActorKillerRefNumIndex",              ActorFunctions::GetActorKillerRefNumIndex},\
     {"SetActorRefNumIndex",                    ActorFunctions::SetActorRefNumIndex}
 
+// Functions that take or return Lua tables, which are only registered for Lua scripts
+#define ACTORLUAAPI \
+    {"GetActorListTable",                      ActorFunctions::GetActorListTable},\
+    {"AddActors",                              ActorFunctions::AddActors}
+
 class ActorFunctions
 {
 public:
@@ -908,6 +917,45 @@ public:
     */
     static void AddActor() noexcept;
 
+#if defined(ENABLE_LUA)
+    /**
+    * \brief Get every actor in the read actor list at once, as a Lua table.
+    *
+    * Each actor is a table whose fields are named after the matching Get and Set functions:
+    *
+    * - refId, refNum, mpNum, cell, posX, posY, posZ, rotX, rotY, rotZ and hasPosition
+    * - healthBase, healthCurrent, healthModified, magickaBase, magickaCurrent, magickaModified,
+    *   fatigueBase, fatigueCurrent, fatigueModified and hasStatsDynamic
+    * - equipment, with the refId, count, charge, enchantmentCharge and soul of the item in each
+    *   slot, starting from slot 0
+    * - sound
+    * - deathState, deathInstant, and killer, which is a table with isPlayer and either the pid
+    *   of a player or the refId, refNum, mpNum and name of an actor
+    * - aiAction, aiDistance, aiDuration, aiRepetition, aiCoordinates with posX, posY and posZ,
+    *   and for actors with an AI target, aiTarget in the same form as killer
+    * - spellsActiveAction, and spellsActive with the id, displayName, stackingState and caster of
+    *   each spell, along with its effects with their id, arg, magnitude, duration and timeLeft
+    *
+    * This is much faster than calling a Get function for each field of each actor.
+    *
+    * \return The table of actors, in the same order as their indexes.
+    */
+    static int GetActorListTable(lua_State *lua);
+
+    /**
+    * \brief Add every actor in a Lua table to the server's temporary actor list.
+    *
+    * The actors are tables with the same fields as those returned by GetActorListTable, apart from
+    * hasPosition and hasStatsDynamic. Setting aiTarget gives an actor an AI target, the way
+    * SetActorAITargetToPlayer and SetActorAITargetToObject do. Missing fields are left at the
+    * values a cleared temporary actor has.
+    *
+    * \param actors The table of actors.
+    * \return The number of actors added.
+    */
+    static int AddActors(lua_State *lua);
+#endif
+
     /**
     * \brief Send an ActorList packet.
     *
@@ -7,6 +7,10 @@
 #include <apps/openmw-mp/Networking.hpp>
 #include <apps/openmw/mwworld/inventorystore.hpp>
 
+#if defined(ENABLE_LUA)
+#include <apps/openmw-mp/Script/LangLua/LuaLists.hpp>
+#endif
+
 using namespace mwmp;
 
 void ItemFunctions::ClearInventoryChanges(unsigned short pid) noexcept
@@ -93,6 +97,38 @@ void ItemFunctions::AddItemChange(unsigned short pid, const char* refId, unsigne
     player->inventoryChanges.items.push_back(item);
 }
 
+#if defined(ENABLE_LUA)
+int ItemFunctions::GetInventoryChangesTable(lua_State *lua)
+{
+    const unsigned short pid = static_cast<unsigned short>(lua_tointeger(lua, 1));
+
+    Player *player;
+    GET_PLAYER(pid, player, 0);
+
+    LuaLists::pushItems(lua, player->inventoryChanges.items);
+    return 1;
+}
+
+int ItemFunctions::AddItemChanges(lua_State *lua)
+{
+    const unsigned short pid = static_cast<unsigned short>(lua_tointeger(lua, 1));
+
+    Player *player;
+    GET_PLAYER(pid, player, 0);
+
+    std::vector<Item> &items = player->inventoryChanges.items;
+
+    const unsigned int count = LuaLists::forEachEntry(lua, 2, [lua, &items](int index) {
+        Item item = {};
+        LuaLists::readItem(lua, index, item);
+        items.push_back(std::move(item));
+    });
+
+    lua_pushinteger(lua, count);
+    return 1;
+}
+#endif
+
 bool ItemFunctions::HasItemEquipped(unsigned short pid, const char* refId)
 {
     Player *player;
@@ -1,6 +1,10 @@
 #ifndef OPENMW_ITEMAPI_HPP
 #define OPENMW_ITEMAPI_HPP
 
+#if defined(ENABLE_LUA)
+struct lua_State;
+#endif
+
 #define ITEMAPI \
     {"ClearInventoryChanges",                 ItemFunctions::ClearInventoryChanges},\
     \
@@ -43,6 +47,11 @@
     {"InitializeInventoryChanges",            ItemFunctions::InitializeInventoryChanges},\
     {"AddItem",                               ItemFunctions::AddItem}
 
+// Functions that take or return Lua tables, which are only registered for Lua scripts
+#define ITEMLUAAPI \
+    {"GetInventoryChangesTable",              ItemFunctions::GetInventoryChangesTable},\
+    {"AddItemChanges",                        ItemFunctions::AddItemChanges}
+
 class ItemFunctions
 {
 public:
@@ -136,6 +145,32 @@ public:
     static void AddItemChange(unsigned short pid, const char* refId, unsigned int count, int charge,
         double enchantmentCharge, const char* soul) noexcept;
 
+#if defined(ENABLE_LUA)
+    /**
+    * \brief Get every item in a player's latest inventory changes at once, as a Lua table.
+    *
+    * Each item is a table with refId, count, charge, enchantmentCharge and soul fields.
+    *
+    * This is much faster than calling a GetInventoryItem function for each field of each item.
+    *
+    * \param pid The player ID.
+    * \return The table of items, in the same order as their indexes.
+    */
+    static int GetInventoryChangesTable(lua_State *lua);
+
+    /**
+    * \brief Add every item in a Lua table to a player's inventory changes.
+    *
+    * The items are tables with the same fields as those returned by GetInventoryChangesTable.
+    * Missing fields are left at 0 or empty.
+    *
+    * \param pid The player ID.
+    * \param items The table of items.
+    * \return The number of items added.
+    */
+    static int AddItemChanges(lua_State *lua);
+#endif
+
     /**
     * \brief Check whether a player has equipped an item with a certain refId in any slot.
     *
@@ -6,6 +6,10 @@
 #include <apps/openmw-mp/Utils.hpp>
 #include <apps/openmw-mp/Script/ScriptFunctions.hpp>
 
+#if defined(ENABLE_LUA)
+#include <apps/openmw-mp/Script/LangLua/LuaLists.hpp>
+#endif
+
 #include "Objects.hpp"
 
 using namespace mwmp;
@@ -712,6 +716,30 @@ void ObjectFunctions::AddContainerItem() noexcept
     tempContainerItem = emptyContainerItem;
 }
 
+#if defined(ENABLE_LUA)
+int ObjectFunctions::GetObjectListTable(lua_State *lua)
+{
+    if (readObjectList == nullptr)
+        lua_newtable(lua);
+    else
+        LuaLists::pushObjects(lua, readObjectList->baseObjects);
+
+    return 1;
+}
+
+int ObjectFunctions::AddObjects(lua_State *lua)
+{
+    const unsigned int count = LuaLists::forEachEntry(lua, 1, [lua](int index) {
+        BaseObject object = emptyObject;
+        LuaLists::readObject(lua, index, object);
+        writeObjectList.baseObjects.push_back(std::move(object));
+    });
+
+    lua_pushinteger(lua, count);
+    return 1;
+}
+#endif
+
 void ObjectFunctions::SendObjectActivate(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
 {
     mwmp::ObjectPacket *packet = mwmp::Networking::get().getObjectPacketController()->GetPacket(ID_OBJECT_ACTIVATE);
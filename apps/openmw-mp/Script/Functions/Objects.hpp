@@ -1,6 +1,10 @@
 #ifndef OPENMW_OBJECTAPI_HPP
 #define OPENMW_OBJECTAPI_HPP
 
+#if defined(ENABLE_LUA)
+struct lua_State;
+#endif
+
 #define OBJECTAPI \
     {"ReadReceivedObjectList",                ObjectFunctions::ReadReceivedObjectList},\
     \
@@ -186,6 +190,11 @@
     {"SetObjectRefNumIndex",                  ObjectFunctions::SetObjectRefNumIndex},\
     {"AddWorldObject",                        ObjectFunctions::AddWorldObject}
 
+// Functions that take or return Lua tables, which are only registered for Lua scripts
+#define OBJECTLUAAPI \
+    {"GetObjectListTable",                    ObjectFunctions::GetObjectListTable},\
+    {"AddObjects",                            ObjectFunctions::AddObjects}
+
 class ObjectFunctions
 {
 public:
@@ -1318,6 +1327,49 @@ public:
     */
     static void AddContainerItem() noexcept;
 
+#if defined(ENABLE_LUA)
+    /**
+    * \brief Get every object in the read object list at once, as a Lua table.
+    *
+    * Each object is a table whose fields are named after the matching Get and Set functions:
+    *
+    * - refId, refNum, mpNum, count, charge, enchantmentCharge, soul, goldValue, scale, state,
+    *   doorState, lockLevel, disarmState, droppedByPlayer, posX, posY, posZ, rotX, rotY and rotZ
+    * - isPlayer, and pid for players
+    * - soundId, volume and pitch
+    * - dialogueChoiceType and dialogueChoiceTopic
+    * - goldPool, lastGoldRestockHour and lastGoldRestockDay
+    * - doorTeleportState, doorDestinationCell, and doorDestination with posX, posY, posZ, rotX,
+    *   rotY and rotZ
+    * - videoFilename, animGroup and animMode
+    * - hitSuccess, hitDamage, hitBlock and hitKnockdown
+    * - summonState, summonEffectId, summonSpellId and summonDuration
+    * - activating, hitting and summoner, which are tables with isPlayer and either the pid of a
+    *   player or the refId, refNum, mpNum and name of an actor
+    * - clientLocals, with the internalIndex, variableType, intValue and floatValue of each local
+    * - hasContainer, and for objects with container changes, containerItems with the refId,
+    *   count, charge, enchantmentCharge, soul and actionCount of each item
+    *
+    * This is much faster than calling a Get function for each field of each object.
+    *
+    * \return The table of objects, in the same order as their indexes.
+    */
+    static int GetObjectListTable(lua_State *lua);
+
+    /**
+    * \brief Add every object in a Lua table to the server's currently stored object list.
+    *
+    * The objects are tables with the same fields as those returned by GetObjectListTable. Setting
+    * pid makes an object a player, the way SetPlayerAsObject does, and setting pid in a table such
+    * as summoner makes that a player instead of an actor. Missing fields are left at the values a
+    * cleared temporary object has.
+    *
+    * \param objects The table of objects.
+    * \return The number of objects added.
+    */
+    static int AddObjects(lua_State *lua);
+#endif
+
     /**
     * \brief Send an ObjectActivate packet.
     *
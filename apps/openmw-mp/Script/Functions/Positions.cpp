@@ -120,3 +120,13 @@ void PositionFunctions::SendMomentum(unsigned short pid) noexcept
 
     packet->Send(false);
 }
+
+void PositionFunctions::AddPositionRelayBand(double distance, unsigned int interval) noexcept
+{
+    mwmp::Networking::getPtr()->getPositionInterestBands().addBand(static_cast<float>(distance), interval);
+}
+
+void PositionFunctions::ClearPositionRelayBands() noexcept
+{
+    mwmp::Networking::getPtr()->getPositionInterestBands().clear();
+}
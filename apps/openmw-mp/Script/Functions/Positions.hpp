@@ -20,7 +20,10 @@
     {"SetMomentum",         PositionFunctions::SetMomentum},\
     \
     {"SendPos",             PositionFunctions::SendPos},\
-    {"SendMomentum",        PositionFunctions::SendMomentum}
+    {"SendMomentum",        PositionFunctions::SendMomentum},\
+    \
+    {"AddPositionRelayBand",    PositionFunctions::AddPositionRelayBand},\
+    {"ClearPositionRelayBands", PositionFunctions::ClearPositionRelayBands}
 
 
 class PositionFunctions
@@ -153,6 +156,35 @@ public:
     * \return void
     */
     static void SendMomentum(unsigned short pid) noexcept;
+
+    /**
+    * \brief Add a distance band for relaying player positions.
+    *
+    * Players within the band's distance of a moving player only receive every Nth position
+    * update from them, where N is the band's interval. Players beyond the farthest band use
+    * that band's interval. Adding a band with the same distance as an existing one replaces it.
+    *
+    * As long as no bands have been added, every position update is relayed to every player
+    * with the same cells loaded.
+    *
+    * Example usage:
+    * - tes3mp.AddPositionRelayBand(2048, 1)
+    * - tes3mp.AddPositionRelayBand(8192, 3)
+    * - tes3mp.AddPositionRelayBand(16384, 6)
+    *
+    * \param distance The maximum distance covered by the band, in game units.
+    * \param interval Relay one out of this many position updates.
+    * \return void
+    */
+    static void AddPositionRelayBand(double distance, unsigned int interval) noexcept;
+
+    /**
+    * \brief Remove all distance bands for relaying player positions, so that every position
+    *        update is relayed again.
+    *
+    * \return void
+    */
+    static void ClearPositionRelayBands() noexcept;
 };
 
 #endif //OPENMW_POSITIONAPI_HPP
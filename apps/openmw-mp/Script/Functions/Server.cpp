@@ -1,6 +1,7 @@
 #include "Server.hpp"
 
 #include <components/misc/stringops.hpp>
+#include <components/openmw-mp/ChecksumCache.hpp>
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 #include <components/openmw-mp/Version.hpp>
@@ -8,9 +9,12 @@
 #include <apps/openmw-mp/Script/ScriptFunctions.hpp>
 #include <apps/openmw-mp/Networking.hpp>
 #include <apps/openmw-mp/MasterClient.hpp>
+#include <apps/openmw-mp/Telemetry.hpp>
 #include <Script/Script.hpp>
 
 static std::string tempFilename;
+static std::string tempChecksum;
+static mwmp::ChecksumCache checksumCache;
 static std::chrono::high_resolution_clock::time_point startupTime = std::chrono::high_resolution_clock::now();
 
 void ServerFunctions::LogMessage(unsigned short level, const char *message) noexcept
@@ -145,6 +149,90 @@ bool ServerFunctions::GetScriptErrorIgnoringState() noexcept
     return mwmp::Networking::getPtr()->getScriptErrorIgnoringState();
 }
 
+double ServerFunctions::GetPacketBytesSerialized(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    return static_cast<double>(mwmp::BasePacket::getTraffic(static_cast<uint8_t>(packetID)).bytesSerialized);
+}
+
+double ServerFunctions::GetPacketBytesSent(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    return static_cast<double>(mwmp::BasePacket::getTraffic(static_cast<uint8_t>(packetID)).bytesSent);
+}
+
+double ServerFunctions::GetPacketSerializationTime(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    auto serializeTime = mwmp::BasePacket::getTraffic(static_cast<uint8_t>(packetID)).serializeTime;
+    return std::chrono::duration<double, std::milli>(serializeTime).count();
+}
+
+double ServerFunctions::GetPacketsReceived(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    return static_cast<double>(mwmp::Telemetry::getPacketStats(static_cast<uint8_t>(packetID)).packetsReceived);
+}
+
+double ServerFunctions::GetPacketBytesReceived(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    return static_cast<double>(mwmp::Telemetry::getPacketStats(static_cast<uint8_t>(packetID)).bytesReceived);
+}
+
+double ServerFunctions::GetPacketProcessingTime(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    auto processTime = mwmp::Telemetry::getPacketStats(static_cast<uint8_t>(packetID)).processTime;
+    return std::chrono::duration<double, std::milli>(processTime).count();
+}
+
+double ServerFunctions::GetPacketScriptTime(unsigned short packetID) noexcept
+{
+    if (packetID > 255)
+        return 0;
+
+    auto scriptTime = mwmp::Telemetry::getPacketStats(static_cast<uint8_t>(packetID)).scriptTime;
+    return std::chrono::duration<double, std::milli>(scriptTime).count();
+}
+
+double ServerFunctions::GetScriptCallbackCount(const char *callbackName) noexcept
+{
+    return static_cast<double>(mwmp::Telemetry::getCallbackStats(callbackName).calls);
+}
+
+double ServerFunctions::GetScriptCallbackTime(const char *callbackName) noexcept
+{
+    return std::chrono::duration<double, std::milli>(mwmp::Telemetry::getCallbackStats(callbackName).time).count();
+}
+
+unsigned int ServerFunctions::GetTicksPerSecond() noexcept
+{
+    return mwmp::Networking::get().getTickScheduler().getTicksPerSecond();
+}
+
+double ServerFunctions::GetAverageTickTime() noexcept
+{
+    return mwmp::Networking::get().getTickScheduler().getAverageTickTime();
+}
+
+double ServerFunctions::GetMaximumTickTime() noexcept
+{
+    return mwmp::Networking::get().getTickScheduler().getMaximumTickTime();
+}
+
 void ServerFunctions::SetGameMode(const char *gameMode) noexcept
 {
     if (mwmp::Networking::getPtr()->getMasterClient())
@@ -220,6 +308,26 @@ void ServerFunctions::AddDataFileRequirement(const char *dataFilename, const cha
     }
 }
 
+const char *ServerFunctions::GetDataFileChecksum(const char *filePath) noexcept
+{
+    if (!boost::filesystem::is_regular_file(filePath))
+        tempChecksum.clear();
+    else
+        tempChecksum = std::to_string(checksumCache.getChecksum(filePath));
+
+    return tempChecksum.c_str();
+}
+
+void ServerFunctions::ResetTelemetry() noexcept
+{
+    mwmp::Telemetry::reset();
+}
+
+bool ServerFunctions::SaveTelemetry(const char *filePath) noexcept
+{
+    return mwmp::Telemetry::writeCsv(filePath);
+}
+
 // All methods below are deprecated versions of methods from above
 
 bool ServerFunctions::DoesFileExist(const char *filePath) noexcept
@@ -28,6 +28,18 @@
     {"HasPassword",                     ServerFunctions::HasPassword},\
     {"GetDataFileEnforcementState",     ServerFunctions::GetDataFileEnforcementState},\
     {"GetScriptErrorIgnoringState",     ServerFunctions::GetScriptErrorIgnoringState},\
+    {"GetPacketBytesSerialized",        ServerFunctions::GetPacketBytesSerialized},\
+    {"GetPacketBytesSent",              ServerFunctions::GetPacketBytesSent},\
+    {"GetPacketSerializationTime",      ServerFunctions::GetPacketSerializationTime},\
+    {"GetPacketsReceived",              ServerFunctions::GetPacketsReceived},\
+    {"GetPacketBytesReceived",          ServerFunctions::GetPacketBytesReceived},\
+    {"GetPacketProcessingTime",         ServerFunctions::GetPacketProcessingTime},\
+    {"GetPacketScriptTime",             ServerFunctions::GetPacketScriptTime},\
+    {"GetScriptCallbackCount",          ServerFunctions::GetScriptCallbackCount},\
+    {"GetScriptCallbackTime",           ServerFunctions::GetScriptCallbackTime},\
+    {"GetTicksPerSecond",               ServerFunctions::GetTicksPerSecond},\
+    {"GetAverageTickTime",              ServerFunctions::GetAverageTickTime},\
+    {"GetMaximumTickTime",              ServerFunctions::GetMaximumTickTime},\
     \
     {"SetGameMode",                     ServerFunctions::SetGameMode},\
     {"SetHostname",                     ServerFunctions::SetHostname},\
@@ -38,6 +50,10 @@
     {"SetRuleValue",                    ServerFunctions::SetRuleValue},\
     \
     {"AddDataFileRequirement",          ServerFunctions::AddDataFileRequirement},\
+    {"GetDataFileChecksum",             ServerFunctions::GetDataFileChecksum},\
+    \
+    {"ResetTelemetry",                  ServerFunctions::ResetTelemetry},\
+    {"SaveTelemetry",                   ServerFunctions::SaveTelemetry},\
     \
     {"DoesFileExist",                   ServerFunctions::DoesFileExist},\
     {"GetModDir",                       ServerFunctions::GetModDir},\
@@ -227,6 +243,115 @@ public:
     */
     static bool GetScriptErrorIgnoringState() noexcept;
 
+    /**
+    * \brief Get the number of bytes serialized for packets with a certain ID since the
+    *        server was started.
+    *
+    * Packets sent to several players at once are only serialized once, so comparing this
+    * with GetPacketBytesSent() shows how much serialization work has been saved.
+    *
+    * \param packetID The packet ID.
+    * \return The number of bytes serialized.
+    */
+    static double GetPacketBytesSerialized(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the number of bytes handed to the network layer for packets with a certain ID
+    *        since the server was started.
+    *
+    * \param packetID The packet ID.
+    * \return The number of bytes sent.
+    */
+    static double GetPacketBytesSent(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the time spent serializing outgoing packets with a certain ID since the
+    *        server was started or telemetry was last reset.
+    *
+    * \param packetID The packet ID.
+    * \return The serialization time in milliseconds.
+    */
+    static double GetPacketSerializationTime(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the number of packets with a certain ID received since the server was
+    *        started or telemetry was last reset.
+    *
+    * \param packetID The packet ID.
+    * \return The number of packets received.
+    */
+    static double GetPacketsReceived(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the number of bytes received in packets with a certain ID since the server
+    *        was started or telemetry was last reset.
+    *
+    * \param packetID The packet ID.
+    * \return The number of bytes received.
+    */
+    static double GetPacketBytesReceived(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the time spent processing received packets with a certain ID, including the
+    *        script callbacks they triggered, since the server was started or telemetry was
+    *        last reset.
+    *
+    * \param packetID The packet ID.
+    * \return The processing time in milliseconds.
+    */
+    static double GetPacketProcessingTime(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the part of GetPacketProcessingTime() that was spent inside script callbacks.
+    *
+    * \param packetID The packet ID.
+    * \return The script time in milliseconds.
+    */
+    static double GetPacketScriptTime(unsigned short packetID) noexcept;
+
+    /**
+    * \brief Get the number of times a script callback has been called since the server was
+    *        started or telemetry was last reset.
+    *
+    * \param callbackName The name of the callback, such as "OnPlayerConnect".
+    * \return The number of calls.
+    */
+    static double GetScriptCallbackCount(const char *callbackName) noexcept;
+
+    /**
+    * \brief Get the time spent inside a script callback since the server was started or
+    *        telemetry was last reset.
+    *
+    * The time includes any other callbacks triggered from inside it.
+    *
+    * \param callbackName The name of the callback, such as "OnPlayerConnect".
+    * \return The callback time in milliseconds.
+    */
+    static double GetScriptCallbackTime(const char *callbackName) noexcept;
+
+    /**
+    * \brief Get the number of main loop ticks the server ran during the last second.
+    *
+    * \return The number of ticks.
+    */
+    static unsigned int GetTicksPerSecond() noexcept;
+
+    /**
+    * \brief Get the average time spent handling packets and timers per tick during the
+    *        last second, not counting time spent waiting.
+    *
+    * \return The average tick time in milliseconds.
+    */
+    static double GetAverageTickTime() noexcept;
+
+    /**
+    * \brief Get the longest time spent handling packets and timers in a single tick during
+    *        the last second.
+    *
+    * \return The maximum tick time in milliseconds.
+    */
+    static double GetMaximumTickTime() noexcept;
+
     /**
     * \brief Set the game mode of the server, as displayed in the server browser.
     *
@@ -305,6 +430,33 @@ public:
      */
     static void AddDataFileRequirement(const char *dataFilename, const char *checksumString) noexcept;
 
+    /**
+     * \brief Get the CRC32 checksum of a file, in the form taken by AddDataFileRequirement.
+     *
+     * Checksums are remembered until the file's size or modification time changes, so asking
+     * again for the same file is cheap.
+     *
+     * @param filePath The path of the file.
+     * @return The checksum, or an empty string if the file can't be read.
+     */
+    static const char *GetDataFileChecksum(const char *filePath) noexcept;
+
+    /**
+    * \brief Reset all per-packet and per-callback telemetry counters.
+    *
+    * \return void
+    */
+    static void ResetTelemetry() noexcept;
+
+    /**
+    * \brief Append the current telemetry counters to a CSV file, writing a header first if
+    *        the file is new.
+    *
+    * \param filePath The path of the file.
+    * \return Whether the file could be written.
+    */
+    static bool SaveTelemetry(const char *filePath) noexcept;
+
     // All methods below are deprecated versions of methods from above
 
     static bool DoesFileExist(const char *filePath) noexcept;
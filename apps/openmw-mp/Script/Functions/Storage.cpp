@@ -0,0 +1,233 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+
+#include <apps/openmw-mp/Networking.hpp>
+#include <apps/openmw-mp/Player.hpp>
+#include <apps/openmw-mp/RecordFormat.hpp>
+#include <apps/openmw-mp/RecordStore.hpp>
+#include <apps/openmw-mp/Script/ScriptFunctions.hpp>
+
+#include "Storage.hpp"
+
+using namespace mwmp;
+
+extern BaseObjectList *readObjectList;
+extern BaseObjectList writeObjectList;
+
+namespace
+{
+    // What a record holds, as given by its first byte
+    enum RECORD_TYPE : char
+    {
+        STRING_RECORD = 's',
+        PLAYER_RECORD = 'p',
+        OBJECT_LIST_RECORD = 'o'
+    };
+
+    std::string recordString;
+    std::string recordStoreError;
+
+    BaseObjectList recordObjectList;
+
+    // Only used to check that object lists are saved and loaded for packets that exist
+    ObjectPacketController &getObjectPacketController()
+    {
+        static ObjectPacketController controller(nullptr);
+        return controller;
+    }
+
+    RecordStore &getRecordStore()
+    {
+        return Networking::getPtr()->getRecordStore();
+    }
+
+    // Check a record's type and the version of RecordFormat it was written with
+    bool isLoadableRecord(const std::string &record, RECORD_TYPE type, const char *key)
+    {
+        if (record.empty() || record[0] != type)
+            return false;
+
+        const uint16_t version = RecordFormat::getVersion(record, 1);
+
+        if (version == 0 || version > RecordFormat::version)
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Record %s was saved with record format version %u, "
+                "which this server can't read", key, version);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool saveObjectList(const char *key, unsigned short packetID, BaseObjectList &objectList)
+    {
+        if (packetID > 255 || !getObjectPacketController().ContainsPacket(static_cast<RakNet::MessageID>(packetID)))
+            return false;
+
+        std::string record(1, OBJECT_LIST_RECORD);
+        RecordFormat::writeObjectList(record, objectList, packetID);
+
+        getRecordStore().set(key, std::move(record));
+        return true;
+    }
+
+    unsigned short loadObjectList(const char *key, BaseObjectList &objectList)
+    {
+        std::shared_ptr<const std::string> value = getRecordStore().get(key);
+
+        if (!value || !isLoadableRecord(*value, OBJECT_LIST_RECORD, key))
+            return 0;
+
+        // Read the record into a list of its own, so a damaged one leaves the current list as it is
+        BaseObjectList loadedObjectList;
+        loadedObjectList.cell.blank();
+        loadedObjectList.packetOrigin = mwmp::PACKET_ORIGIN::SERVER_SCRIPT;
+        loadedObjectList.isValid = true;
+
+        uint16_t packetID = 0;
+
+        if (!RecordFormat::readObjectList(*value, 1, loadedObjectList, packetID) || packetID > 255 ||
+            !getObjectPacketController().ContainsPacket(static_cast<RakNet::MessageID>(packetID)))
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Record %s does not hold a valid object list", key);
+            return 0;
+        }
+
+        loadedObjectList.guid = objectList.guid;
+        objectList = std::move(loadedObjectList);
+
+        return packetID;
+    }
+}
+
+bool StorageFunctions::OpenRecordStore(const char *filePath) noexcept
+{
+    RecordStore &recordStore = getRecordStore();
+
+    if (recordStore.open(filePath))
+        return true;
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "%s", recordStore.getError().c_str());
+    return false;
+}
+
+bool StorageFunctions::CloseRecordStore() noexcept
+{
+    RecordStore &recordStore = getRecordStore();
+
+    if (recordStore.close())
+        return true;
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "%s", recordStore.getError().c_str());
+    return false;
+}
+
+bool StorageFunctions::FlushRecordStore() noexcept
+{
+    return getRecordStore().flush();
+}
+
+void StorageFunctions::CompactRecordStore() noexcept
+{
+    getRecordStore().compact();
+}
+
+const char *StorageFunctions::GetRecordStoreError() noexcept
+{
+    recordStoreError = getRecordStore().getError();
+    return recordStoreError.c_str();
+}
+
+unsigned int StorageFunctions::GetRecordCount() noexcept
+{
+    return static_cast<unsigned int>(getRecordStore().getRecordCount());
+}
+
+const char *StorageFunctions::GetRecordString(const char *key) noexcept
+{
+    std::shared_ptr<const std::string> value = getRecordStore().get(key);
+
+    if (value && !value->empty() && (*value)[0] == STRING_RECORD)
+        recordString.assign(*value, 1, std::string::npos);
+    else
+        recordString.clear();
+
+    return recordString.c_str();
+}
+
+bool StorageFunctions::HasRecord(const char *key) noexcept
+{
+    return getRecordStore().has(key);
+}
+
+void StorageFunctions::SetRecordString(const char *key, const char *value) noexcept
+{
+    std::string record(1, STRING_RECORD);
+    record.append(value);
+
+    getRecordStore().set(key, std::move(record));
+}
+
+void StorageFunctions::DeleteRecord(const char *key) noexcept
+{
+    getRecordStore().erase(key);
+}
+
+void StorageFunctions::SavePlayerRecord(unsigned short pid, const char *key) noexcept
+{
+    Player *player;
+    GET_PLAYER(pid, player, );
+
+    std::string record(1, PLAYER_RECORD);
+    RecordFormat::writePlayer(record, *player);
+
+    getRecordStore().set(key, std::move(record));
+}
+
+bool StorageFunctions::LoadPlayerRecord(unsigned short pid, const char *key) noexcept
+{
+    Player *player;
+    GET_PLAYER(pid, player, false);
+
+    std::shared_ptr<const std::string> value = getRecordStore().get(key);
+
+    if (!value || !isLoadableRecord(*value, PLAYER_RECORD, key))
+        return false;
+
+    // Make sure the whole record can be read before changing anything about the player
+    BasePlayer loadedPlayer(player->guid);
+
+    if (!RecordFormat::readPlayer(*value, 1, loadedPlayer))
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Record %s does not hold a valid player", key);
+        return false;
+    }
+
+    return RecordFormat::readPlayer(*value, 1, *player);
+}
+
+bool StorageFunctions::SaveObjectListRecord(const char *key, unsigned short packetID) noexcept
+{
+    return saveObjectList(key, packetID, writeObjectList);
+}
+
+bool StorageFunctions::SaveReceivedObjectListRecord(const char *key, unsigned short packetID) noexcept
+{
+    return saveObjectList(key, packetID, *Networking::getPtr()->getReceivedObjectList());
+}
+
+unsigned short StorageFunctions::LoadObjectListRecord(const char *key) noexcept
+{
+    return loadObjectList(key, writeObjectList);
+}
+
+unsigned short StorageFunctions::ReadObjectListRecord(const char *key) noexcept
+{
+    const unsigned short packetID = loadObjectList(key, recordObjectList);
+
+    if (packetID != 0)
+        readObjectList = &recordObjectList;
+
+    return packetID;
+}
@@ -0,0 +1,187 @@
+#ifndef OPENMW_STORAGEAPI_HPP
+#define OPENMW_STORAGEAPI_HPP
+
+#include "../Types.hpp"
+
+#define STORAGEAPI \
+    {"OpenRecordStore",              StorageFunctions::OpenRecordStore},\
+    {"CloseRecordStore",             StorageFunctions::CloseRecordStore},\
+    {"FlushRecordStore",             StorageFunctions::FlushRecordStore},\
+    {"CompactRecordStore",           StorageFunctions::CompactRecordStore},\
+    \
+    {"GetRecordStoreError",          StorageFunctions::GetRecordStoreError},\
+    {"GetRecordCount",               StorageFunctions::GetRecordCount},\
+    {"GetRecordString",              StorageFunctions::GetRecordString},\
+    \
+    {"HasRecord",                    StorageFunctions::HasRecord},\
+    \
+    {"SetRecordString",              StorageFunctions::SetRecordString},\
+    {"DeleteRecord",                 StorageFunctions::DeleteRecord},\
+    \
+    {"SavePlayerRecord",             StorageFunctions::SavePlayerRecord},\
+    {"LoadPlayerRecord",             StorageFunctions::LoadPlayerRecord},\
+    \
+    {"SaveObjectListRecord",         StorageFunctions::SaveObjectListRecord},\
+    {"SaveReceivedObjectListRecord", StorageFunctions::SaveReceivedObjectListRecord},\
+    {"LoadObjectListRecord",         StorageFunctions::LoadObjectListRecord},\
+    {"ReadObjectListRecord",         StorageFunctions::ReadObjectListRecord}
+
+class StorageFunctions
+{
+public:
+
+    /**
+    * \brief Open the record store kept in a file, creating the file if it doesn't exist.
+    *
+    * Every record is loaded into memory right away. Changes made afterwards are written to the
+    * file by a separate thread shortly after they're made, so saving never waits for the disk.
+    *
+    * Any record store that was already open is closed first.
+    *
+    * \param filePath The path of the file.
+    * \return Whether the record store could be opened.
+    */
+    static bool OpenRecordStore(const char *filePath) noexcept;
+
+    /**
+    * \brief Write every change left to the record store's file and close it.
+    *
+    * The record store is also closed when the server stops, after OnServerExit.
+    *
+    * \return Whether every change could be written.
+    */
+    static bool CloseRecordStore() noexcept;
+
+    /**
+    * \brief Wait until every change made to the record store so far has been written to its file.
+    *
+    * \return Whether every change could be written.
+    */
+    static bool FlushRecordStore() noexcept;
+
+    /**
+    * \brief Have the record store's file rewritten with only its current records.
+    *
+    * This happens on its own once most of the file is taken up by records that have since been
+    * changed or deleted.
+    *
+    * \return void
+    */
+    static void CompactRecordStore() noexcept;
+
+    /**
+    * \brief Get the reason the record store last failed to open or write to its file.
+    *
+    * \return The error, or an empty string if there hasn't been any.
+    */
+    static const char *GetRecordStoreError() noexcept;
+
+    /**
+    * \brief Get the number of records in the record store.
+    *
+    * \return The number of records.
+    */
+    static unsigned int GetRecordCount() noexcept;
+
+    /**
+    * \brief Get the string held by a record.
+    *
+    * \param key The key of the record.
+    * \return The string, or an empty string if the record doesn't exist or holds something else.
+    */
+    static const char *GetRecordString(const char *key) noexcept;
+
+    /**
+    * \brief Check whether a record exists.
+    *
+    * \param key The key of the record.
+    * \return Whether the record exists.
+    */
+    static bool HasRecord(const char *key) noexcept;
+
+    /**
+    * \brief Set a record to hold a string, replacing whatever it held before.
+    *
+    * \param key The key of the record.
+    * \param value The string.
+    * \return void
+    */
+    static void SetRecordString(const char *key, const char *value) noexcept;
+
+    /**
+    * \brief Delete a record.
+    *
+    * \param key The key of the record.
+    * \return void
+    */
+    static void DeleteRecord(const char *key) noexcept;
+
+    /**
+    * \brief Set a record to hold a player's character, stats, equipment, location and current
+    *        inventory, spellbook and quick key changes.
+    *
+    * Records are saved in a format of their own rather than as packets, so they can still be
+    * loaded after the server is updated to a new protocol version.
+    *
+    * \param pid The player ID.
+    * \param key The key of the record.
+    * \return void
+    */
+    static void SavePlayerRecord(unsigned short pid, const char *key) noexcept;
+
+    /**
+    * \brief Replace a player's character, stats, equipment, location and inventory, spellbook
+    *        and quick key changes with the ones held by a record.
+    *
+    * Nothing is sent to the player, so the matching Send functions need to be called afterwards.
+    *
+    * \param pid The player ID.
+    * \param key The key of the record.
+    * \return Whether the record exists and holds a player.
+    */
+    static bool LoadPlayerRecord(unsigned short pid, const char *key) noexcept;
+
+    /**
+    * \brief Set a record to hold the object list that can be sent by the server, with the
+    *        contents a packet of a certain type would have.
+    *
+    * \param key The key of the record.
+    * \param packetID The ID of the object packet, such as ID_OBJECT_PLACE.
+    * \return Whether the packet ID is for an object packet.
+    */
+    static bool SaveObjectListRecord(const char *key, unsigned short packetID) noexcept;
+
+    /**
+    * \brief Set a record to hold the object list last received by the server, with the
+    *        contents a packet of a certain type would have.
+    *
+    * \param key The key of the record.
+    * \param packetID The ID of the object packet it was received as, such as ID_OBJECT_PLACE.
+    * \return Whether the packet ID is for an object packet.
+    */
+    static bool SaveReceivedObjectListRecord(const char *key, unsigned short packetID) noexcept;
+
+    /**
+    * \brief Replace the object list that can be sent by the server with the one held by a record.
+    *
+    * The object list isn't attached to any player, so SetObjectListPid needs to be called
+    * before it's sent.
+    *
+    * \param key The key of the record.
+    * \return The ID of the object packet the object list was saved for, or 0 if the record
+    *         doesn't exist or holds something else.
+    */
+    static unsigned short LoadObjectListRecord(const char *key) noexcept;
+
+    /**
+    * \brief Use the object list held by a record as the one being read, the same way
+    *        ReadReceivedObjectList does for the one last received.
+    *
+    * \param key The key of the record.
+    * \return The ID of the object packet the object list was saved for, or 0 if the record
+    *         doesn't exist or holds something else.
+    */
+    static unsigned short ReadObjectListRecord(const char *key) noexcept;
+};
+
+#endif //OPENMW_STORAGEAPI_HPP
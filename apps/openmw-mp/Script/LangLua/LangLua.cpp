@@ -101,6 +101,13 @@ template<> struct F_<1> { static constexpr LuaFuctionData F{"CreateTimerEx", Lan
 template<> struct F_<2> { static constexpr LuaFuctionData F{"MakePublic", LangLua::MakePublic}; };
 template<> struct F_<3> { static constexpr LuaFuctionData F{"CallPublic", LangLua::CallPublic}; };
 
+// Functions with no counterpart in other languages, because they take or return Lua tables
+static constexpr LuaFuctionData tableFunctions[]{
+    ACTORLUAAPI,
+    ITEMLUAAPI,
+    OBJECTLUAAPI
+};
+
 #ifdef __arm__
 template<std::size_t... Is>
 struct indices {};
@@ -182,6 +189,9 @@ void LangLua::LoadProgram(const char *filename)
     for (unsigned i = 0; i < functions_n; i++)
         tes3mp.addCFunction(functions_[i].name, functions_[i].func);
 
+    for (const LuaFuctionData &function : tableFunctions)
+        tes3mp.addCFunction(function.name, function.func);
+
     tes3mp.endNamespace();
 
     if ((err = lua_pcall(lua, 0, 0, 0)) != 0) // Run once script for load in memory.
@@ -208,6 +218,48 @@ boost::any LangLua::Call(const char *name, const char *argl, int buf, ...)
     int n_args = (int)(strlen(argl));
 
     lua_getglobal(lua, name);
+    PushArguments(argl, vargs);
+
+    va_end(vargs);
+
+    luabridge::LuaException::pcall(lua, n_args, 1);
+    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
+}
+
+int LangLua::GetCallbackHandle(const char *name)
+{
+    lua_getglobal(lua, name);
+
+    if (!lua_isfunction(lua, -1))
+    {
+        lua_pop(lua, 1);
+        return -1;
+    }
+
+    // Keep a reference to the function in the registry, so calling it later is an array
+    // lookup instead of a global table lookup by name
+    return luaL_ref(lua, LUA_REGISTRYINDEX);
+}
+
+void LangLua::CallCallback(int handle, const char *argl, int buf, ...)
+{
+    va_list vargs;
+    va_start(vargs, buf);
+
+    int n_args = (int)(strlen(argl));
+
+    lua_rawgeti(lua, LUA_REGISTRYINDEX, handle);
+    PushArguments(argl, vargs);
+
+    va_end(vargs);
+
+    // Callbacks have no use for return values, so don't leave any on the stack
+    luabridge::LuaException::pcall(lua, n_args, 0);
+}
+
+void LangLua::PushArguments(const char *argl, va_list vargs)
+{
+    int n_args = (int)(strlen(argl));
 
     for (int index = 0; index < n_args; index++)
     {
@@ -249,11 +301,6 @@ boost::any LangLua::Call(const char *name, const char *argl, int buf, ...)
                 throw std::runtime_error("C++ call: Unknown argument identifier " + argl[index]);
         }
     }
-
-    va_end(vargs);
-
-    luabridge::LuaException::pcall(lua, n_args, 1);
-    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
 }
 
 boost::any LangLua::Call(const char *name, const char *argl, const std::vector<boost::any> &args)
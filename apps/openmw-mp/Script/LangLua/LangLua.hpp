@@ -6,6 +6,7 @@
 #include <extern/LuaBridge/LuaBridge.h>
 #include <LuaBridge.h>
 #include <set>
+#include <cstdarg>
 
 #include <boost/any.hpp>
 #include "../ScriptFunction.hpp"
@@ -41,7 +42,11 @@ public:
     virtual bool IsCallbackPresent(const char *name) override;
     virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
     virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
+    virtual int GetCallbackHandle(const char *name) override;
+    virtual void CallCallback(int handle, const char *argl, int buf, ...) override;
 private:
+    void PushArguments(const char *argl, va_list vargs);
+
     static std::set<std::string> packageCPath;
     static std::set<std::string> packagePath;
 };
@@ -0,0 +1,583 @@
+#include "LuaLists.hpp"
+
+#include <apps/openmw-mp/Player.hpp>
+#include <apps/openmw-mp/Utils.hpp>
+
+#include <iterator>
+
+using namespace mwmp;
+
+namespace
+{
+    // Each field is set by name on the table at the top of the stack
+    void setField(lua_State *lua, const char *name, const std::string &value)
+    {
+        lua_pushlstring(lua, value.data(), value.size());
+        lua_setfield(lua, -2, name);
+    }
+
+    template <typename T>
+    void setField(lua_State *lua, const char *name, T value)
+    {
+        lua_pushnumber(lua, static_cast<lua_Number>(value));
+        lua_setfield(lua, -2, name);
+    }
+
+    void setField(lua_State *lua, const char *name, bool value)
+    {
+        lua_pushboolean(lua, value);
+        lua_setfield(lua, -2, name);
+    }
+
+    void setPosition(lua_State *lua, const ESM::Position &position)
+    {
+        setField(lua, "posX", position.pos[0]);
+        setField(lua, "posY", position.pos[1]);
+        setField(lua, "posZ", position.pos[2]);
+        setField(lua, "rotX", position.rot[0]);
+        setField(lua, "rotY", position.rot[1]);
+        setField(lua, "rotZ", position.rot[2]);
+    }
+
+    // Each field is looked up on the table at the given absolute index, and only changes the
+    // value if it's there and of the right type
+    void getField(lua_State *lua, int index, const char *name, std::string &value)
+    {
+        lua_getfield(lua, index, name);
+
+        if (lua_type(lua, -1) == LUA_TSTRING)
+        {
+            std::size_t length;
+            const char *string = lua_tolstring(lua, -1, &length);
+            value.assign(string, length);
+        }
+
+        lua_pop(lua, 1);
+    }
+
+    template <typename T>
+    void getField(lua_State *lua, int index, const char *name, T &value)
+    {
+        lua_getfield(lua, index, name);
+
+        if (lua_type(lua, -1) == LUA_TNUMBER)
+            value = static_cast<T>(lua_tonumber(lua, -1));
+
+        lua_pop(lua, 1);
+    }
+
+    void getField(lua_State *lua, int index, const char *name, bool &value)
+    {
+        lua_getfield(lua, index, name);
+
+        if (lua_type(lua, -1) == LUA_TBOOLEAN)
+            value = lua_toboolean(lua, -1) != 0;
+
+        lua_pop(lua, 1);
+    }
+
+    void getPosition(lua_State *lua, int index, ESM::Position &position)
+    {
+        getField(lua, index, "posX", position.pos[0]);
+        getField(lua, index, "posY", position.pos[1]);
+        getField(lua, index, "posZ", position.pos[2]);
+        getField(lua, index, "rotX", position.rot[0]);
+        getField(lua, index, "rotY", position.rot[1]);
+        getField(lua, index, "rotZ", position.rot[2]);
+    }
+
+    void setPid(lua_State *lua, RakNet::RakNetGUID guid)
+    {
+        Player *player = Players::getPlayer(guid);
+        setField(lua, "pid", player != nullptr ? player->getId() : -1);
+    }
+
+    // Get the player whose pid is in a field, if there is one
+    Player *getPlayerField(lua_State *lua, int index)
+    {
+        lua_getfield(lua, index, "pid");
+
+        Player *player = nullptr;
+
+        if (lua_type(lua, -1) == LUA_TNUMBER)
+            player = Players::getPlayer(static_cast<unsigned short>(lua_tointeger(lua, -1)));
+
+        lua_pop(lua, 1);
+        return player;
+    }
+
+    // Add a table for a position, such as a door's destination, as a field
+    void setPositionField(lua_State *lua, const char *name, const ESM::Position &position)
+    {
+        lua_createtable(lua, 0, 6);
+        setPosition(lua, position);
+        lua_setfield(lua, -2, name);
+    }
+
+    void getPositionField(lua_State *lua, int index, const char *name, ESM::Position &position)
+    {
+        lua_getfield(lua, index, name);
+
+        if (lua_istable(lua, -1))
+            getPosition(lua, lua_gettop(lua), position);
+
+        lua_pop(lua, 1);
+    }
+
+    // Targets, such as the actor activating an object or the killer of an actor, are tables with
+    // either the pid of a player or the refId, refNum and mpNum of an object
+    void setTargetField(lua_State *lua, const char *name, const Target &target)
+    {
+        lua_createtable(lua, 0, 5);
+        setField(lua, "isPlayer", target.isPlayer);
+
+        if (target.isPlayer)
+            setPid(lua, target.guid);
+        else
+        {
+            setField(lua, "refId", target.refId);
+            setField(lua, "refNum", target.refNum);
+            setField(lua, "mpNum", target.mpNum);
+            setField(lua, "name", target.name);
+        }
+
+        lua_setfield(lua, -2, name);
+    }
+
+    // Return whether the field was there
+    bool getTargetField(lua_State *lua, int index, const char *name, Target &target)
+    {
+        lua_getfield(lua, index, name);
+
+        const bool isTable = lua_istable(lua, -1);
+
+        if (isTable)
+        {
+            const int targetIndex = lua_gettop(lua);
+
+            if (Player *player = getPlayerField(lua, targetIndex))
+            {
+                target.isPlayer = true;
+                target.guid = player->guid;
+            }
+            else
+            {
+                target.isPlayer = false;
+                getField(lua, targetIndex, "refId", target.refId);
+                getField(lua, targetIndex, "refNum", target.refNum);
+                getField(lua, targetIndex, "mpNum", target.mpNum);
+                getField(lua, targetIndex, "name", target.name);
+            }
+        }
+
+        lua_pop(lua, 1);
+        return isTable;
+    }
+
+    void getCellField(lua_State *lua, int index, const char *name, ESM::Cell &cell)
+    {
+        lua_getfield(lua, index, name);
+
+        if (lua_type(lua, -1) == LUA_TSTRING)
+            cell = Utils::getCellFromDescription(lua_tostring(lua, -1));
+
+        lua_pop(lua, 1);
+    }
+
+    // Push a table with a table made by a function for each entry of a list
+    template <typename Iterator, typename Function>
+    void setListField(lua_State *lua, const char *name, Iterator begin, Iterator end, Function pushEntry)
+    {
+        lua_createtable(lua, static_cast<int>(end - begin), 0);
+
+        int i = 1;
+        for (Iterator it = begin; it != end; ++it)
+        {
+            pushEntry(*it);
+            lua_rawseti(lua, -2, i++);
+        }
+
+        lua_setfield(lua, -2, name);
+    }
+
+    // Call a function with the index of each entry of a list in a field, returning whether the
+    // field was there
+    template <typename Function>
+    bool getListField(lua_State *lua, int index, const char *name, Function readEntry)
+    {
+        lua_getfield(lua, index, name);
+
+        const bool isTable = lua_istable(lua, -1);
+        LuaLists::forEachEntry(lua, -1, readEntry);
+
+        lua_pop(lua, 1);
+        return isTable;
+    }
+
+    const char *const dynamicStatNames[3][3] = {
+        {"healthBase", "healthCurrent", "healthModified"},
+        {"magickaBase", "magickaCurrent", "magickaModified"},
+        {"fatigueBase", "fatigueCurrent", "fatigueModified"}
+    };
+
+    void pushContainerItem(lua_State *lua, const ContainerItem &containerItem)
+    {
+        lua_createtable(lua, 0, 6);
+        setField(lua, "refId", containerItem.refId);
+        setField(lua, "count", containerItem.count);
+        setField(lua, "charge", containerItem.charge);
+        setField(lua, "enchantmentCharge", containerItem.enchantmentCharge);
+        setField(lua, "soul", containerItem.soul);
+        setField(lua, "actionCount", containerItem.actionCount);
+    }
+
+    void readContainerItem(lua_State *lua, int index, ContainerItem &containerItem)
+    {
+        getField(lua, index, "refId", containerItem.refId);
+        getField(lua, index, "count", containerItem.count);
+        getField(lua, index, "charge", containerItem.charge);
+        getField(lua, index, "enchantmentCharge", containerItem.enchantmentCharge);
+        getField(lua, index, "soul", containerItem.soul);
+        getField(lua, index, "actionCount", containerItem.actionCount);
+    }
+
+    void pushClientLocal(lua_State *lua, const ClientVariable &clientLocal)
+    {
+        lua_createtable(lua, 0, 4);
+        setField(lua, "internalIndex", clientLocal.internalIndex);
+        setField(lua, "variableType", static_cast<int>(clientLocal.variableType));
+        setField(lua, "intValue", clientLocal.intValue);
+        setField(lua, "floatValue", clientLocal.floatValue);
+    }
+
+    void readClientLocal(lua_State *lua, int index, ClientVariable &clientLocal)
+    {
+        int variableType = clientLocal.variableType;
+
+        getField(lua, index, "internalIndex", clientLocal.internalIndex);
+        getField(lua, index, "variableType", variableType);
+        getField(lua, index, "intValue", clientLocal.intValue);
+        getField(lua, index, "floatValue", clientLocal.floatValue);
+
+        clientLocal.variableType = static_cast<char>(variableType);
+    }
+
+    void pushActiveSpell(lua_State *lua, const ActiveSpell &spell)
+    {
+        lua_createtable(lua, 0, 5);
+        setField(lua, "id", spell.id);
+        setField(lua, "displayName", spell.params.mDisplayName);
+        setField(lua, "stackingState", spell.isStackingSpell);
+        setTargetField(lua, "caster", spell.caster);
+
+        setListField(lua, "effects", spell.params.mEffects.begin(), spell.params.mEffects.end(),
+            [lua](const ESM::ActiveEffect &effect) {
+                lua_createtable(lua, 0, 5);
+                setField(lua, "id", effect.mEffectId);
+                setField(lua, "arg", effect.mArg);
+                setField(lua, "magnitude", effect.mMagnitude);
+                setField(lua, "duration", effect.mDuration);
+                setField(lua, "timeLeft", effect.mTimeLeft);
+            });
+    }
+
+    void readActiveSpell(lua_State *lua, int index, ActiveSpell &spell)
+    {
+        getField(lua, index, "id", spell.id);
+        getField(lua, index, "displayName", spell.params.mDisplayName);
+        getField(lua, index, "stackingState", spell.isStackingSpell);
+        getTargetField(lua, index, "caster", spell.caster);
+
+        getListField(lua, index, "effects", [lua, &spell](int effectIndex) {
+            ESM::ActiveEffect effect = {};
+            getField(lua, effectIndex, "id", effect.mEffectId);
+            getField(lua, effectIndex, "arg", effect.mArg);
+            getField(lua, effectIndex, "magnitude", effect.mMagnitude);
+            getField(lua, effectIndex, "duration", effect.mDuration);
+            getField(lua, effectIndex, "timeLeft", effect.mTimeLeft);
+            spell.params.mEffects.push_back(effect);
+        });
+    }
+}
+
+void LuaLists::pushObjects(lua_State *lua, const std::vector<BaseObject> &objects)
+{
+    lua_createtable(lua, static_cast<int>(objects.size()), 0);
+
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        pushObject(lua, objects[i]);
+        lua_rawseti(lua, -2, static_cast<int>(i + 1));
+    }
+}
+
+void LuaLists::pushActors(lua_State *lua, const std::vector<BaseActor> &actors)
+{
+    lua_createtable(lua, static_cast<int>(actors.size()), 0);
+
+    for (std::size_t i = 0; i < actors.size(); ++i)
+    {
+        pushActor(lua, actors[i]);
+        lua_rawseti(lua, -2, static_cast<int>(i + 1));
+    }
+}
+
+void LuaLists::pushItems(lua_State *lua, const std::vector<Item> &items)
+{
+    lua_createtable(lua, static_cast<int>(items.size()), 0);
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        pushItem(lua, items[i]);
+        lua_rawseti(lua, -2, static_cast<int>(i + 1));
+    }
+}
+
+void LuaLists::pushObject(lua_State *lua, const BaseObject &object)
+{
+    lua_createtable(lua, 0, 48);
+    setField(lua, "refId", object.refId);
+    setField(lua, "refNum", object.refNum);
+    setField(lua, "mpNum", object.mpNum);
+    setField(lua, "count", object.count);
+    setField(lua, "charge", object.charge);
+    setField(lua, "enchantmentCharge", object.enchantmentCharge);
+    setField(lua, "soul", object.soul);
+    setField(lua, "goldValue", object.goldValue);
+    setField(lua, "scale", object.scale);
+    setField(lua, "state", object.objectState);
+    setField(lua, "doorState", object.doorState);
+    setField(lua, "lockLevel", object.lockLevel);
+    setField(lua, "disarmState", object.isDisarmed);
+    setField(lua, "droppedByPlayer", object.droppedByPlayer);
+    setField(lua, "isPlayer", object.isPlayer);
+    setPosition(lua, object.position);
+
+    if (object.isPlayer)
+        setPid(lua, object.guid);
+
+    setField(lua, "soundId", object.soundId);
+    setField(lua, "volume", object.volume);
+    setField(lua, "pitch", object.pitch);
+
+    setField(lua, "dialogueChoiceType", object.dialogueChoiceType);
+    setField(lua, "dialogueChoiceTopic", object.topicId);
+
+    setField(lua, "goldPool", object.goldPool);
+    setField(lua, "lastGoldRestockHour", object.lastGoldRestockHour);
+    setField(lua, "lastGoldRestockDay", object.lastGoldRestockDay);
+
+    setField(lua, "doorTeleportState", object.teleportState);
+    setField(lua, "doorDestinationCell", object.destinationCell.getShortDescription());
+    setPositionField(lua, "doorDestination", object.destinationPosition);
+
+    setField(lua, "videoFilename", object.videoFilename);
+    setField(lua, "animGroup", object.animGroup);
+    setField(lua, "animMode", object.animMode);
+
+    setTargetField(lua, "activating", object.activatingActor);
+
+    setTargetField(lua, "hitting", object.hittingActor);
+    setField(lua, "hitSuccess", object.hitAttack.success);
+    setField(lua, "hitDamage", object.hitAttack.damage);
+    setField(lua, "hitBlock", object.hitAttack.block);
+    setField(lua, "hitKnockdown", object.hitAttack.knockdown);
+
+    setField(lua, "summonState", object.isSummon);
+    setField(lua, "summonEffectId", object.summonEffectId);
+    setField(lua, "summonSpellId", object.summonSpellId);
+    setField(lua, "summonDuration", object.summonDuration);
+    setTargetField(lua, "summoner", object.master);
+
+    setListField(lua, "clientLocals", object.clientLocals.begin(), object.clientLocals.end(),
+        [lua](const ClientVariable &clientLocal) { pushClientLocal(lua, clientLocal); });
+
+    setField(lua, "hasContainer", object.hasContainer);
+
+    if (object.hasContainer)
+    {
+        setListField(lua, "containerItems", object.containerItems.begin(), object.containerItems.end(),
+            [lua](const ContainerItem &containerItem) { pushContainerItem(lua, containerItem); });
+    }
+}
+
+void LuaLists::pushActor(lua_State *lua, const BaseActor &actor)
+{
+    lua_createtable(lua, 0, 36);
+    setField(lua, "refId", actor.refId);
+    setField(lua, "refNum", actor.refNum);
+    setField(lua, "mpNum", actor.mpNum);
+    setField(lua, "cell", actor.cell.getShortDescription());
+    setPosition(lua, actor.position);
+    setField(lua, "hasPosition", actor.hasPositionData);
+
+    for (int stat = 0; stat < 3; ++stat)
+    {
+        setField(lua, dynamicStatNames[stat][0], actor.creatureStats.mDynamic[stat].mBase);
+        setField(lua, dynamicStatNames[stat][1], actor.creatureStats.mDynamic[stat].mCurrent);
+        setField(lua, dynamicStatNames[stat][2], actor.creatureStats.mDynamic[stat].mMod);
+    }
+
+    setField(lua, "hasStatsDynamic", actor.hasStatsDynamicData);
+
+    setListField(lua, "equipment", std::begin(actor.equipmentItems), std::end(actor.equipmentItems),
+        [lua](const Item &item) { pushItem(lua, item); });
+
+    setField(lua, "sound", actor.sound);
+
+    setField(lua, "deathState", static_cast<int>(actor.deathState));
+    setField(lua, "deathInstant", actor.isInstantDeath);
+    setTargetField(lua, "killer", actor.killer);
+
+    setField(lua, "aiAction", actor.aiAction);
+    setField(lua, "aiDistance", actor.aiDistance);
+    setField(lua, "aiDuration", actor.aiDuration);
+    setField(lua, "aiRepetition", actor.aiShouldRepeat);
+    setPositionField(lua, "aiCoordinates", actor.aiCoordinates);
+
+    if (actor.hasAiTarget)
+        setTargetField(lua, "aiTarget", actor.aiTarget);
+
+    setField(lua, "spellsActiveAction", actor.spellsActiveChanges.action);
+    setListField(lua, "spellsActive", actor.spellsActiveChanges.activeSpells.begin(),
+        actor.spellsActiveChanges.activeSpells.end(),
+        [lua](const ActiveSpell &spell) { pushActiveSpell(lua, spell); });
+}
+
+void LuaLists::pushItem(lua_State *lua, const Item &item)
+{
+    lua_createtable(lua, 0, 5);
+    setField(lua, "refId", item.refId);
+    setField(lua, "count", item.count);
+    setField(lua, "charge", item.charge);
+    setField(lua, "enchantmentCharge", item.enchantmentCharge);
+    setField(lua, "soul", item.soul);
+}
+
+void LuaLists::readObject(lua_State *lua, int index, BaseObject &object)
+{
+    getField(lua, index, "refId", object.refId);
+    getField(lua, index, "refNum", object.refNum);
+    getField(lua, index, "mpNum", object.mpNum);
+    getField(lua, index, "count", object.count);
+    getField(lua, index, "charge", object.charge);
+    getField(lua, index, "enchantmentCharge", object.enchantmentCharge);
+    getField(lua, index, "soul", object.soul);
+    getField(lua, index, "goldValue", object.goldValue);
+    getField(lua, index, "scale", object.scale);
+    getField(lua, index, "state", object.objectState);
+    getField(lua, index, "doorState", object.doorState);
+    getField(lua, index, "lockLevel", object.lockLevel);
+    getField(lua, index, "disarmState", object.isDisarmed);
+    getField(lua, index, "droppedByPlayer", object.droppedByPlayer);
+    getPosition(lua, index, object.position);
+
+    if (Player *player = getPlayerField(lua, index))
+    {
+        object.isPlayer = true;
+        object.guid = player->guid;
+    }
+
+    getField(lua, index, "soundId", object.soundId);
+    getField(lua, index, "volume", object.volume);
+    getField(lua, index, "pitch", object.pitch);
+
+    getField(lua, index, "dialogueChoiceType", object.dialogueChoiceType);
+    getField(lua, index, "dialogueChoiceTopic", object.topicId);
+
+    getField(lua, index, "goldPool", object.goldPool);
+    getField(lua, index, "lastGoldRestockHour", object.lastGoldRestockHour);
+    getField(lua, index, "lastGoldRestockDay", object.lastGoldRestockDay);
+
+    getField(lua, index, "doorTeleportState", object.teleportState);
+    getCellField(lua, index, "doorDestinationCell", object.destinationCell);
+    getPositionField(lua, index, "doorDestination", object.destinationPosition);
+
+    getField(lua, index, "videoFilename", object.videoFilename);
+    getField(lua, index, "animGroup", object.animGroup);
+    getField(lua, index, "animMode", object.animMode);
+
+    getTargetField(lua, index, "activating", object.activatingActor);
+
+    getTargetField(lua, index, "hitting", object.hittingActor);
+    getField(lua, index, "hitSuccess", object.hitAttack.success);
+    getField(lua, index, "hitDamage", object.hitAttack.damage);
+    getField(lua, index, "hitBlock", object.hitAttack.block);
+    getField(lua, index, "hitKnockdown", object.hitAttack.knockdown);
+
+    getField(lua, index, "summonState", object.isSummon);
+    getField(lua, index, "summonEffectId", object.summonEffectId);
+    getField(lua, index, "summonSpellId", object.summonSpellId);
+    getField(lua, index, "summonDuration", object.summonDuration);
+    getTargetField(lua, index, "summoner", object.master);
+
+    getListField(lua, index, "clientLocals", [lua, &object](int localIndex) {
+        ClientVariable clientLocal = {};
+        readClientLocal(lua, localIndex, clientLocal);
+        object.clientLocals.push_back(clientLocal);
+    });
+
+    getField(lua, index, "hasContainer", object.hasContainer);
+
+    getListField(lua, index, "containerItems", [lua, &object](int itemIndex) {
+        ContainerItem containerItem = {};
+        readContainerItem(lua, itemIndex, containerItem);
+        object.containerItems.push_back(containerItem);
+    });
+}
+
+void LuaLists::readActor(lua_State *lua, int index, BaseActor &actor)
+{
+    getField(lua, index, "refId", actor.refId);
+    getField(lua, index, "refNum", actor.refNum);
+    getField(lua, index, "mpNum", actor.mpNum);
+    getCellField(lua, index, "cell", actor.cell);
+    getPosition(lua, index, actor.position);
+
+    for (int stat = 0; stat < 3; ++stat)
+    {
+        getField(lua, index, dynamicStatNames[stat][0], actor.creatureStats.mDynamic[stat].mBase);
+        getField(lua, index, dynamicStatNames[stat][1], actor.creatureStats.mDynamic[stat].mCurrent);
+        getField(lua, index, dynamicStatNames[stat][2], actor.creatureStats.mDynamic[stat].mMod);
+    }
+
+    // Equipment is listed by slot, with the first entry for slot 0
+    std::size_t slot = 0;
+    getListField(lua, index, "equipment", [lua, &actor, &slot](int itemIndex) {
+        if (slot < sizeof(actor.equipmentItems) / sizeof(actor.equipmentItems[0]))
+            readItem(lua, itemIndex, actor.equipmentItems[slot++]);
+    });
+
+    getField(lua, index, "sound", actor.sound);
+
+    int deathState = actor.deathState;
+    getField(lua, index, "deathState", deathState);
+    actor.deathState = static_cast<char>(deathState);
+    getField(lua, index, "deathInstant", actor.isInstantDeath);
+    getTargetField(lua, index, "killer", actor.killer);
+
+    getField(lua, index, "aiAction", actor.aiAction);
+    getField(lua, index, "aiDistance", actor.aiDistance);
+    getField(lua, index, "aiDuration", actor.aiDuration);
+    getField(lua, index, "aiRepetition", actor.aiShouldRepeat);
+    getPositionField(lua, index, "aiCoordinates", actor.aiCoordinates);
+
+    if (getTargetField(lua, index, "aiTarget", actor.aiTarget))
+        actor.hasAiTarget = true;
+
+    getField(lua, index, "spellsActiveAction", actor.spellsActiveChanges.action);
+    getListField(lua, index, "spellsActive", [lua, &actor](int spellIndex) {
+        ActiveSpell spell = {};
+        readActiveSpell(lua, spellIndex, spell);
+        actor.spellsActiveChanges.activeSpells.push_back(spell);
+    });
+}
+
+void LuaLists::readItem(lua_State *lua, int index, Item &item)
+{
+    getField(lua, index, "refId", item.refId);
+    getField(lua, index, "count", item.count);
+    getField(lua, index, "charge", item.charge);
+    getField(lua, index, "enchantmentCharge", item.enchantmentCharge);
+    getField(lua, index, "soul", item.soul);
+}
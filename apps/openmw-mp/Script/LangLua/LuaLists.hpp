@@ -0,0 +1,62 @@
+#ifndef OPENMW_LUALISTS_HPP
+#define OPENMW_LUALISTS_HPP
+
+#include "lua.hpp"
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+/**
+ * Conversions between the lists in packets and Lua tables, so a script can read or build a whole
+ * list in a single call instead of making one call per field of every entry.
+ *
+ * Each entry is a table with fields named after the matching Get and Set functions, e.g. refId,
+ * count and posX. When reading a table into an entry, fields that are missing leave the entry's
+ * current values alone.
+ */
+namespace LuaLists
+{
+    // Push a table with a field for each object, actor or item, leaving it at the top of the stack
+    void pushObjects(lua_State *lua, const std::vector<mwmp::BaseObject> &objects);
+    void pushActors(lua_State *lua, const std::vector<mwmp::BaseActor> &actors);
+    void pushItems(lua_State *lua, const std::vector<mwmp::Item> &items);
+
+    void pushObject(lua_State *lua, const mwmp::BaseObject &object);
+    void pushActor(lua_State *lua, const mwmp::BaseActor &actor);
+    void pushItem(lua_State *lua, const mwmp::Item &item);
+
+    void readObject(lua_State *lua, int index, mwmp::BaseObject &object);
+    void readActor(lua_State *lua, int index, mwmp::BaseActor &actor);
+    void readItem(lua_State *lua, int index, mwmp::Item &item);
+
+    // Call a function with each entry of an array, in order, with the entry at the top of the stack.
+    // Stops at the first entry that isn't a table and returns the number of entries visited
+    template <typename Function>
+    unsigned int forEachEntry(lua_State *lua, int index, Function function)
+    {
+        if (!lua_istable(lua, index))
+            return 0;
+
+        if (index < 0)
+            index = lua_gettop(lua) + index + 1;
+
+        unsigned int count = 0;
+
+        for (int i = 1;; ++i)
+        {
+            lua_rawgeti(lua, index, i);
+
+            if (!lua_istable(lua, -1))
+            {
+                lua_pop(lua, 1);
+                return count;
+            }
+
+            function(lua_gettop(lua));
+            lua_pop(lua, 1);
+            ++count;
+        }
+    }
+}
+
+#endif //OPENMW_LUALISTS_HPP
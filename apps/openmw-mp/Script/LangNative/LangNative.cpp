@@ -78,6 +78,16 @@ boost::any LangNative::Call(const char *name, const char *argl, const std::vecto
     return nullptr;
 }
 
+int LangNative::GetCallbackHandle(const char *name)
+{
+    return -1;
+}
+
+void LangNative::CallCallback(int handle, const char *argl, int buf, ...)
+{
+
+}
+
 
 lib_t LangNative::GetInterface()
 {
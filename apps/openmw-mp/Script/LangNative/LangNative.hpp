@@ -17,6 +17,8 @@ public:
     virtual bool IsCallbackPresent(const char *name) override;
     virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
     virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
+    virtual int GetCallbackHandle(const char *name) override;
+    virtual void CallCallback(int handle, const char *argl, int buf, ...) override;
 
 };
 
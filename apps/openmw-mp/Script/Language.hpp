@@ -16,6 +16,11 @@ public:
     virtual boost::any Call(const char* name, const char* argl, int buf, ...) = 0;
     virtual boost::any Call(const char* name, const char* argl, const std::vector<boost::any>& args) = 0;
 
+    // Look a callback up once so it can be called without resolving its name every time,
+    // returning -1 if the script doesn't define it
+    virtual int GetCallbackHandle(const char* name) = 0;
+    virtual void CallCallback(int handle, const char* argl, int buf, ...) = 0;
+
     virtual lib_t GetInterface() = 0;
 
 };
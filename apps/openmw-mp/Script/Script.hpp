@@ -2,7 +2,7 @@
 #define PLUGINSYSTEM3_SCRIPT_HPP
 
 #include <boost/any.hpp>
-#include <unordered_map>
+#include <array>
 #include <memory>
 
 #include "Types.hpp"
@@ -12,6 +12,7 @@
 #include "Language.hpp"
 
 #include "Networking.hpp"
+#include "Telemetry.hpp"
 
 class Script : private ScriptFunctions
 {
@@ -40,7 +41,17 @@ private:
     }
 
     int script_type;
-    std::unordered_map<unsigned int, FunctionEllipsis<void>> callbacks_;
+    std::array<ScriptCallbackSlot, sizeof(callbacks) / sizeof(callbacks[0])> callbackSlots;
+
+    void ResolveCallback(ScriptCallbackSlot &slot, const char *name)
+    {
+        if (script_type == SCRIPT_CPP)
+            slot.function = GetScript<FunctionEllipsis<void>>(name);
+        else
+            slot.handle = lang->GetCallbackHandle(name);
+
+        slot.isResolved = true;
+    }
 
     typedef std::vector<std::unique_ptr<Script>> ScriptList;
     static ScriptList scripts;
@@ -61,8 +72,13 @@ public:
     static void SetModDir(const std::string &moddir);
     static const char* GetModDir();
 
-    static constexpr ScriptCallbackData const& CallBackData(const unsigned int I, const unsigned int N = 0) {
-        return callbacks[N].index == I ? callbacks[N] : CallBackData(I, N + 1);
+    // The position of a callback in ScriptFunctions::callbacks, which is also its slot in callbackSlots
+    static constexpr unsigned int CallbackSlot(const unsigned int I, const unsigned int N = 0) {
+        return callbacks[N].index == I ? N : CallbackSlot(I, N + 1);
+    }
+
+    static constexpr ScriptCallbackData const& CallBackData(const unsigned int I) {
+        return callbacks[CallbackSlot(I)];
     }
 
     template<size_t N>
@@ -73,30 +89,37 @@ public:
 
     template<unsigned int I, bool B = false, typename... Args>
     static unsigned int Call(Args&&... args) {
-        constexpr ScriptCallbackData const& data = CallBackData(I);
+        constexpr unsigned int slotIndex = CallbackSlot(I);
+        constexpr ScriptCallbackData const& data = callbacks[slotIndex];
         static_assert(data.callback.matches(TypeString<typename std::remove_reference<Args>::type...>::value),
                       "Wrong number or types of arguments");
 
         unsigned int count = 0;
+        mwmp::Telemetry::CallbackScope telemetryScope(data.name);
 
         for (auto& script : scripts)
         {
-            if (!script->callbacks_.count(I))
-                script->callbacks_.emplace(I, script->GetScript<FunctionEllipsis<void>>(data.name));
-
-            auto callback = script->callbacks_[I];
+            ScriptCallbackSlot &slot = script->callbackSlots[slotIndex];
 
-            if (!callback)
-                continue;
+            if (!slot.isResolved)
+                script->ResolveCallback(slot, data.name);
 
             if (script->script_type == SCRIPT_CPP)
-                (callback)(std::forward<Args>(args)...);
+            {
+                if (!slot.function)
+                    continue;
+
+                (slot.function)(std::forward<Args>(args)...);
+            }
 #if defined (ENABLE_LUA)
             else if (script->script_type == SCRIPT_LUA)
             {
+                if (slot.handle < 0)
+                    continue;
+
                 try
                 {
-                    script->lang->Call(data.name, data.callback.types, B, std::forward<Args>(args)...);
+                    script->lang->CallCallback(slot.handle, data.callback.types, B, std::forward<Args>(args)...);
                 }
                 catch (std::exception &e)
                 {
@@ -21,6 +21,7 @@
 #include <Script/Functions/Settings.hpp>
 #include <Script/Functions/Spells.hpp>
 #include <Script/Functions/Stats.hpp>
+#include <Script/Functions/Storage.hpp>
 #include <Script/Functions/Worldstate.hpp>
 #include <RakNetTypes.h>
 #include <tuple>
@@ -148,6 +149,7 @@ public:
             SETTINGSAPI,
             SPELLAPI,
             STATAPI,
+            STORAGEAPI,
             OBJECTAPI,
             WORLDSTATEAPI
     };
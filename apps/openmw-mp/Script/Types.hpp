@@ -116,6 +116,14 @@ struct ScriptFunctionData
     constexpr ScriptFunctionData(const char* name, ScriptFunctionPointer func) : name(name), func(func) {}
 };
 
+// A script's cached lookup of one callback, resolved the first time that callback is called
+struct ScriptCallbackSlot
+{
+    bool isResolved = false;
+    FunctionEllipsis<void> function = nullptr; // Native scripts
+    int handle = -1; // Other languages, as returned by Language::GetCallbackHandle()
+};
+
 struct ScriptCallbackData
 {
     const char* name;
@@ -0,0 +1,194 @@
+#include "Telemetry.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+#include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Packets/BasePacket.hpp>
+
+using namespace mwmp;
+
+std::array<Telemetry::PacketStats, 256> Telemetry::packetStats;
+std::unordered_map<const char *, Telemetry::CallbackStats> Telemetry::callbackStats;
+int Telemetry::currentPacketID = -1;
+unsigned int Telemetry::callbackDepth = 0;
+unsigned int Telemetry::dumpInterval = 0;
+std::string Telemetry::dumpPath;
+Telemetry::Clock::time_point Telemetry::lastDump = Telemetry::Clock::now();
+
+namespace
+{
+    double toMilliseconds(Telemetry::Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+Telemetry::PacketScope::PacketScope(uint8_t packetID, uint32_t length) : start(Clock::now()),
+    previousPacketID(currentPacketID)
+{
+    PacketStats &stats = packetStats[packetID];
+    stats.packetsReceived++;
+    stats.bytesReceived += length;
+    currentPacketID = packetID;
+}
+
+Telemetry::PacketScope::~PacketScope()
+{
+    packetStats[currentPacketID].processTime += Clock::now() - start;
+    currentPacketID = previousPacketID;
+}
+
+Telemetry::CallbackScope::CallbackScope(const char *name) : name(name), start(Clock::now())
+{
+    callbackDepth++;
+}
+
+Telemetry::CallbackScope::~CallbackScope()
+{
+    Clock::duration elapsed = Clock::now() - start;
+    callbackDepth--;
+
+    CallbackStats &stats = callbackStats[name];
+    stats.calls++;
+    stats.time += elapsed;
+
+    // Callbacks can trigger other callbacks, so only the outermost one counts towards the packet
+    if (callbackDepth == 0 && currentPacketID >= 0)
+        packetStats[currentPacketID].scriptTime += elapsed;
+}
+
+const Telemetry::PacketStats &Telemetry::getPacketStats(uint8_t packetID)
+{
+    return packetStats[packetID];
+}
+
+Telemetry::CallbackStats Telemetry::getCallbackStats(const std::string &name)
+{
+    // Callbacks are keyed by the address of their name in the callback table, so look them up
+    // by comparing the names themselves
+    for (const auto &callback : callbackStats)
+    {
+        if (name == callback.first)
+            return callback.second;
+    }
+
+    return CallbackStats();
+}
+
+void Telemetry::reset()
+{
+    packetStats.fill(PacketStats());
+    callbackStats.clear();
+    BasePacket::resetTraffic();
+}
+
+void Telemetry::setDumpInterval(unsigned int seconds)
+{
+    dumpInterval = seconds;
+}
+
+void Telemetry::setDumpPath(const std::string &path)
+{
+    dumpPath = path;
+}
+
+void Telemetry::update()
+{
+    if (dumpInterval == 0)
+        return;
+
+    Clock::time_point now = Clock::now();
+
+    if (now - lastDump < std::chrono::seconds(dumpInterval))
+        return;
+
+    lastDump = now;
+
+    if (dumpPath.empty())
+        logSummary();
+    else if (!writeCsv(dumpPath))
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Could not write telemetry to %s", dumpPath.c_str());
+}
+
+bool Telemetry::writeCsv(const std::string &path)
+{
+    std::ofstream file(path, std::ios::app);
+
+    if (!file)
+        return false;
+
+    if (file.tellp() == 0)
+        file << "time,type,id,count,bytesReceived,bytesSerialized,bytesSent,processMs,scriptMs,serializeMs\n";
+
+    long long timestamp = static_cast<long long>(std::time(nullptr));
+
+    for (unsigned int packetID = 0; packetID < packetStats.size(); packetID++)
+    {
+        const PacketStats &stats = packetStats[packetID];
+        const PacketTraffic &traffic = BasePacket::getTraffic(static_cast<uint8_t>(packetID));
+
+        if (stats.packetsReceived == 0 && traffic.packetsSerialized == 0)
+            continue;
+
+        file << timestamp << ",packet," << packetID << "," << stats.packetsReceived << "," << stats.bytesReceived
+            << "," << traffic.bytesSerialized << "," << traffic.bytesSent << "," << toMilliseconds(stats.processTime)
+            << "," << toMilliseconds(stats.scriptTime) << "," << toMilliseconds(traffic.serializeTime) << "\n";
+    }
+
+    for (const auto &callback : callbackStats)
+    {
+        file << timestamp << ",callback," << callback.first << "," << callback.second.calls << ",0,0,0,0,"
+            << toMilliseconds(callback.second.time) << ",0\n";
+    }
+
+    return static_cast<bool>(file);
+}
+
+void Telemetry::logSummary()
+{
+    const size_t maxEntries = 10;
+
+    std::vector<unsigned int> packetIDs;
+    for (unsigned int packetID = 0; packetID < packetStats.size(); packetID++)
+    {
+        if (packetStats[packetID].packetsReceived > 0)
+            packetIDs.push_back(packetID);
+    }
+
+    std::sort(packetIDs.begin(), packetIDs.end(), [](unsigned int a, unsigned int b)
+    {
+        return packetStats[a].processTime > packetStats[b].processTime;
+    });
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Telemetry for the most expensive packets received:");
+
+    for (size_t i = 0; i < packetIDs.size() && i < maxEntries; i++)
+    {
+        const PacketStats &stats = packetStats[packetIDs[i]];
+        const PacketTraffic &traffic = BasePacket::getTraffic(static_cast<uint8_t>(packetIDs[i]));
+
+        LOG_APPEND(TimedLog::LOG_INFO, "- %u: %llu received (%llu bytes), %.2f ms processing of which %.2f ms in scripts, "
+            "%llu bytes sent", packetIDs[i], (unsigned long long) stats.packetsReceived,
+            (unsigned long long) stats.bytesReceived, toMilliseconds(stats.processTime),
+            toMilliseconds(stats.scriptTime), (unsigned long long) traffic.bytesSent);
+    }
+
+    std::vector<std::pair<const char *, CallbackStats>> callbacks(callbackStats.begin(), callbackStats.end());
+
+    std::sort(callbacks.begin(), callbacks.end(), [](const std::pair<const char *, CallbackStats> &a,
+        const std::pair<const char *, CallbackStats> &b)
+    {
+        return a.second.time > b.second.time;
+    });
+
+    LOG_APPEND(TimedLog::LOG_INFO, "Telemetry for the most expensive script callbacks:");
+
+    for (size_t i = 0; i < callbacks.size() && i < maxEntries; i++)
+    {
+        LOG_APPEND(TimedLog::LOG_INFO, "- %s: %llu calls, %.2f ms", callbacks[i].first,
+            (unsigned long long) callbacks[i].second.calls, toMilliseconds(callbacks[i].second.time));
+    }
+}
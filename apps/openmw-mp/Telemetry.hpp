@@ -0,0 +1,93 @@
+#ifndef OPENMW_TELEMETRY_HPP
+#define OPENMW_TELEMETRY_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace mwmp
+{
+    /**
+     * Per-packet-ID and per-script-callback counters for profiling a running server.
+     *
+     * Received packets are timed from the moment they are dispatched until their processor
+     * returns, and the part of that spent inside script callbacks is tracked separately.
+     * Bytes and time spent serializing outgoing packets are kept by BasePacket::getTraffic().
+     *
+     * All counters are cumulative since startup or the last reset. When a dump interval is set,
+     * they are periodically appended to a CSV file or, without a file, summarized in the log.
+     */
+    class Telemetry
+    {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        struct PacketStats
+        {
+            uint64_t packetsReceived = 0;
+            uint64_t bytesReceived = 0;
+            Clock::duration processTime = Clock::duration::zero();
+            Clock::duration scriptTime = Clock::duration::zero();
+        };
+
+        struct CallbackStats
+        {
+            uint64_t calls = 0;
+            Clock::duration time = Clock::duration::zero();
+        };
+
+        // Times the processing of one received packet
+        class PacketScope
+        {
+        public:
+            PacketScope(uint8_t packetID, uint32_t length);
+            ~PacketScope();
+
+        private:
+            Clock::time_point start;
+            int previousPacketID;
+        };
+
+        // Times one script callback across every loaded script
+        class CallbackScope
+        {
+        public:
+            explicit CallbackScope(const char *name);
+            ~CallbackScope();
+
+        private:
+            const char *name;
+            Clock::time_point start;
+        };
+
+        static const PacketStats &getPacketStats(uint8_t packetID);
+        static CallbackStats getCallbackStats(const std::string &name);
+
+        static void reset();
+
+        static void setDumpInterval(unsigned int seconds);
+        static void setDumpPath(const std::string &path);
+
+        // Called once per tick to dump the counters when the dump interval has passed
+        static void update();
+
+        static bool writeCsv(const std::string &path);
+        static void logSummary();
+
+    private:
+        static std::array<PacketStats, 256> packetStats;
+        static std::unordered_map<const char *, CallbackStats> callbackStats;
+
+        // The packet being processed, or -1 outside of packet processing
+        static int currentPacketID;
+        static unsigned int callbackDepth;
+
+        static unsigned int dumpInterval;
+        static std::string dumpPath;
+        static Clock::time_point lastDump;
+    };
+}
+
+#endif //OPENMW_TELEMETRY_HPP
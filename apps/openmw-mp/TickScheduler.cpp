@@ -0,0 +1,114 @@
+#include "TickScheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+
+using namespace mwmp;
+
+TickScheduler::TickScheduler() : tickRate(1000), idleTickRate(10), maxPacketsPerTick(1000), windowTicks(0),
+    windowPackets(0), windowTickTime(0), windowMaxTickTime(0), ticksPerSecond(0), averageTickTime(0),
+    maximumTickTime(0), averagePacketsPerTick(0)
+{
+    tickStart = Clock::now();
+    windowStart = tickStart;
+}
+
+void TickScheduler::setTickRate(unsigned int ticksPerSecond)
+{
+    tickRate = std::max(1u, ticksPerSecond);
+}
+
+void TickScheduler::setIdleTickRate(unsigned int ticksPerSecond)
+{
+    idleTickRate = std::max(1u, ticksPerSecond);
+}
+
+void TickScheduler::setMaxPacketsPerTick(unsigned int packetCount)
+{
+    maxPacketsPerTick = std::max(1u, packetCount);
+}
+
+unsigned int TickScheduler::getTickRate() const
+{
+    return tickRate;
+}
+
+unsigned int TickScheduler::getIdleTickRate() const
+{
+    return idleTickRate;
+}
+
+unsigned int TickScheduler::getMaxPacketsPerTick() const
+{
+    return maxPacketsPerTick;
+}
+
+void TickScheduler::beginTick()
+{
+    tickStart = Clock::now();
+}
+
+void TickScheduler::endTick(unsigned int packetCount, bool hasConnections, long msecUntilTimer)
+{
+    Clock::time_point now = Clock::now();
+    updateStatistics(now, now - tickStart, packetCount);
+
+    // More packets may already be queued, so don't wait before the next batch
+    if (packetCount > 0)
+        return;
+
+    // RakPeer offers no way of blocking until a packet arrives, so an empty tick sleeps until
+    // the next timer is due, but never longer than the tick rate allows
+    Clock::time_point wakeTime = tickStart + std::chrono::microseconds(1000000 / (hasConnections ? tickRate : idleTickRate));
+
+    if (msecUntilTimer >= 0)
+        wakeTime = std::min(wakeTime, now + std::chrono::milliseconds(msecUntilTimer));
+
+    if (wakeTime > now)
+        std::this_thread::sleep_until(wakeTime);
+}
+
+unsigned int TickScheduler::getTicksPerSecond() const
+{
+    return ticksPerSecond;
+}
+
+double TickScheduler::getAverageTickTime() const
+{
+    return averageTickTime;
+}
+
+double TickScheduler::getMaximumTickTime() const
+{
+    return maximumTickTime;
+}
+
+double TickScheduler::getAveragePacketsPerTick() const
+{
+    return averagePacketsPerTick;
+}
+
+void TickScheduler::updateStatistics(Clock::time_point now, Clock::duration tickTime, unsigned int packetCount)
+{
+    windowTicks++;
+    windowPackets += packetCount;
+    windowTickTime += tickTime;
+    windowMaxTickTime = std::max(windowMaxTickTime, tickTime);
+
+    if (now - windowStart < std::chrono::seconds(1))
+        return;
+
+    typedef std::chrono::duration<double, std::milli> Milliseconds;
+    typedef std::chrono::duration<double> Seconds;
+
+    ticksPerSecond = static_cast<unsigned int>(windowTicks / std::chrono::duration_cast<Seconds>(now - windowStart).count() + 0.5);
+    averageTickTime = std::chrono::duration_cast<Milliseconds>(windowTickTime).count() / windowTicks;
+    maximumTickTime = std::chrono::duration_cast<Milliseconds>(windowMaxTickTime).count();
+    averagePacketsPerTick = static_cast<double>(windowPackets) / windowTicks;
+
+    windowStart = now;
+    windowTicks = 0;
+    windowPackets = 0;
+    windowTickTime = Clock::duration::zero();
+    windowMaxTickTime = Clock::duration::zero();
+}
@@ -0,0 +1,71 @@
+#ifndef OPENMW_TICKSCHEDULER_HPP
+#define OPENMW_TICKSCHEDULER_HPP
+
+#include <chrono>
+
+namespace mwmp
+{
+    /**
+     * Paces the server's main loop.
+     *
+     * Incoming packets are handled in batches of at most maxPacketsPerTick, after which the loop
+     * is free to run timers. A tick that handled packets is followed by another one right away,
+     * while an empty tick waits until the next timer deadline, capped by the configured tick rate
+     * (or the idle tick rate when nobody is connected), so an idle server doesn't spin.
+     */
+    class TickScheduler
+    {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        TickScheduler();
+
+        void setTickRate(unsigned int ticksPerSecond);
+        void setIdleTickRate(unsigned int ticksPerSecond);
+        void setMaxPacketsPerTick(unsigned int packetCount);
+
+        unsigned int getTickRate() const;
+        unsigned int getIdleTickRate() const;
+        unsigned int getMaxPacketsPerTick() const;
+
+        void beginTick();
+
+        /**
+         * Finish the current tick and wait for the next one.
+         *
+         * \param packetCount The number of packets handled during this tick.
+         * \param hasConnections Whether any peer is connected.
+         * \param msecUntilTimer Milliseconds until the next script timer is due, or a negative
+         *                       value if no timer is running.
+         */
+        void endTick(unsigned int packetCount, bool hasConnections, long msecUntilTimer);
+
+        // Statistics over the last completed one-second window
+        unsigned int getTicksPerSecond() const;
+        double getAverageTickTime() const;
+        double getMaximumTickTime() const;
+        double getAveragePacketsPerTick() const;
+
+    private:
+        void updateStatistics(Clock::time_point now, Clock::duration tickTime, unsigned int packetCount);
+
+        unsigned int tickRate;
+        unsigned int idleTickRate;
+        unsigned int maxPacketsPerTick;
+
+        Clock::time_point tickStart;
+
+        Clock::time_point windowStart;
+        unsigned int windowTicks;
+        unsigned int windowPackets;
+        Clock::duration windowTickTime;
+        Clock::duration windowMaxTickTime;
+
+        unsigned int ticksPerSecond;
+        double averageTickTime;
+        double maximumTickTime;
+        double averagePacketsPerTick;
+    };
+}
+
+#endif //OPENMW_TICKSCHEDULER_HPP
@@ -23,6 +23,7 @@
 #include "Player.hpp"
 #include "Networking.hpp"
 #include "MasterClient.hpp"
+#include "Telemetry.hpp"
 #include "Utils.hpp"
 
 #include <apps/openmw-mp/Script/Script.hpp>
@@ -268,6 +269,14 @@ int main(int argc, char *argv[])
         Networking networking(peer);
         networking.setServerPassword(password);
 
+        networking.getTickScheduler().setTickRate((unsigned) mgr.getInt("tickRate", "General"));
+        networking.getTickScheduler().setIdleTickRate((unsigned) mgr.getInt("idleTickRate", "General"));
+        networking.getTickScheduler().setMaxPacketsPerTick((unsigned) mgr.getInt("maximumPacketsPerTick", "General"));
+        networking.getPacketDecoder().setThreadCount((unsigned) mgr.getInt("packetDecodeThreads", "General"));
+
+        Telemetry::setDumpInterval((unsigned) mgr.getInt("telemetryInterval", "General"));
+        Telemetry::setDumpPath(mgr.getString("telemetryPath", "General"));
+
         if (mgr.getBool("enabled", "MasterServer"))
         {
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sharing server query info to master enabled.");
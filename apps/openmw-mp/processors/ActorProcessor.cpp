@@ -11,33 +11,35 @@ void ActorProcessor::Do(ActorPacket &packet, Player &player, BaseActorList &acto
     packet.Send(true);
 }
 
-bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept
+bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList, bool isDecoded) noexcept
 {
-    // Clear our BaseActorList before loading new data in it
-    actorList.cell.blank();
-    actorList.baseActors.clear();
-    actorList.guid = packet.guid;
+    auto processor = GetProcessor(packet.data[0]);
 
-    for (auto &processor : processors)
+    if (processor == nullptr)
+        return false;
+
+    Player *player = Players::getPlayer(packet.guid);
+    ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+
+    // A list decoded by the PacketDecoder already holds the packet's data
+    if (!isDecoded)
     {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+        // Clear our BaseActorList before loading new data in it
+        actorList.cell.blank();
+        actorList.baseActors.clear();
+        actorList.guid = packet.guid;
+        actorList.isValid = true;
+    }
 
-            myPacket->setActorList(&actorList);
-            actorList.isValid = true;
+    myPacket->setActorList(&actorList);
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+    if (!processor->avoidReading && !isDecoded)
+        myPacket->Read();
 
-            if (actorList.isValid)
-                processor.second->Do(*myPacket, *player, actorList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
+    if (actorList.isValid)
+        processor->Do(*myPacket, *player, actorList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
 
-            return true;
-        }
-    }
-    return false;
+    return true;
 }
@@ -11,33 +11,36 @@ void ObjectProcessor::Do(ObjectPacket &packet, Player &player, BaseObjectList &o
     packet.Send(true);
 }
 
-bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
+bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList, bool isDecoded) noexcept
 {
-    // Clear our BaseObjectList before loading new data in it
-    objectList.cell.blank();
-    objectList.baseObjects.clear();
-    objectList.guid = packet.guid;
+    auto processor = GetProcessor(packet.data[0]);
 
-    for (auto &processor : processors)
+    if (processor == nullptr)
+        return false;
+
+    Player *player = Players::getPlayer(packet.guid);
+    ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
+
+    // A list decoded by the PacketDecoder already holds the packet's data
+    if (!isDecoded)
     {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
-
-            myPacket->setObjectList(&objectList);
-            objectList.isValid = true;
-
-            if (!processor.second->avoidReading)
-                myPacket->Read();
-
-            if (objectList.isValid)
-                processor.second->Do(*myPacket, *player, objectList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-            
-            return true;
-        }
+        // Clear our BaseObjectList before loading new data in it
+        objectList.cell.blank();
+        objectList.baseObjects.clear();
+        objectList.guid = packet.guid;
+        objectList.isValid = true;
     }
-    return false;
+
+    myPacket->setObjectList(&objectList);
+    myPacket->setStringTables(&player->getStringTables());
+
+    if (!processor->avoidReading && !isDecoded)
+        myPacket->Read();
+
+    if (objectList.isValid)
+        processor->Do(*myPacket, *player, objectList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
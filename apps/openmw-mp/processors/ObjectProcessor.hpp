@@ -17,7 +17,7 @@ namespace mwmp
 
         virtual void Do(ObjectPacket &packet, Player &player, BaseObjectList &objectList);
 
-        static bool Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept;
+        static bool Process(RakNet::Packet &packet, BaseObjectList &objectList, bool isDecoded = false) noexcept;
     };
 }
 
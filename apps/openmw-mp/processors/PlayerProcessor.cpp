@@ -6,22 +6,22 @@ using namespace mwmp;
 template<class T>
 typename BasePacketProcessor<T>::processors_t BasePacketProcessor<T>::processors;
 
-bool PlayerProcessor::Process(RakNet::Packet &packet) noexcept
+bool PlayerProcessor::Process(RakNet::Packet &packet, bool isDecoded) noexcept
 {
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            PlayerPacket *myPacket = Networking::get().getPlayerPacketController()->GetPacket(packet.data[0]);
-            myPacket->setPlayer(player);
+    auto processor = GetProcessor(packet.data[0]);
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+    if (processor == nullptr)
+        return false;
 
-            processor.second->Do(*myPacket, *player);
-            return true;
-        }
-    }
-    return false;
+    Player *player = Players::getPlayer(packet.guid);
+    PlayerPacket *myPacket = Networking::get().getPlayerPacketController()->GetPacket(packet.data[0]);
+    myPacket->setPlayer(player);
+    myPacket->setStringTables(&player->getStringTables());
+
+    // A player's data is moved over from the PacketDecoder before a decoded packet gets here
+    if (!processor->avoidReading && !isDecoded)
+        myPacket->Read();
+
+    processor->Do(*myPacket, *player);
+    return true;
 }
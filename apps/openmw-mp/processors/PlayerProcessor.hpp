@@ -14,7 +14,7 @@ namespace mwmp
 
         virtual void Do(PlayerPacket &packet, Player &player) = 0;
 
-        static bool Process(RakNet::Packet &packet) noexcept;
+        static bool Process(RakNet::Packet &packet, bool isDecoded = false) noexcept;
     };
 }
 
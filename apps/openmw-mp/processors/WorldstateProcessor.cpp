@@ -15,26 +15,24 @@ bool WorldstateProcessor::Process(RakNet::Packet &packet, BaseWorldstate &worlds
 {
     worldstate.guid = packet.guid;
 
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            WorldstatePacket *myPacket = Networking::get().getWorldstatePacketController()->GetPacket(packet.data[0]);
-
-            myPacket->setWorldstate(&worldstate);
-            worldstate.isValid = true;
-
-            if (!processor.second->avoidReading)
-                myPacket->Read();
-
-            if (worldstate.isValid)
-                processor.second->Do(*myPacket, *player, worldstate);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-            
-            return true;
-        }
-    }
-    return false;
+    auto processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    Player *player = Players::getPlayer(packet.guid);
+    WorldstatePacket *myPacket = Networking::get().getWorldstatePacketController()->GetPacket(packet.data[0]);
+
+    myPacket->setWorldstate(&worldstate);
+    worldstate.isValid = true;
+
+    if (!processor->avoidReading)
+        myPacket->Read();
+
+    if (worldstate.isValid)
+        processor->Do(*myPacket, *player, worldstate);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
@@ -2,6 +2,11 @@
 #define OPENMW_PROCESSORPLAYERPOSITION_HPP
 
 #include "../PlayerProcessor.hpp"
+#include "apps/openmw-mp/Networking.hpp"
+
+#include <components/openmw-mp/Base/BaseSystem.hpp>
+#include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
+#include <components/openmw-mp/Packets/Player/PacketPlayerPositionCompact.hpp>
 
 namespace mwmp
 {
@@ -15,7 +20,59 @@ namespace mwmp
 
         void Do(PlayerPacket &packet, Player &player) override
         {
-            player.sendToLoaded(&packet);
+            const InterestBands &interestBands = Networking::get().getPositionInterestBands();
+
+            // Players farther away only get every Nth position update, except for the one that
+            // stops the player, which everyone needs
+            unsigned int updateCount = player.incrementPositionUpdateCount();
+            bool endsMovement = player.updateEndsMovement();
+            std::vector<Player*> recipients;
+
+            player.forEachLoaded([&interestBands, &recipients, updateCount, endsMovement](Player *pl, Player *other)
+            {
+                if (!interestBands.isEnabled() ||
+                    interestBands.shouldRelay(pl->getDistanceSquared(other), updateCount, other->getId(), endsMovement))
+                    recipients.push_back(other);
+            });
+
+            // Clients that support it get the compact form, as a delta once they have acknowledged
+            // the current keyframe and as that keyframe again until they do; acknowledgements of
+            // earlier keyframes are dropped, so a wrapped around id can never match a stale one
+            if (PacketPlayerPositionCompact::updateBaseline(player))
+                Players::forgetPositionKeyframes(player.guid);
+            const uint8_t keyframeId = player.positionBaseline.keyframeId;
+
+            std::vector<RakNet::RakNetGUID> legacyRecipients;
+            std::vector<RakNet::RakNetGUID> keyframeRecipients;
+            std::vector<RakNet::RakNetGUID> deltaRecipients;
+
+            for (Player *other : recipients)
+            {
+                if (!other->hasCapability(mwmp::BaseSystem::COMPACT_POSITION))
+                    legacyRecipients.push_back(other->guid);
+                else if (!other->hasPositionKeyframe(player.guid, keyframeId))
+                    keyframeRecipients.push_back(other->guid);
+                else
+                    deltaRecipients.push_back(other->guid);
+            }
+
+            packet.setPlayer(&player);
+            packet.Send(legacyRecipients);
+
+            auto compactPacket = static_cast<PacketPlayerPositionCompact *>(
+                Networking::get().getPlayerPacketController()->GetPacket(ID_PLAYER_POSITION_COMPACT));
+            compactPacket->setPlayer(&player);
+            compactPacket->setEndsMovement(endsMovement);
+
+            std::vector<uint32_t> receipts;
+            compactPacket->setKeyframe(true);
+            compactPacket->Send(keyframeRecipients, receipts);
+
+            for (std::size_t i = 0; i < receipts.size(); ++i)
+                Networking::getPtr()->addPositionKeyframeReceipt(receipts[i], keyframeRecipients[i], player.guid, keyframeId);
+
+            compactPacket->setKeyframe(false);
+            compactPacket->Send(deltaRecipients);
         }
     };
 }
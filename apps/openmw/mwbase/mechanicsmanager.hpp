@@ -64,6 +64,17 @@ namespace MWBase
             virtual void updateCell(const MWWorld::Ptr &old, const MWWorld::Ptr &ptr) = 0;
             ///< Moves an object to a new cell
 
+            /*
+                Start of tes3mp addition
+
+                Let actors be found by their position without going through all of them
+            */
+            virtual void updatePosition(const MWWorld::Ptr &ptr) = 0;
+            ///< Notify that an object has moved
+            /*
+                End of tes3mp addition
+            */
+
             virtual void drop (const MWWorld::CellStore *cellStore) = 0;
             ///< Deregister all objects in the given cell.
 
@@ -97,6 +97,7 @@ namespace MWWorld
     class TimeStamp;
     class ESMStore;
     class RefData;
+    class CellRefCache;
 
     typedef std::vector<std::pair<MWWorld::Ptr,MWMechanics::Movement> > PtrMovementList;
 }
@@ -182,6 +183,16 @@ namespace MWBase
 
             virtual std::vector<ESM::ESMReader>& getEsmReader() = 0;
 
+            /*
+                Start of tes3mp addition
+
+                Make it possible to get the references of cells without reading them from the content files again
+            */
+            virtual MWWorld::CellRefCache& getCellRefCache() = 0;
+            /*
+                End of tes3mp addition
+            */
+
             virtual MWWorld::LocalScripts& getLocalScripts() = 0;
 
             virtual bool hasCellChanged() const = 0;
@@ -0,0 +1,201 @@
+#ifndef GAME_MWMECHANICS_ACTORGRID_H
+#define GAME_MWMECHANICS_ACTORGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <osg/Vec3f>
+
+namespace MWMechanics
+{
+    /// \brief Uniform grid of actor positions on the horizontal plane, to find the actors near a point
+    /// without going through all of them
+    ///
+    /// Each actor is kept in the grid cell its position falls in, so a search only looks at the cells
+    /// overlapping the searched circle. Positions are as recent as the last update() for each actor, and
+    /// distances are measured in 3D against those positions.
+    ///
+    /// \note Key needs operator== and operator<, which is also the order actors are found in.
+    template <class Key>
+    class ActorGrid
+    {
+        public:
+
+            explicit ActorGrid(float cellSize) : mCellSize(cellSize) {}
+
+            /// Set the position of an actor, adding it if it's not in the grid.
+            void update(const Key& key, const osg::Vec3f& position)
+            {
+                const std::uint64_t cell = getCell(position);
+                const auto inserted = mCellsByKey.emplace(key, cell);
+
+                if (!inserted.second)
+                {
+                    std::uint64_t& oldCell = inserted.first->second;
+
+                    if (oldCell == cell)
+                    {
+                        find(key, cell)->mPosition = position;
+                        return;
+                    }
+
+                    removeFromCell(key, oldCell);
+                    oldCell = cell;
+                }
+
+                mCells[cell].push_back(Item {key, position});
+            }
+
+            void remove(const Key& key)
+            {
+                const auto it = mCellsByKey.find(key);
+                if (it == mCellsByKey.end())
+                    return;
+
+                removeFromCell(key, it->second);
+                mCellsByKey.erase(it);
+            }
+
+            void clear()
+            {
+                mCellsByKey.clear();
+                mCells.clear();
+            }
+
+            std::size_t size() const
+            {
+                return mCellsByKey.size();
+            }
+
+            /// Append the actors within \a radius of \a position to \a out.
+            void getInRange(const osg::Vec3f& position, float radius, std::vector<Key>& out) const
+            {
+                const std::size_t begin = out.size();
+
+                forEachCandidate(position, radius, [&] (const Key& key, const osg::Vec3f& keyPosition)
+                {
+                    if ((keyPosition - position).length2() <= radius * radius)
+                        out.push_back(key);
+                    return true;
+                });
+
+                std::sort(out.begin() + begin, out.end());
+            }
+
+            bool isAnyInRange(const osg::Vec3f& position, float radius) const
+            {
+                bool found = false;
+
+                forEachCandidate(position, radius, [&] (const Key& /*key*/, const osg::Vec3f& keyPosition)
+                {
+                    found = (keyPosition - position).length2() <= radius * radius;
+                    return !found;
+                });
+
+                return found;
+            }
+
+        private:
+
+            struct Item
+            {
+                Key mKey;
+                osg::Vec3f mPosition;
+            };
+
+            const float mCellSize;
+            std::map<Key, std::uint64_t> mCellsByKey;
+            // Ordered by row, then column, so each row of a search is a single range of cells
+            std::map<std::uint64_t, std::vector<Item>> mCells;
+
+            int getCellIndex(float coordinate) const
+            {
+                return static_cast<int>(std::floor(coordinate / mCellSize));
+            }
+
+            // Flip the sign bits to keep negative indices ordered before positive ones
+            static std::uint64_t makeCell(int x, int y)
+            {
+                return static_cast<std::uint64_t>(static_cast<std::uint32_t>(x) ^ 0x80000000u) << 32
+                    | (static_cast<std::uint32_t>(y) ^ 0x80000000u);
+            }
+
+            static int getCellX(std::uint64_t cell)
+            {
+                return static_cast<std::int32_t>(static_cast<std::uint32_t>(cell >> 32) ^ 0x80000000u);
+            }
+
+            static int getCellY(std::uint64_t cell)
+            {
+                return static_cast<std::int32_t>(static_cast<std::uint32_t>(cell) ^ 0x80000000u);
+            }
+
+            std::uint64_t getCell(const osg::Vec3f& position) const
+            {
+                return makeCell(getCellIndex(position.x()), getCellIndex(position.y()));
+            }
+
+            Item* find(const Key& key, std::uint64_t cell)
+            {
+                std::vector<Item>& items = mCells.find(cell)->second;
+                return &*std::find_if(items.begin(), items.end(), [&] (const Item& item) { return item.mKey == key; });
+            }
+
+            void removeFromCell(const Key& key, std::uint64_t cell)
+            {
+                const auto it = mCells.find(cell);
+                std::vector<Item>& items = it->second;
+                Item* const item = find(key, cell);
+
+                *item = std::move(items.back());
+                items.pop_back();
+
+                if (items.empty())
+                    mCells.erase(it);
+            }
+
+            /// Call \a function with the actors of every cell overlapping the searched circle until it returns false.
+            template <class Function>
+            void forEachCandidate(const osg::Vec3f& position, float radius, Function&& function) const
+            {
+                const int minX = getCellIndex(position.x() - radius);
+                const int maxX = getCellIndex(position.x() + radius);
+                const int minY = getCellIndex(position.y() - radius);
+                const int maxY = getCellIndex(position.y() + radius);
+
+                const auto visit = [&] (const std::vector<Item>& items)
+                {
+                    for (const Item& item : items)
+                        if (!function(item.mKey, item.mPosition))
+                            return false;
+                    return true;
+                };
+
+                // A search wider than the populated area only needs to look at the cells that have actors
+                if (static_cast<std::uint64_t>(static_cast<std::int64_t>(maxX) - minX) >= mCells.size())
+                {
+                    for (const auto& cell : mCells)
+                    {
+                        const int x = getCellX(cell.first);
+                        const int y = getCellY(cell.first);
+                        if (x >= minX && x <= maxX && y >= minY && y <= maxY && !visit(cell.second))
+                            return;
+                    }
+                    return;
+                }
+
+                for (int x = minX; x <= maxX; ++x)
+                {
+                    const std::uint64_t last = makeCell(x, maxY);
+                    for (auto it = mCells.lower_bound(makeCell(x, minY)); it != mCells.end() && it->first <= last; ++it)
+                        if (!visit(it->second))
+                            return;
+                }
+            }
+    };
+}
+
+#endif
@@ -67,12 +67,43 @@
 namespace
 {
 
+/*
+    Start of tes3mp addition
+
+    Size of the cells of the grid that actors are indexed in, half the width of an exterior cell
+*/
+const float actorGridCellSize = 4096.f;
+/*
+    End of tes3mp addition
+*/
+
 bool isConscious(const MWWorld::Ptr& ptr)
 {
     const MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
     return !stats.isDead() && !stats.getKnockedDown();
 }
 
+/*
+    Start of tes3mp addition
+
+    Get the head tracking distance on its own, to only look for targets within it
+*/
+float getMaxHeadTrackDistance(const MWWorld::Ptr& actor)
+{
+    static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+            .find("fMaxHeadTrackDistance")->mValue.getFloat();
+    static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+            .find("fInteriorHeadTrackMult")->mValue.getFloat();
+    float maxDistance = fMaxHeadTrackDistance;
+    const ESM::Cell* currentCell = actor.getCell()->getCell();
+    if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
+        maxDistance *= fInteriorHeadTrackMult;
+    return maxDistance;
+}
+/*
+    End of tes3mp addition
+*/
+
 int getBoundItemSlot (const std::string& itemId)
 {
     static std::map<std::string, int> boundItemsMap;
@@ -343,11 +374,11 @@ namespace MWMechanics
                 Send PlayerInventory packets that replace the original gem with the new one
             */
             mwmp::LocalPlayer *localPlayer = mwmp::Main::get().getLocalPlayer();
-            localPlayer->sendItemChange(*gem, 1, mwmp::InventoryChanges::REMOVE);
+            localPlayer->queueItemChange(*gem, 1, mwmp::InventoryChanges::REMOVE);
 
             gem->getCellRef().setSoul(mCreature.getCellRef().getRefId());
 
-            localPlayer->sendItemChange(*gem, 1, mwmp::InventoryChanges::ADD);
+            localPlayer->queueItemChange(*gem, 1, mwmp::InventoryChanges::ADD);
             /*
                 End of tes3mp change (minor)
             */
@@ -484,14 +515,15 @@ namespace MWMechanics
         if (targetActor.getClass().getCreatureStats(targetActor).isDead())
             return;
 
-        static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fMaxHeadTrackDistance")->mValue.getFloat();
-        static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fInteriorHeadTrackMult")->mValue.getFloat();
-        float maxDistance = fMaxHeadTrackDistance;
-        const ESM::Cell* currentCell = actor.getCell()->getCell();
-        if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
-            maxDistance *= fInteriorHeadTrackMult;
+        /*
+            Start of tes3mp change (minor)
+
+            Share the head tracking distance with the search for targets
+        */
+        const float maxDistance = getMaxHeadTrackDistance(actor);
+        /*
+            End of tes3mp change (minor)
+        */
 
         const osg::Vec3f actor1Pos(actor.getRefData().getPosition().asVec3());
         const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
@@ -1688,7 +1720,15 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors() : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    /*
+        Start of tes3mp change (minor)
+
+        Set up the spatial index of actors
+    */
+    Actors::Actors() : mActorGrid(actorGridCellSize), mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    /*
+        End of tes3mp change (minor)
+    */
     {
         mTimerDisposeSummonsCorpses = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
 
@@ -1736,6 +1776,15 @@ namespace MWMechanics
         if (!anim)
             return;
         mActors.insert(std::make_pair(ptr, new Actor(ptr, anim)));
+        /*
+            Start of tes3mp addition
+
+            Index the new actor's position
+        */
+        mActorGrid.update(ptr, ptr.getRefData().getPosition().asVec3());
+        /*
+            End of tes3mp addition
+        */
 
         CharacterController* ctrl = mActors[ptr]->getCharacterController();
         if (updateImmediately)
@@ -1785,6 +1834,15 @@ namespace MWMechanics
         {
             delete iter->second;
             mActors.erase(iter);
+            /*
+                Start of tes3mp addition
+
+                Remove the actor from the spatial index
+            */
+            mActorGrid.remove(ptr);
+            /*
+                End of tes3mp addition
+            */
         }
     }
 
@@ -1837,9 +1895,33 @@ namespace MWMechanics
 
             actor->updatePtr(ptr);
             mActors.insert(std::make_pair(ptr, actor));
+            /*
+                Start of tes3mp addition
+
+                Index the actor under its new Ptr
+            */
+            mActorGrid.remove(old);
+            mActorGrid.update(ptr, ptr.getRefData().getPosition().asVec3());
+            /*
+                End of tes3mp addition
+            */
         }
     }
 
+    /*
+        Start of tes3mp addition
+
+        Keep the spatial index of actors up to date when one of them moves
+    */
+    void Actors::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        if (mActors.find(ptr) != mActors.end())
+            mActorGrid.update(ptr, ptr.getRefData().getPosition().asVec3());
+    }
+    /*
+        End of tes3mp addition
+    */
+
     void Actors::dropActors (const MWWorld::CellStore *cellStore, const MWWorld::Ptr& ignore)
     {
         PtrActorMap::iterator iter = mActors.begin();
@@ -1847,6 +1929,15 @@ namespace MWMechanics
         {
             if((iter->first.isInCell() && iter->first.getCell()==cellStore) && iter->first != ignore)
             {
+                /*
+                    Start of tes3mp addition
+
+                    Remove the actor from the spatial index
+                */
+                mActorGrid.remove(iter->first);
+                /*
+                    End of tes3mp addition
+                */
                 delete iter->second;
                 mActors.erase(iter++);
             }
@@ -1969,10 +2060,19 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
+            /*
+                Start of tes3mp change (minor)
+
+                Only go through the actors close enough to collide with
+            */
             // Iterate through all other actors and predict collisions.
-            for(PtrActorMap::iterator otherIter(mActors.begin()); otherIter != mActors.end(); ++otherIter)
+            std::vector<MWWorld::Ptr> neighbors;
+            getObjectsInRange(basePos, maxDistToCheck, neighbors);
+            for (const MWWorld::Ptr& otherPtr : neighbors)
             {
-                const MWWorld::Ptr& otherPtr = otherIter->first;
+            /*
+                End of tes3mp change (minor)
+            */
                 if (otherPtr == ptr || otherPtr == currentTarget)
                     continue;
 
@@ -2189,12 +2289,26 @@ namespace MWMechanics
                             if (!isPlayer)
                                 adjustCommandedActor(iter->first);
 
-                            for(PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+                            /*
+                                Start of tes3mp change (minor)
+
+                                Only go through the actors in processing range, which are the only ones
+                                engageCombat() considers
+                            */
+                            if (!isPlayer) // player is not AI-controlled
                             {
-                                if (it->first == iter->first || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(iter->first, it->first, cachedAllies, it->first == player);
+                                std::vector<MWWorld::Ptr> neighbors;
+                                getObjectsInRange(iter->first.getRefData().getPosition().asVec3(), mActorsProcessingRange, neighbors);
+                                for (const MWWorld::Ptr& neighbor : neighbors)
+                                {
+                                    if (neighbor == iter->first)
+                                        continue;
+                                    engageCombat(iter->first, neighbor, cachedAllies, neighbor == player);
+                                }
                             }
+                            /*
+                                End of tes3mp change (minor)
+                            */
                         }
                         if (timerUpdateHeadTrack == 0)
                         {
@@ -2214,16 +2328,31 @@ namespace MWMechanics
                                 if (inCombatOrPursue)
                                     activePackageTarget = stats.getAiSequence().getActivePackage().getTarget();
 
-                                for (PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
-                                {
-                                    if (it->first == iter->first)
-                                        continue;
+                                /*
+                                    Start of tes3mp change (minor)
 
-                                    if (inCombatOrPursue && it->first != activePackageTarget)
-                                        continue;
-
-                                    updateHeadTracking(iter->first, it->first, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                                    Only go through the package target or the actors within head tracking distance
+                                */
+                                if (inCombatOrPursue)
+                                {
+                                    if (activePackageTarget != iter->first && mActors.find(activePackageTarget) != mActors.end())
+                                        updateHeadTracking(iter->first, activePackageTarget, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
                                 }
+                                else
+                                {
+                                    std::vector<MWWorld::Ptr> neighbors;
+                                    getObjectsInRange(iter->first.getRefData().getPosition().asVec3(), getMaxHeadTrackDistance(iter->first), neighbors);
+                                    for (const MWWorld::Ptr& neighbor : neighbors)
+                                    {
+                                        if (neighbor == iter->first)
+                                            continue;
+
+                                        updateHeadTracking(iter->first, neighbor, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                                    }
+                                }
+                                /*
+                                    End of tes3mp change (minor)
+                                */
                             }
 
                             ctrl->setHeadTrackTarget(headTrackTarget);
@@ -2743,25 +2872,23 @@ namespace MWMechanics
             iter->second->getCharacterController()->persistAnimationState();
     }
 
+    /*
+        Start of tes3mp change (minor)
+
+        Find actors in range through the spatial index instead of checking all of them
+    */
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out)
     {
-        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
-        {
-            if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                out.push_back(iter->first);
-        }
+        mActorGrid.getInRange(position, radius, out);
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius)
     {
-        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
-        {
-            if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                return true;
-        }
-
-        return false;
+        return mActorGrid.isAnyInRange(position, radius);
     }
+    /*
+        End of tes3mp change (minor)
+    */
 
     std::list<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actor)
     {
@@ -2999,6 +3126,15 @@ namespace MWMechanics
             it->second = nullptr;
         }
         mActors.clear();
+        /*
+            Start of tes3mp addition
+
+            Clear the spatial index of actors
+        */
+        mActorGrid.clear();
+        /*
+            End of tes3mp addition
+        */
         mDeathCount.clear();
     }
 
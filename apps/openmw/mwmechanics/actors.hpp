@@ -9,6 +9,17 @@
 
 #include "../mwmechanics/actorutil.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include the spatial index of actor positions
+*/
+#include "../mwworld/ptr.hpp"
+#include "actorgrid.hpp"
+/*
+    End of tes3mp addition
+*/
+
 namespace ESM
 {
     class ESMReader;
@@ -106,6 +117,19 @@ namespace MWMechanics
             void updateActor(const MWWorld::Ptr &old, const MWWorld::Ptr& ptr);
             ///< Updates an actor with a new Ptr
 
+            /*
+                Start of tes3mp addition
+
+                Keep the spatial index of actors up to date when one of them moves
+            */
+            void updatePosition(const MWWorld::Ptr& ptr);
+            ///< Updates the indexed position of an actor
+            ///
+            /// \note Ignored, if \a ptr is not a registered actor.
+            /*
+                End of tes3mp addition
+            */
+
             void dropActors (const MWWorld::CellStore *cellStore, const MWWorld::Ptr& ignore);
             ///< Deregister all actors (except for \a ignore) in the given cell.
 
@@ -231,6 +255,16 @@ namespace MWMechanics
         void applyCureEffects (const MWWorld::Ptr& actor);
 
         PtrActorMap mActors;
+        /*
+            Start of tes3mp addition
+
+            Index actors by position so range checks don't have to go through all of them, as multiplayer
+            keeps the actors around every player loaded
+        */
+        ActorGrid<MWWorld::Ptr> mActorGrid;
+        /*
+            End of tes3mp addition
+        */
         float mTimerDisposeSummonsCorpses;
         float mActorsProcessingRange;
 
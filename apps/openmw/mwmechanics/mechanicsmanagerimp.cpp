@@ -290,6 +290,20 @@ namespace MWMechanics
             mObjects.updateObject(old, ptr);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Let actors be found by their position without going through all of them
+    */
+    void MechanicsManager::updatePosition(const MWWorld::Ptr &ptr)
+    {
+        if(ptr.getClass().isActor())
+            mActors.updatePosition(ptr);
+    }
+    /*
+        End of tes3mp addition
+    */
+
     void MechanicsManager::drop(const MWWorld::CellStore *cellStore)
     {
         mActors.dropActors(cellStore, getPlayer());
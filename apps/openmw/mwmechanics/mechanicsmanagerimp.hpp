@@ -51,6 +51,17 @@ namespace MWMechanics
             void updateCell(const MWWorld::Ptr &old, const MWWorld::Ptr &ptr) override;
             ///< Moves an object to a new cell
 
+            /*
+                Start of tes3mp addition
+
+                Let actors be found by their position without going through all of them
+            */
+            void updatePosition(const MWWorld::Ptr &ptr) override;
+            ///< Notify that an object has moved
+            /*
+                End of tes3mp addition
+            */
+
             void drop(const MWWorld::CellStore *cellStore) override;
             ///< Deregister all objects in the given cell.
 
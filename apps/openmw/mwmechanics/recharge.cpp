@@ -88,8 +88,8 @@ bool rechargeItem(const MWWorld::Ptr &item, const MWWorld::Ptr &gem)
 
         mwmp::Item addedItem = MechanicsHelper::getItem(item, 1);
 
-        localPlayer->sendItemChange(addedItem, mwmp::InventoryChanges::ADD);
-        localPlayer->sendItemChange(removedItem, mwmp::InventoryChanges::REMOVE);
+        localPlayer->queueItemChange(addedItem, mwmp::InventoryChanges::ADD);
+        localPlayer->queueItemChange(removedItem, mwmp::InventoryChanges::REMOVE);
         /*
             End of tes3mp change (minor)
         */
@@ -79,8 +79,8 @@ void Repair::repair(const MWWorld::Ptr &itemToRepair)
 
         mwmp::Item addedItem = MechanicsHelper::getItem(itemToRepair, 1);
 
-        localPlayer->sendItemChange(addedItem, mwmp::InventoryChanges::ADD);
-        localPlayer->sendItemChange(removedItem, mwmp::InventoryChanges::REMOVE);
+        localPlayer->queueItemChange(addedItem, mwmp::InventoryChanges::ADD);
+        localPlayer->queueItemChange(removedItem, mwmp::InventoryChanges::REMOVE);
         /*
             End of tes3mp change (minor)
         */
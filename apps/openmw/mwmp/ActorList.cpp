@@ -29,6 +29,7 @@ void ActorList::reset()
 {
     cell.blank();
     baseActors.clear();
+    clearBatches();
     positionActors.clear();
     animFlagsActors.clear();
     animPlayActors.clear();
@@ -43,49 +44,49 @@ void ActorList::reset()
     guid = mwmp::Main::get().getNetworking()->getLocalPlayer()->guid;
 }
 
-void ActorList::addActor(BaseActor baseActor)
+void ActorList::addActor(const BaseActor &baseActor)
 {
     baseActors.push_back(baseActor);
 }
 
-void ActorList::addPositionActor(BaseActor baseActor)
+void ActorList::addPositionActor(const BaseActor &baseActor)
 {
-    positionActors.push_back(baseActor);
+    addToBatch(positionActors, baseActor);
 }
 
-void ActorList::addAnimFlagsActor(BaseActor baseActor)
+void ActorList::addAnimFlagsActor(const BaseActor &baseActor)
 {
-    animFlagsActors.push_back(baseActor);
+    addToBatch(animFlagsActors, baseActor);
 }
 
-void ActorList::addAnimPlayActor(BaseActor baseActor)
+void ActorList::addAnimPlayActor(const BaseActor &baseActor)
 {
-    animPlayActors.push_back(baseActor);
+    addToBatch(animPlayActors, baseActor);
 }
 
-void ActorList::addSpeechActor(BaseActor baseActor)
+void ActorList::addSpeechActor(const BaseActor &baseActor)
 {
-    speechActors.push_back(baseActor);
+    addToBatch(speechActors, baseActor);
 }
 
-void ActorList::addStatsDynamicActor(BaseActor baseActor)
+void ActorList::addStatsDynamicActor(const BaseActor &baseActor)
 {
-    statsDynamicActors.push_back(baseActor);
+    addToBatch(statsDynamicActors, baseActor);
 }
 
-void ActorList::addDeathActor(BaseActor baseActor)
+void ActorList::addDeathActor(const BaseActor &baseActor)
 {
-    deathActors.push_back(baseActor);
+    addToBatch(deathActors, baseActor);
 }
 
-void ActorList::addEquipmentActor(BaseActor baseActor)
+void ActorList::addEquipmentActor(const BaseActor &baseActor)
 {
-    equipmentActors.push_back(baseActor);
+    addToBatch(equipmentActors, baseActor);
 }
 
-void ActorList::addAiActor(BaseActor baseActor)
+void ActorList::addAiActor(const BaseActor &baseActor)
 {
-    aiActors.push_back(baseActor);
+    addToBatch(aiActors, baseActor);
 }
 
 void ActorList::addAiActor(const MWWorld::Ptr& actorPtr, const MWWorld::Ptr& targetPtr, unsigned int aiAction)
@@ -113,9 +114,9 @@ void ActorList::addAiActor(const MWWorld::Ptr& actorPtr, const MWWorld::Ptr& tar
     addAiActor(baseActor);
 }
 
-void ActorList::addAttackActor(BaseActor baseActor)
+void ActorList::addAttackActor(const BaseActor &baseActor)
 {
-    attackActors.push_back(baseActor);
+    addToBatch(attackActors, baseActor);
 }
 
 void ActorList::addAttackActor(const MWWorld::Ptr& actorPtr, const mwmp::Attack &attack)
@@ -124,127 +125,83 @@ void ActorList::addAttackActor(const MWWorld::Ptr& actorPtr, const mwmp::Attack
     baseActor.refNum = actorPtr.getCellRef().getRefNum().mIndex;
     baseActor.mpNum = actorPtr.getCellRef().getMpNum();
     baseActor.attack = attack;
-    attackActors.push_back(baseActor);
+    addToBatch(attackActors, baseActor);
 }
 
-void ActorList::addCastActor(BaseActor baseActor)
+void ActorList::addCastActor(const BaseActor &baseActor)
 {
-    castActors.push_back(baseActor);
+    addToBatch(castActors, baseActor);
 }
 
-void ActorList::addCellChangeActor(BaseActor baseActor)
+void ActorList::addCellChangeActor(const BaseActor &baseActor)
 {
-    cellChangeActors.push_back(baseActor);
+    addToBatch(cellChangeActors, baseActor);
+}
+
+void ActorList::sendBatch(RakNet::MessageID packetID, const std::vector<unsigned int> &batch)
+{
+    if (batch.empty())
+        return;
+
+    setSentBatch(&batch);
+    Main::get().getNetworking()->getActorPacket(packetID)->setActorList(this);
+    Main::get().getNetworking()->getActorPacket(packetID)->Send();
+    setSentBatch(nullptr);
 }
 
 void ActorList::sendPositionActors()
 {
-    if (positionActors.size() > 0)
-    {
-        baseActors = positionActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_POSITION)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_POSITION)->Send();
-    }
+    sendBatch(ID_ACTOR_POSITION, positionActors);
 }
 
 void ActorList::sendAnimFlagsActors()
 {
-    if (animFlagsActors.size() > 0)
-    {
-        baseActors = animFlagsActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_FLAGS)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_FLAGS)->Send();
-    }
+    sendBatch(ID_ACTOR_ANIM_FLAGS, animFlagsActors);
 }
 
 void ActorList::sendAnimPlayActors()
 {
-    if (animPlayActors.size() > 0)
-    {
-        baseActors = animPlayActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_PLAY)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_PLAY)->Send();
-    }
+    sendBatch(ID_ACTOR_ANIM_PLAY, animPlayActors);
 }
 
 void ActorList::sendSpeechActors()
 {
-    if (speechActors.size() > 0)
-    {
-        baseActors = speechActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_SPEECH)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_SPEECH)->Send();
-    }
+    sendBatch(ID_ACTOR_SPEECH, speechActors);
 }
 
 void ActorList::sendStatsDynamicActors()
 {
-    if (statsDynamicActors.size() > 0)
-    {
-        baseActors = statsDynamicActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_STATS_DYNAMIC)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_STATS_DYNAMIC)->Send();
-    }
+    sendBatch(ID_ACTOR_STATS_DYNAMIC, statsDynamicActors);
 }
 
 void ActorList::sendDeathActors()
 {
-    if (deathActors.size() > 0)
-    {
-        baseActors = deathActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_DEATH)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_DEATH)->Send();
-    }
+    sendBatch(ID_ACTOR_DEATH, deathActors);
 }
 
 void ActorList::sendEquipmentActors()
 {
-    if (equipmentActors.size() > 0)
-    {
-        baseActors = equipmentActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_EQUIPMENT)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_EQUIPMENT)->Send();
-    }
+    sendBatch(ID_ACTOR_EQUIPMENT, equipmentActors);
 }
 
 void ActorList::sendAiActors()
 {
-    if (aiActors.size() > 0)
-    {
-        baseActors = aiActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_AI)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_AI)->Send();
-    }
+    sendBatch(ID_ACTOR_AI, aiActors);
 }
 
 void ActorList::sendAttackActors()
 {
-    if (attackActors.size() > 0)
-    {
-        baseActors = attackActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ATTACK)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ATTACK)->Send();
-    }
+    sendBatch(ID_ACTOR_ATTACK, attackActors);
 }
 
 void ActorList::sendCastActors()
 {
-    if (castActors.size() > 0)
-    {
-        baseActors = castActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_CAST)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_CAST)->Send();
-    }
+    sendBatch(ID_ACTOR_CAST, castActors);
 }
 
 void ActorList::sendCellChangeActors()
 {
-    if (cellChangeActors.size() > 0)
-    {
-        baseActors = cellChangeActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_CELL_CHANGE)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_CELL_CHANGE)->Send();
-    }
+    sendBatch(ID_ACTOR_CELL_CHANGE, cellChangeActors);
 }
 
 void ActorList::sendActorsInCell(MWWorld::CellStore* cellStore)
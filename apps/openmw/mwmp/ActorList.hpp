@@ -18,21 +18,21 @@ namespace mwmp
         virtual ~ActorList();
 
         void reset();
-        void addActor(BaseActor baseActor);
+        void addActor(const BaseActor &baseActor);
 
-        void addPositionActor(BaseActor baseActor);
-        void addAnimFlagsActor(BaseActor baseActor);
-        void addAnimPlayActor(BaseActor baseActor);
-        void addSpeechActor(BaseActor baseActor);
-        void addStatsDynamicActor(BaseActor baseActor);
-        void addDeathActor(BaseActor baseActor);
-        void addEquipmentActor(BaseActor baseActor);
-        void addAiActor(BaseActor baseActor);
+        void addPositionActor(const BaseActor &baseActor);
+        void addAnimFlagsActor(const BaseActor &baseActor);
+        void addAnimPlayActor(const BaseActor &baseActor);
+        void addSpeechActor(const BaseActor &baseActor);
+        void addStatsDynamicActor(const BaseActor &baseActor);
+        void addDeathActor(const BaseActor &baseActor);
+        void addEquipmentActor(const BaseActor &baseActor);
+        void addAiActor(const BaseActor &baseActor);
         void addAiActor(const MWWorld::Ptr& actorPtr, const MWWorld::Ptr& targetPtr, unsigned int aiAction);
-        void addAttackActor(BaseActor baseActor);
+        void addAttackActor(const BaseActor &baseActor);
         void addAttackActor(const MWWorld::Ptr& actorPtr, const mwmp::Attack &attack);
-        void addCastActor(BaseActor baseActor);
-        void addCellChangeActor(BaseActor baseActor);
+        void addCastActor(const BaseActor &baseActor);
+        void addCellChangeActor(const BaseActor &baseActor);
 
         void sendPositionActors();
         void sendAnimFlagsActors();
@@ -51,17 +51,20 @@ namespace mwmp
     private:
         Networking *getNetworking();
 
-        std::vector<BaseActor> positionActors;
-        std::vector<BaseActor> animFlagsActors;
-        std::vector<BaseActor> animPlayActors;
-        std::vector<BaseActor> speechActors;
-        std::vector<BaseActor> statsDynamicActors;
-        std::vector<BaseActor> deathActors;
-        std::vector<BaseActor> equipmentActors;
-        std::vector<BaseActor> aiActors;
-        std::vector<BaseActor> attackActors;
-        std::vector<BaseActor> castActors;
-        std::vector<BaseActor> cellChangeActors;
+        void sendBatch(RakNet::MessageID packetID, const std::vector<unsigned int> &batch);
+
+        // Indexes of the actors batched for each packet, which are kept in BaseActorList's pool
+        std::vector<unsigned int> positionActors;
+        std::vector<unsigned int> animFlagsActors;
+        std::vector<unsigned int> animPlayActors;
+        std::vector<unsigned int> speechActors;
+        std::vector<unsigned int> statsDynamicActors;
+        std::vector<unsigned int> deathActors;
+        std::vector<unsigned int> equipmentActors;
+        std::vector<unsigned int> aiActors;
+        std::vector<unsigned int> attackActors;
+        std::vector<unsigned int> castActors;
+        std::vector<unsigned int> cellChangeActors;
     };
 }
 
@@ -56,21 +56,21 @@ void Cell::updateLocal(bool forceUpdate)
         if (newStore != store)
         {
             actor->updateCell();
-            std::string mapIndex = it->first;
+            uint64_t mapIndex = it->first;
 
             // If the cell this actor has moved to is under our authority, move them to it
             if (cellController->hasLocalAuthority(actor->cell))
             {
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving LocalActor %s to our authority in %s",
-                    mapIndex.c_str(), actor->cell.getShortDescription().c_str());
+                    CellController::describeMapIndex(mapIndex).c_str(), actor->cell.getShortDescription().c_str());
                 Cell *newCell = cellController->getCell(actor->cell);
                 newCell->localActors[mapIndex] = actor;
-                cellController->setLocalActorRecord(mapIndex, newCell->getShortDescription());
+                cellController->setLocalActorRecord(mapIndex, newCell);
             }
             else
             {
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %s which is no longer under our authority",
-                    mapIndex.c_str(), getShortDescription().c_str());
+                    CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
                 cellController->removeLocalActorRecord(mapIndex);
                 delete actor;
             }
@@ -121,13 +121,16 @@ void Cell::readPositions(ActorList& actorList)
     
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->position = baseActor.position;
             actor->direction = baseActor.direction;
+            actor->positionTimestamp = baseActor.positionTimestamp;
+            actor->addPositionSnapshot();
 
             if (!actor->hasPositionData)
             {
@@ -148,11 +151,12 @@ void Cell::readAnimFlags(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->movementFlags = baseActor.movementFlags;
             actor->drawState = baseActor.drawState;
             actor->isFlying = baseActor.isFlying;
@@ -164,11 +168,12 @@ void Cell::readAnimPlay(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->animation.groupname = baseActor.animation.groupname;
             actor->animation.mode = baseActor.animation.mode;
             actor->animation.count = baseActor.animation.count;
@@ -186,11 +191,12 @@ void Cell::readStatsDynamic(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->creatureStats = baseActor.creatureStats;
 
             if (!actor->hasStatsDynamicData)
@@ -216,11 +222,12 @@ void Cell::readDeath(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->creatureStats.mDead = true;
             actor->creatureStats.mDynamic[0].mCurrent = 0;
 
@@ -247,11 +254,12 @@ void Cell::readEquipment(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
 
             for (int slot = 0; slot < 19; ++slot)
                 actor->equipmentItems[slot] = baseActor.equipmentItems[slot];
@@ -272,11 +280,12 @@ void Cell::readSpeech(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->sound = baseActor.sound;
             actor->playSound();
         }
@@ -294,11 +303,12 @@ void Cell::readSpellsActive(ActorList& actorList)
 
     for (const auto& baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor* actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->spellsActiveChanges = baseActor.spellsActiveChanges;
 
             int spellsActiveAction = baseActor.spellsActiveChanges.action;
@@ -324,11 +334,12 @@ void Cell::readAi(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->aiAction = baseActor.aiAction;
             actor->aiDistance = baseActor.aiDistance;
             actor->aiDuration = baseActor.aiDuration;
@@ -348,13 +359,14 @@ void Cell::readAttack(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %s", mapIndex.c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %s", CellController::describeMapIndex(mapIndex).c_str());
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->attack = baseActor.attack;
 
             MechanicsHelper::processAttack(actor->attack, actor->getPtr());
@@ -366,13 +378,14 @@ void Cell::readCast(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %s", mapIndex.c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %s", CellController::describeMapIndex(mapIndex).c_str());
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->cast = baseActor.cast;
 
             // Set the correct drawState here if we've somehow we've missed a previous
@@ -398,13 +411,13 @@ void Cell::readCellChange(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         // Is a packet mistakenly moving the actor to the cell it's already in? If so, ignore it
         if (Misc::StringUtils::ciEqual(getShortDescription(), baseActor.cell.getShortDescription()))
         {
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Server says DedicatedActor %s moved to %s, but it was already there",
-                mapIndex.c_str(), getShortDescription().c_str());
+                CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
             continue;
         }
 
@@ -416,7 +429,7 @@ void Cell::readCellChange(ActorList& actorList)
             dedicatedActor->direction = baseActor.direction;
 
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server says DedicatedActor %s moved to %s",
-                mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                CellController::describeMapIndex(mapIndex).c_str(), dedicatedActor->cell.getShortDescription().c_str());
 
             MWWorld::CellStore *newStore = cellController->getCellStore(dedicatedActor->cell);
             dedicatedActor->setCell(newStore);
@@ -425,18 +438,18 @@ void Cell::readCellChange(ActorList& actorList)
             if (cellController->isActiveWorldCell(dedicatedActor->cell) && !cellController->hasLocalAuthority(dedicatedActor->cell))
             {
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving DedicatedActor %s to our active cell %s",
-                    mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                    CellController::describeMapIndex(mapIndex).c_str(), dedicatedActor->cell.getShortDescription().c_str());
                 cellController->initializeCell(dedicatedActor->cell);
                 Cell *newCell = cellController->getCell(dedicatedActor->cell);
                 newCell->dedicatedActors[mapIndex] = dedicatedActor;
-                cellController->setDedicatedActorRecord(mapIndex, newCell->getShortDescription());
+                cellController->setDedicatedActorRecord(mapIndex, newCell);
             }
             else
             {
                 if (cellController->hasLocalAuthority(dedicatedActor->cell))
                 {
                     LOG_APPEND(TimedLog::LOG_VERBOSE, "- Creating new LocalActor based on %s in %s",
-                        mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                        CellController::describeMapIndex(mapIndex).c_str(), dedicatedActor->cell.getShortDescription().c_str());
                     Cell *newCell = cellController->getCell(dedicatedActor->cell);
                     LocalActor *localActor = new LocalActor();
                     localActor->cell = dedicatedActor->cell;
@@ -449,11 +462,11 @@ void Cell::readCellChange(ActorList& actorList)
                     localActor->creatureStats = dedicatedActor->creatureStats;
 
                     newCell->localActors[mapIndex] = localActor;
-                    cellController->setLocalActorRecord(mapIndex, newCell->getShortDescription());
+                    cellController->setLocalActorRecord(mapIndex, newCell);
                 }
 
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting DedicatedActor %s which is no longer needed",
-                    mapIndex.c_str(), getShortDescription().c_str());
+                    CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
                 cellController->removeDedicatedActorRecord(mapIndex);
                 delete dedicatedActor;
             }
@@ -465,8 +478,8 @@ void Cell::readCellChange(ActorList& actorList)
 
 void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %s in %s", CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
 
     LocalActor *actor = new LocalActor();
     actor->cell = *store->getCell();
@@ -474,9 +487,9 @@ void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 
     localActors[mapIndex] = actor;
 
-    Main::get().getCellController()->setLocalActorRecord(mapIndex, getShortDescription());
+    Main::get().getCellController()->setLocalActorRecord(mapIndex, this);
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %s in %s", CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
 }
 
 void Cell::initializeLocalActors()
@@ -495,7 +508,7 @@ void Cell::initializeLocalActors()
             // If this Ptr is disabled or deleted, ignore it
             if (!ptr.getRefData().isEnabled() || ptr.getRefData().isDeleted()) continue;
 
-            std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+            uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
 
             // Only initialize this actor if it isn't already initialized
             if (localActors.count(mapIndex) == 0)
@@ -508,8 +521,8 @@ void Cell::initializeLocalActors()
 
 void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %s in %s", CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
 
     DedicatedActor *actor = new DedicatedActor();
     actor->cell = *store->getCell();
@@ -517,16 +530,16 @@ void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 
     dedicatedActors[mapIndex] = actor;
 
-    Main::get().getCellController()->setDedicatedActorRecord(mapIndex, getShortDescription());
+    Main::get().getCellController()->setDedicatedActorRecord(mapIndex, this);
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %s in %s", CellController::describeMapIndex(mapIndex).c_str(), getShortDescription().c_str());
 }
 
 void Cell::initializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         // If this key doesn't exist, create it
         if (dedicatedActors.count(mapIndex) == 0)
@@ -555,7 +568,7 @@ void Cell::uninitializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
         Main::get().getCellController()->removeDedicatedActorRecord(mapIndex);
         delete dedicatedActors.at(mapIndex);
         dedicatedActors.erase(mapIndex);
@@ -573,12 +586,12 @@ void Cell::uninitializeDedicatedActors()
     dedicatedActors.clear();
 }
 
-LocalActor *Cell::getLocalActor(std::string actorIndex)
+LocalActor *Cell::getLocalActor(uint64_t actorIndex)
 {
     return localActors.at(actorIndex);
 }
 
-DedicatedActor *Cell::getDedicatedActor(std::string actorIndex)
+DedicatedActor *Cell::getDedicatedActor(uint64_t actorIndex)
 {
     return dedicatedActors.at(actorIndex);
 }
@@ -1,6 +1,8 @@
 #ifndef OPENMW_MPCELL_HPP
 #define OPENMW_MPCELL_HPP
 
+#include <unordered_map>
+
 #include "ActorList.hpp"
 #include "LocalActor.hpp"
 #include "DedicatedActor.hpp"
@@ -41,8 +43,8 @@ namespace mwmp
         void uninitializeDedicatedActors(ActorList& actorList);
         void uninitializeDedicatedActors();
 
-        virtual LocalActor *getLocalActor(std::string actorIndex);
-        virtual DedicatedActor *getDedicatedActor(std::string actorIndex);
+        virtual LocalActor *getLocalActor(uint64_t actorIndex);
+        virtual DedicatedActor *getDedicatedActor(uint64_t actorIndex);
 
         bool hasLocalAuthority();
         void setAuthority(const RakNet::RakNetGUID& guid);
@@ -56,8 +58,8 @@ namespace mwmp
         MWWorld::CellStore* store;
         RakNet::RakNetGUID authorityGuid;
 
-        std::map<std::string, LocalActor *> localActors;
-        std::map<std::string, DedicatedActor *> dedicatedActors;
+        std::unordered_map<uint64_t, LocalActor *> localActors;
+        std::unordered_map<uint64_t, DedicatedActor *> dedicatedActors;
 
         float updateTimer;
     };
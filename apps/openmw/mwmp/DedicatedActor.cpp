@@ -58,7 +58,7 @@ void DedicatedActor::update(float dt)
     // Only move and set anim flags if the framerate isn't too low
     if (dt < 0.1)
     {
-        move(dt);
+        move();
         setAnimFlags();
     }
 
@@ -75,35 +75,30 @@ void DedicatedActor::setCell(MWWorld::CellStore *cellStore)
     hasChangedCell = true;
 }
 
-void DedicatedActor::move(float dt)
+void DedicatedActor::move()
 {
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 40;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate = abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance && abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance && abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
-
-    // Don't apply linear interpolation if the DedicatedActor has just gone through a cell change, because
-    // the interpolated position will be invalid, causing a slight hopping glitch
-    if (shouldInterpolate && !hasChangedCell)
+    // Don't play back positions from before a cell change, because they would make the actor
+    // hop back to the cell it just left
+    if (hasChangedCell)
     {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-        refPos.pos[0] = lerp.x();
-        refPos.pos[1] = lerp.y();
-        refPos.pos[2] = lerp.z();
-
-        world->moveObject(ptr, refPos.pos[0], refPos.pos[1], refPos.pos[2]);
-    }
-    else
-    {
-        setPosition();
+        positionSnapshots.clear();
         hasChangedCell = false;
     }
 
+    ESM::Position shownPosition = position;
+    positionSnapshots.sample(SnapshotBuffer::getTime(), shownPosition);
+
+    world->moveObject(ptr, shownPosition.pos[0], shownPosition.pos[1], shownPosition.pos[2]);
+
     setMovementSettings();
-    world->rotateObject(ptr, position.rot[0], position.rot[1], position.rot[2]);
+    world->rotateObject(ptr, shownPosition.rot[0], shownPosition.rot[1], shownPosition.rot[2]);
+}
+
+void DedicatedActor::addPositionSnapshot()
+{
+    positionSnapshots.add(position, positionTimestamp, SnapshotBuffer::getTime());
 }
 
 void DedicatedActor::setMovementSettings()
@@ -2,6 +2,7 @@
 #define OPENMW_DEDICATEDACTOR_HPP
 
 #include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/SnapshotBuffer.hpp>
 #include "../mwmechanics/aisequence.hpp"
 #include "../mwworld/manualref.hpp"
 
@@ -15,7 +16,8 @@ namespace mwmp
         virtual ~DedicatedActor();
 
         void update(float dt);
-        void move(float dt);
+        void move();
+        void addPositionSnapshot();
         void setCell(MWWorld::CellStore *cellStore);
         void setMovementSettings();
         void setPosition();
@@ -42,6 +44,8 @@ namespace mwmp
 
         bool hasReceivedInitialEquipment;
         bool hasChangedCell;
+
+        SnapshotBuffer positionSnapshots;
     };
 }
 
@@ -79,7 +79,7 @@ void DedicatedPlayer::update(float dt)
     // Only move and set anim flags if the framerate isn't too low
     if (dt < 0.1)
     {
-        move(dt);
+        move();
         setAnimFlags();
     }
 
@@ -114,31 +114,19 @@ void DedicatedPlayer::update(float dt)
     ptrCreatureStats->setAiSetting(MWMechanics::CreatureStats::AI_Hello, 0);
 }
 
-void DedicatedPlayer::move(float dt)
+void DedicatedPlayer::move()
 {
     if (!reference) return;
 
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 80;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate =
-            abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance &&
-            abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance &&
-            abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    // Play back the positions received with a delay that smooths over how unevenly they arrive,
+    // or use the latest one until there are any
+    ESM::Position shownPosition = position;
+    positionSnapshots.sample(SnapshotBuffer::getTime(), shownPosition);
 
-    if (shouldInterpolate)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-
-        world->moveObject(ptr, lerp.x(), lerp.y(), lerp.z());
-    }
-    else
-        world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
-
-    world->rotateObject(ptr, position.rot[0], 0, position.rot[2]);
+    world->moveObject(ptr, shownPosition.pos[0], shownPosition.pos[1], shownPosition.pos[2]);
+    world->rotateObject(ptr, shownPosition.rot[0], 0, shownPosition.rot[2]);
 
     MWMechanics::Movement *move = &ptr.getClass().getMovementSettings(ptr);
     move->mPosition[0] = direction.pos[0];
@@ -154,6 +142,11 @@ void DedicatedPlayer::move(float dt)
     }
 }
 
+void DedicatedPlayer::addPositionSnapshot()
+{
+    positionSnapshots.add(position, positionTimestamp, SnapshotBuffer::getTime());
+}
+
 void DedicatedPlayer::setBaseInfo()
 {
     // Use the previous race if the new one doesn't exist
@@ -413,6 +406,9 @@ void DedicatedPlayer::setCell()
     setStatsDynamic();
     setAnimFlags();
 
+    // Positions from the previous cell can't be played back in this one
+    positionSnapshots.clear();
+
     // Allow this player's reference to move across a cell now that a manual cell
     // update has been called
     setPtr(world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]));
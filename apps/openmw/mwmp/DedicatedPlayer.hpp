@@ -5,6 +5,7 @@
 #include <components/esm/loadcrea.hpp>
 #include <components/esm/loadnpc.hpp>
 #include <components/openmw-mp/Base/BasePlayer.hpp>
+#include <components/openmw-mp/SnapshotBuffer.hpp>
 
 #include "../mwclass/npc.hpp"
 
@@ -30,7 +31,8 @@ namespace mwmp
 
         void update(float dt);
 
-        void move(float dt);
+        void move();
+        void addPositionSnapshot();
         void setBaseInfo();
         void setStatsDynamic();
         void setAnimFlags();
@@ -87,6 +89,8 @@ namespace mwmp
         bool isLevitationPurged;
 
         bool wasJumping;
+
+        SnapshotBuffer positionSnapshots;
     };
 }
 #endif //OPENMW_DEDICATEDPLAYER_HPP
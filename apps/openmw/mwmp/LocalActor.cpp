@@ -1,3 +1,4 @@
+#include <components/openmw-mp/SnapshotBuffer.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -106,6 +107,7 @@ void LocalActor::updatePosition(bool forceUpdate)
     {
         posWasChanged = posIsChanging;
         position = ptr.getRefData().getPosition();
+        positionTimestamp = SnapshotBuffer::getTimestamp();
         mwmp::Main::get().getNetworking()->getActorList()->addPositionActor(*this);
     }
 }
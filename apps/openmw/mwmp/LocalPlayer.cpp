@@ -1,4 +1,5 @@
 #include <components/esm/esmwriter.hpp>
+#include <components/openmw-mp/SnapshotBuffer.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 #include <components/openmw-mp/Utils.hpp>
 
@@ -397,6 +398,7 @@ void LocalPlayer::updatePosition(bool forceUpdate)
         if (!isJumping && !world->isOnGround(ptrPlayer) && !world->isFlying(ptrPlayer))
             isJumping = true;
 
+        positionTimestamp = SnapshotBuffer::getTimestamp();
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
@@ -410,6 +412,7 @@ void LocalPlayer::updatePosition(bool forceUpdate)
     {
         sentJumpEnd = true;
         position = ptrPlayer.getRefData().getPosition();
+        positionTimestamp = SnapshotBuffer::getTimestamp();
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
@@ -508,71 +511,26 @@ void LocalPlayer::updateEquipment(bool forceUpdate)
 
 void LocalPlayer::updateInventory(bool forceUpdate)
 {
-    static bool invChanged = false;
-
     if (forceUpdate)
-        invChanged = true;
-
-    MWWorld::Ptr ptrPlayer = getPlayerPtr();
-    MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
-    mwmp::Item item;
-
-    auto setItem = [](Item &item, const MWWorld::Ptr &iter) {
-        item.refId = iter.getCellRef().getRefId();
-        if (item.refId.find("$dynamic") != std::string::npos)
-            return true;
-        item.count = iter.getRefData().getCount();
-        item.charge = iter.getCellRef().getCharge();
-        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
-        item.soul = iter.getCellRef().getSoul();
-
-        return false;
-    };
-
-    if (!invChanged)
     {
-        for (const auto &itemOld : inventoryChanges.items)
-        {
-            auto result = ptrInventory.begin();
-            for (; result != ptrInventory.end(); ++result)
-            {
-                if(setItem(item, *result))
-                    continue;
-
-                if (item == itemOld)
-                    break;
-            }
-            if (result == ptrInventory.end())
-            {
-                invChanged = true;
-                break;
-            }
-        }
+        sendInventory();
+        return;
     }
 
-    if (!invChanged)
-    {
-        for (const auto &iter : ptrInventory)
-        {
-            if(setItem(item, iter))
-                continue;
+    if (queuedInventoryChanges.empty())
+        return;
 
-            auto items = inventoryChanges.items;
+    for (auto &changes : queuedInventoryChanges)
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending %i item changes with action %i",
+            (int) changes.items.size(), changes.action);
 
-            if (find(items.begin(), items.end(), item) == items.end())
-            {
-                invChanged = true;
-                break;
-            }
-        }
+        inventoryChanges = std::move(changes);
+        getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->setPlayer(this);
+        getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->Send();
     }
 
-    if (!invChanged)
-        return;
-
-    invChanged = false;
-
-    sendInventory();
+    queuedInventoryChanges.clear();
 }
 
 void LocalPlayer::updateAttackOrCast()
@@ -1471,6 +1429,8 @@ void LocalPlayer::sendInventory()
     MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
     mwmp::Item item;
 
+    // The entire inventory already includes any changes that haven't been sent yet
+    queuedInventoryChanges.clear();
     inventoryChanges.items.clear();
 
     for (const auto &iter : ptrInventory)
@@ -1498,32 +1458,43 @@ void LocalPlayer::sendInventory()
     getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->Send();
 }
 
-void LocalPlayer::sendItemChange(const mwmp::Item& item, unsigned int action)
+void LocalPlayer::queueItemChange(const mwmp::Item& item, unsigned int action)
 {
-    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending item change for %s with action %i, count %i",
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Queueing item change for %s with action %i, count %i",
         item.refId.c_str(), action, item.count);
 
-    inventoryChanges.items.clear();
-    inventoryChanges.items.push_back(item);
-    inventoryChanges.action = action;
+    // Only changes with the same action can go in the same packet, so start a new one whenever
+    // the action changes to keep them in the order they were made
+    if (queuedInventoryChanges.empty() || queuedInventoryChanges.back().action != (int) action)
+    {
+        queuedInventoryChanges.emplace_back();
+        queuedInventoryChanges.back().action = action;
+    }
 
-    getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->setPlayer(this);
-    getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->Send();
+    std::vector<mwmp::Item> &items = queuedInventoryChanges.back().items;
+
+    // Merge repeated changes to the same item, such as ammo being picked up one at a time
+    for (auto &queuedItem : items)
+    {
+        if (queuedItem.refId == item.refId && queuedItem.charge == item.charge &&
+            queuedItem.enchantmentCharge == item.enchantmentCharge && queuedItem.soul == item.soul)
+        {
+            queuedItem.count += item.count;
+            return;
+        }
+    }
+
+    items.push_back(item);
 }
 
-void LocalPlayer::sendItemChange(const MWWorld::Ptr& itemPtr, int count, unsigned int action)
+void LocalPlayer::queueItemChange(const MWWorld::Ptr& itemPtr, int count, unsigned int action)
 {
     mwmp::Item item = MechanicsHelper::getItem(itemPtr, count);
-    sendItemChange(item, action);
+    queueItemChange(item, action);
 }
 
-void LocalPlayer::sendItemChange(const std::string& refId, int count, unsigned int action)
+void LocalPlayer::queueItemChange(const std::string& refId, int count, unsigned int action)
 {
-    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending item change for %s with action %i, count %i",
-        refId.c_str(), action, count);
-
-    inventoryChanges.items.clear();
-    
     mwmp::Item item;
     item.refId = refId;
     item.count = count;
@@ -1531,15 +1502,14 @@ void LocalPlayer::sendItemChange(const std::string& refId, int count, unsigned i
     item.enchantmentCharge = -1;
     item.soul = "";
 
-    inventoryChanges.items.push_back(item);
-
-    inventoryChanges.action = action;
-    getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->setPlayer(this);
-    getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->Send();
+    queueItemChange(item, action);
 }
 
 void LocalPlayer::sendStoredItemRemovals()
 {
+    // Keep these removals after any item changes made before them
+    updateInventory();
+
     inventoryChanges.items.clear();
 
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending stored item removals for LocalPlayer:");
@@ -87,9 +87,9 @@ namespace mwmp
         void sendDeath(char newDeathState);
         void sendClass();
         void sendInventory();
-        void sendItemChange(const mwmp::Item& item, unsigned int action);
-        void sendItemChange(const MWWorld::Ptr& itemPtr, int count, unsigned int action);
-        void sendItemChange(const std::string& refId, int count, unsigned int action);
+        void queueItemChange(const mwmp::Item& item, unsigned int action);
+        void queueItemChange(const MWWorld::Ptr& itemPtr, int count, unsigned int action);
+        void queueItemChange(const std::string& refId, int count, unsigned int action);
         void sendStoredItemRemovals();
         void sendSpellbook();
         void sendSpellChange(std::string id, unsigned int action);
@@ -127,6 +127,9 @@ namespace mwmp
     private:
         Networking *getNetworking();
 
+        // Item changes that updateInventory() hasn't sent yet, with one entry for every packet
+        std::vector<InventoryChanges> queuedInventoryChanges;
+
     };
 }
 
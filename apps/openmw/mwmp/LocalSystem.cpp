@@ -6,7 +6,7 @@ using namespace mwmp;
 
 LocalSystem::LocalSystem()
 {
-
+    capabilities = COMPACT_POSITION | STRING_TABLE;
 }
 
 LocalSystem::~LocalSystem()
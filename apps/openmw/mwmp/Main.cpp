@@ -180,6 +180,8 @@ void Main::destroy()
 
 void Main::frame(float dt)
 {
+    // Send the item changes made during the last frame before anything the server sent since
+    get().getLocalPlayer()->updateInventory();
     get().getNetworking()->update();
 
     PlayerList::update(dt);
@@ -2,9 +2,11 @@
 #include <iostream>
 #include <string>
 
+#include <components/openmw-mp/ChecksumCache.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 #include <components/openmw-mp/Utils.hpp>
 #include <components/openmw-mp/Version.hpp>
+#include <components/openmw-mp/Packets/PacketBatcher.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
 
 #include <components/esm/cellid.hpp>
@@ -193,6 +195,15 @@ std::string listComparison(PacketPreInit::PluginContainer checksums, PacketPreIn
     return sstr.str();
 }
 
+// The server is the only connection, and it reads strings by index from any client that can read them in turn
+static StringTables *getServerStringTables(const RakNet::AddressOrGUID &)
+{
+    if ((Main::get().getLocalSystem()->capabilities & BaseSystem::STRING_TABLE) == 0)
+        return nullptr;
+
+    return Main::get().getNetworking()->getStringTables();
+}
+
 Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemPacketController(peer),
     playerPacketController(peer), actorPacketController(peer), objectPacketController(peer),
     worldstatePacketController(peer)
@@ -209,12 +220,16 @@ Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemP
     objectPacketController.SetStream(0, &bsOut);
     worldstatePacketController.SetStream(0, &bsOut);
 
+    BasePacket::setStringTablesLookup(getServerStringTables);
+
     connected = 0;
     ProcessorInitializer();
 }
 
 Networking::~Networking()
 {
+    BasePacket::setStringTablesLookup(nullptr);
+
     peer->Shutdown(100);
     peer->CloseConnection(peer->GetSystemAddressFromIndex(0), true, 0);
     RakNet::RakPeerInterface::DestroyInstance(peer);
@@ -253,6 +268,9 @@ void Networking::update()
             case ID_CONNECTION_LOST:
                 errmsg = "Connection lost.";
                 break;
+            case ID_PACKET_BATCH:
+                receiveBatch(packet);
+                break;
             default:
                 receiveMessage(packet);
                 //LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Message with identifier %i has arrived.", packet->data[0]);
@@ -354,23 +372,40 @@ void Networking::connect(const std::string &ip, unsigned short port, std::vector
 
 void Networking::preInit(std::vector<std::string> &content, Files::Collections &collections)
 {
-    PacketPreInit::PluginContainer checksums;
-    std::vector<std::string>::const_iterator it(content.begin());
-    for (int idx = 0; it != content.end(); ++it, ++idx)
+    std::vector<std::string> paths;
+
+    for (const std::string &file : content)
     {
-        boost::filesystem::path filename(*it);
+        boost::filesystem::path filename(file);
         const Files::MultiDirCollection& col = collections.getCollection(filename.extension().string());
-        if (col.doesExist(*it))
-        {
-            PacketPreInit::HashList hashList;
-            unsigned crc32 = Utils::crc32Checksum(col.getPath(*it).string());
-            hashList.push_back(crc32);
-            checksums.push_back(make_pair(*it, hashList));
 
-            LOG_APPEND(TimedLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", idx, crc32, col.getPath(*it).string().c_str());
-        }
-        else
+        if (!col.doesExist(file))
             throw std::runtime_error("Plugin doesn't exist.");
+
+        paths.push_back(col.getPath(file).string());
+    }
+
+    // Only read the data files that have changed since their checksums were last saved
+    Files::ConfigurationManager cfgMgr;
+    const std::string checksumCachePath = (cfgMgr.getCachePath() / "tes3mp-checksums.txt").string();
+
+    ChecksumCache checksumCache;
+    checksumCache.load(checksumCachePath);
+
+    std::vector<uint32_t> crc32s = checksumCache.getChecksums(paths);
+
+    if (!checksumCache.save())
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not save data file checksums to %s", checksumCachePath.c_str());
+
+    PacketPreInit::PluginContainer checksums;
+
+    for (std::size_t idx = 0; idx < content.size(); ++idx)
+    {
+        PacketPreInit::HashList hashList;
+        hashList.push_back(crc32s[idx]);
+        checksums.push_back(make_pair(content[idx], hashList));
+
+        LOG_APPEND(TimedLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", static_cast<int>(idx), crc32s[idx], paths[idx].c_str());
     }
 
     PacketPreInit packetPreInit(peer);
@@ -428,6 +463,9 @@ void Networking::receiveMessage(RakNet::Packet *packet)
     if (packet->length < 2)
         return;
 
+    // Strings defined by a packet have to be learned even if its processor doesn't end up reading it
+    stringTables.readDefinitions(*packet);
+
     if (systemPacketController.ContainsPacket(packet->data[0]))
     {
         if (!SystemProcessor::Process(*packet))
@@ -455,6 +493,26 @@ void Networking::receiveMessage(RakNet::Packet *packet)
     }
 }
 
+void Networking::receiveBatch(RakNet::Packet *packet)
+{
+    if (!PacketBatcher::unpack(packet->data, packet->length, batchMessages))
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Received invalid ID_PACKET_BATCH of %u bytes", packet->length);
+        return;
+    }
+
+    // Each message is handled as if it had arrived on its own, in the order it was sent
+    RakNet::Packet message = *packet;
+
+    for (const auto &batchMessage : batchMessages)
+    {
+        message.data = const_cast<unsigned char *>(batchMessage.first);
+        message.length = batchMessage.second;
+        message.bitSize = BYTES_TO_BITS(batchMessage.second);
+        receiveMessage(&message);
+    }
+}
+
 SystemPacket *Networking::getSystemPacket(RakNet::MessageID id)
 {
     return systemPacketController.GetPacket(id);
@@ -505,6 +563,11 @@ Worldstate *Networking::getWorldstate()
     return &worldstate;
 }
 
+StringTables *Networking::getStringTables()
+{
+    return &stringTables;
+}
+
 bool Networking::isConnected()
 {
     return connected;
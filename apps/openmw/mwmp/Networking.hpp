@@ -6,6 +6,7 @@
 #include <string>
 
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Packets/StringTables.hpp>
 
 #include <components/openmw-mp/Controllers/SystemPacketController.hpp>
 #include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
@@ -51,6 +52,8 @@ namespace mwmp
         ObjectList *getObjectList();
         Worldstate *getWorldstate();
 
+        StringTables *getStringTables();
+
     private:
         bool connected;
         RakNet::RakPeerInterface *peer;
@@ -67,7 +70,13 @@ namespace mwmp
         ObjectList objectList;
         Worldstate worldstate;
 
+        StringTables stringTables;
+
+        // The messages of the last ID_PACKET_BATCH received, kept to reuse their storage
+        std::vector<std::pair<const unsigned char *, unsigned int>> batchMessages;
+
         void receiveMessage(RakNet::Packet *packet);
+        void receiveBatch(RakNet::Packet *packet);
 
         void preInit(std::vector<std::string> &content, Files::Collections &collections);
     };
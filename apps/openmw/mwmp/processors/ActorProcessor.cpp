@@ -23,27 +23,25 @@ bool ActorProcessor::Process(RakNet::Packet &packet, ActorList &actorList)
     myPacket->setActorList(&actorList);
     myPacket->SetReadStream(&bsIn);
 
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalPlayer()->guid;
-            request = packet.length == myPacket->headerSize();
+    auto processor = GetProcessor(packet.data[0]);
 
-            actorList.isValid = true;
+    if (processor == nullptr)
+        return false;
 
-            if (!request && !processor.second->avoidReading)
-            {
-                myPacket->Read();
-            }
+    myGuid = Main::get().getLocalPlayer()->guid;
+    request = packet.length == myPacket->headerSize();
 
-            if (actorList.isValid)
-                processor.second->Do(*myPacket, actorList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
+    actorList.isValid = true;
 
-            return true;
-        }
+    if (!request && !processor->avoidReading)
+    {
+        myPacket->Read();
     }
-    return false;
+
+    if (actorList.isValid)
+        processor->Do(*myPacket, actorList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
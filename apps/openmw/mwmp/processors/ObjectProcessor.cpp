@@ -23,26 +23,25 @@ bool ObjectProcessor::Process(RakNet::Packet &packet, ObjectList &objectList)
 
     myPacket->setObjectList(&objectList);
     myPacket->SetReadStream(&bsIn);
+    myPacket->setStringTables(Main::get().getNetworking()->getStringTables());
 
-    for (auto &processor: processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalPlayer()->guid;
-            request = packet.length == myPacket->headerSize();
+    auto processor = GetProcessor(packet.data[0]);
 
-            objectList.isValid = true;
+    if (processor == nullptr)
+        return false;
 
-            if (!request && !processor.second->avoidReading)
-                myPacket->Read();
+    myGuid = Main::get().getLocalPlayer()->guid;
+    request = packet.length == myPacket->headerSize();
 
-            if (objectList.isValid)
-                processor.second->Do(*myPacket, objectList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
+    objectList.isValid = true;
 
-            return true;
-        }
-    }
-    return false;
+    if (!request && !processor->avoidReading)
+        myPacket->Read();
+
+    if (objectList.isValid)
+        processor->Do(*myPacket, objectList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
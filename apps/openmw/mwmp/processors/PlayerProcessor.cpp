@@ -19,34 +19,33 @@ bool PlayerProcessor::Process(RakNet::Packet &packet)
 
     PlayerPacket *myPacket = Main::get().getNetworking()->getPlayerPacket(packet.data[0]);
     myPacket->SetReadStream(&bsIn);
+    myPacket->setStringTables(Main::get().getNetworking()->getStringTables());
 
     /*if (myPacket == 0)
     {
         // error: packet not found
     }*/
 
-    for (auto &processor : processors)
+    auto processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    myGuid = Main::get().getLocalPlayer()->guid;
+    request = packet.length == myPacket->headerSize();
+
+    BasePlayer *player = 0;
+    if (guid != myGuid)
+        player = PlayerList::getPlayer(guid);
+    else
+        player = Main::get().getLocalPlayer();
+
+    if (!request && !processor->avoidReading && player != 0)
     {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalPlayer()->guid;
-            request = packet.length == myPacket->headerSize();
-
-            BasePlayer *player = 0;
-            if (guid != myGuid)
-                player = PlayerList::getPlayer(guid);
-            else
-                player = Main::get().getLocalPlayer();
-
-            if (!request && !processor.second->avoidReading && player != 0)
-            {
-                myPacket->setPlayer(player);
-                myPacket->Read();
-            }
-
-            processor.second->Do(*myPacket, player);
-            return true;
-        }
+        myPacket->setPlayer(player);
+        myPacket->Read();
     }
-    return false;
+
+    processor->Do(*myPacket, player);
+    return true;
 }
@@ -36,6 +36,7 @@
 #include "player/ProcessorPlayerMiscellaneous.hpp"
 #include "player/ProcessorPlayerMomentum.hpp"
 #include "player/ProcessorPlayerPosition.hpp"
+#include "player/ProcessorPlayerPositionCompact.hpp"
 #include "player/ProcessorPlayerQuickKeys.hpp"
 #include "player/ProcessorPlayerReputation.hpp"
 #include "player/ProcessorPlayerRest.hpp"
@@ -143,6 +144,7 @@ void ProcessorInitializer()
     PlayerProcessor::AddProcessor(new ProcessorPlayerMiscellaneous());
     PlayerProcessor::AddProcessor(new ProcessorPlayerMomentum());
     PlayerProcessor::AddProcessor(new ProcessorPlayerPosition());
+    PlayerProcessor::AddProcessor(new ProcessorPlayerPositionCompact());
     PlayerProcessor::AddProcessor(new ProcessorPlayerQuickKeys());
     PlayerProcessor::AddProcessor(new ProcessorPlayerReputation());
     PlayerProcessor::AddProcessor(new ProcessorPlayerRest());
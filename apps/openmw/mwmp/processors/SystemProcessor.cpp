@@ -25,25 +25,23 @@ bool SystemProcessor::Process(RakNet::Packet &packet)
         // error: packet not found
     }*/
 
-    for (auto &processor : processors)
+    auto processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    myGuid = Main::get().getLocalSystem()->guid;
+    request = packet.length == myPacket->headerSize();
+
+    BaseSystem *system = 0;
+    system = Main::get().getLocalSystem();
+
+    if (!request && !processor->avoidReading && system != 0)
     {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalSystem()->guid;
-            request = packet.length == myPacket->headerSize();
-
-            BaseSystem *system = 0;
-            system = Main::get().getLocalSystem();
-
-            if (!request && !processor.second->avoidReading && system != 0)
-            {
-                myPacket->setSystem(system);
-                myPacket->Read();
-            }
-
-            processor.second->Do(*myPacket, system);
-            return true;
-        }
+        myPacket->setSystem(system);
+        myPacket->Read();
     }
-    return false;
+
+    processor->Do(*myPacket, system);
+    return true;
 }
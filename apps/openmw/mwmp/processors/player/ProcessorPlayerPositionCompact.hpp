@@ -0,0 +1,31 @@
+#ifndef OPENMW_PROCESSORPLAYERPOSITIONCOMPACT_HPP
+#define OPENMW_PROCESSORPLAYERPOSITIONCOMPACT_HPP
+
+
+#include "../PlayerProcessor.hpp"
+
+namespace mwmp
+{
+    class ProcessorPlayerPositionCompact final: public PlayerProcessor
+    {
+    public:
+        ProcessorPlayerPositionCompact()
+        {
+            BPP_INIT(ID_PLAYER_POSITION_COMPACT)
+        }
+
+        virtual void Do(PlayerPacket &packet, BasePlayer *player)
+        {
+            // The server only relays other players' positions this way, and deltas whose
+            // keyframe was lost are marked invalid without changing the player's position
+            if (isLocal() || player == 0 || !packet.isPacketValid())
+                return;
+
+            static_cast<DedicatedPlayer*>(player)->addPositionSnapshot();
+            static_cast<DedicatedPlayer*>(player)->updateMarker();
+        }
+    };
+}
+
+
+#endif //OPENMW_PROCESSORPLAYERPOSITIONCOMPACT_HPP
@@ -8,6 +8,15 @@
 #include <components/sceneutil/lightmanager.hpp>
 
 #include "apps/openmw/mwworld/esmstore.hpp"
+/*
+    Start of tes3mp addition
+
+    Include the cache of references read from content files
+*/
+#include "apps/openmw/mwworld/cellrefcache.hpp"
+/*
+    End of tes3mp addition
+*/
 #include "apps/openmw/mwbase/environment.hpp"
 #include "apps/openmw/mwbase/world.hpp"
 
@@ -164,7 +173,15 @@ namespace MWRender
         float mDensity = 0.f;
     };
 
-    inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+    /*
+        Start of tes3mp change (minor)
+
+        Take the reference as const, so references from the shared cache can be checked
+    */
+    inline bool isInChunkBorders(const ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+    /*
+        End of tes3mp change (minor)
+    */
     {
         osg::Vec2f size = maxBound - minBound;
         if (size.x() >=1 && size.y() >=1) return true;
@@ -208,7 +225,16 @@ namespace MWRender
         osg::Vec2f minBound = (center - osg::Vec2f(size/2.f, size/2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size/2.f, size/2.f));
         DensityCalculator calculator(mDensity);
-        std::vector<ESM::ESMReader> esm;
+        /*
+            Start of tes3mp change (major)
+
+            Get the references of cells from the shared cache instead of reading them from the content files
+            for every chunk
+        */
+        MWWorld::CellRefCache& cellRefCache = MWBase::Environment::get().getWorld()->getCellRefCache();
+        /*
+            End of tes3mp change (major)
+        */
         osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size/2.f), std::floor(center.y() - size/2.f));
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
         {
@@ -218,16 +244,19 @@ namespace MWRender
                 if (!cell) continue;
 
                 calculator.reset();
+                /*
+                    Start of tes3mp change (major)
+
+                    Get the references of cells from the shared cache instead of reading them from the content files
+                    for every chunk, still giving up on the chunk when a content file can't be read
+                */
                 for (size_t i=0; i<cell->mContextList.size(); ++i)
                 {
-                    unsigned int index = cell->mContextList.at(i).index;
-                    if (esm.size() <= index)
-                        esm.resize(index+1);
-                    cell->restore(esm[index], i);
-                    ESM::CellRef ref;
-                    ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
-                    bool deleted = false;
-                    while(cell->getNextRef(esm[index], ref, deleted))
+                    const auto cellRefs = cellRefCache.getRefs(*cell, i);
+                    if (!cellRefs->mError.empty())
+                        throw std::runtime_error(cellRefs->mError);
+
+                    for (const auto& [ref, deleted] : cellRefs->mRefs)
                     {
                         if (deleted) continue;
                         if (!ref.mRefNum.fromGroundcoverFile()) continue;
@@ -235,15 +264,17 @@ namespace MWRender
                         if (!calculator.isInstanceEnabled()) continue;
                         if (!isInChunkBorders(ref, minBound, maxBound)) continue;
 
-                        Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
                         int type = store.findStatic(ref.mRefID);
                         std::string model = getGroundcoverModel(type, ref.mRefID, store);
                         if (model.empty()) continue;
                         model = "meshes/" + model;
 
-                        instances[model].emplace_back(std::move(ref), std::move(model));
+                        instances[model].emplace_back(ref, std::move(model));
                     }
                 }
+                /*
+                    End of tes3mp change (major)
+                */
             }
         }
     }
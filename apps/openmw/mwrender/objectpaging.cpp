@@ -27,6 +27,15 @@
 #include <components/misc/rng.hpp>
 
 #include "apps/openmw/mwworld/esmstore.hpp"
+/*
+    Start of tes3mp addition
+
+    Include the cache of references read from content files
+*/
+#include "apps/openmw/mwworld/cellrefcache.hpp"
+/*
+    End of tes3mp addition
+*/
 #include "apps/openmw/mwbase/environment.hpp"
 #include "apps/openmw/mwbase/world.hpp"
 
@@ -405,8 +414,17 @@ namespace MWRender
         osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
 
         std::map<ESM::RefNum, ESM::CellRef> refs;
-        std::vector<ESM::ESMReader> esm;
         const MWWorld::ESMStore& store = MWBase::Environment::get().getWorld()->getStore();
+        /*
+            Start of tes3mp change (major)
+
+            Get the references of cells from the shared cache instead of reading them from the content files
+            for every chunk
+        */
+        MWWorld::CellRefCache& cellRefCache = MWBase::Environment::get().getWorld()->getCellRefCache();
+        /*
+            End of tes3mp change (major)
+        */
 
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
         {
@@ -414,33 +432,28 @@ namespace MWRender
             {
                 const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellX, cellY);
                 if (!cell) continue;
+                /*
+                    Start of tes3mp change (major)
+
+                    Get the references of cells from the shared cache instead of reading them from the content files
+                    for every chunk, ignoring any error like before
+                */
                 for (size_t i=0; i<cell->mContextList.size(); ++i)
                 {
-                    try
+                    const auto cellRefs = cellRefCache.getRefs(*cell, i);
+                    for (const auto& [ref, deleted] : cellRefs->mRefs)
                     {
-                        unsigned int index = cell->mContextList[i].index;
-                        if (esm.size()<=index)
-                            esm.resize(index+1);
-                        cell->restore(esm[index], i);
-                        ESM::CellRef ref;
-                        ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
-                        bool deleted = false;
-                        while(cell->getNextRef(esm[index], ref, deleted))
-                        {
-                            if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum) != cell->mMovedRefs.end()) continue;
-                            Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
-                            int type = store.findStatic(ref.mRefID);
-                            if (!typeFilter(type,size>=2)) continue;
-                            if (deleted) { refs.erase(ref.mRefNum); continue; }
-                            if (ref.mRefNum.fromGroundcoverFile()) continue;
-                            refs[ref.mRefNum] = std::move(ref);
-                        }
-                    }
-                    catch (std::exception&)
-                    {
-                        continue;
+                        if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum) != cell->mMovedRefs.end()) continue;
+                        int type = store.findStatic(ref.mRefID);
+                        if (!typeFilter(type,size>=2)) continue;
+                        if (deleted) { refs.erase(ref.mRefNum); continue; }
+                        if (ref.mRefNum.fromGroundcoverFile()) continue;
+                        refs[ref.mRefNum] = ref;
                     }
                 }
+                /*
+                    End of tes3mp change (major)
+                */
                 for (auto [ref, deleted] : cell->mLeasedRefs)
                 {
                     if (deleted) { refs.erase(ref.mRefNum); continue; }
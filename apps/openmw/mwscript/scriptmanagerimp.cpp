@@ -118,7 +118,18 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                /*
+                    Start of tes3mp change (minor)
+
+                    Run the script's decoded program, decoding it the first time it's run
+                */
+                if (iter->second.mProgram.empty())
+                    iter->second.mProgram = mInterpreter.decode (&iter->second.mByteCode[0], iter->second.mByteCode.size());
+
+                mInterpreter.run (iter->second.mProgram, interpreterContext);
+                /*
+                    End of tes3mp change (minor)
+                */
                 return true;
             }
             catch (const MissingImplicitRefError& e)
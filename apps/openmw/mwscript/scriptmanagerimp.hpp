@@ -46,6 +46,15 @@ namespace MWScript
                 std::vector<Interpreter::Type_Code> mByteCode;
                 Compiler::Locals mLocals;
                 bool mActive;
+                /*
+                    Start of tes3mp addition
+
+                    Keep the byte code with its opcodes looked up, so running the script doesn't decode it again
+                */
+                Interpreter::Program mProgram;
+                /*
+                    End of tes3mp addition
+                */
 
                 CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
                 {
@@ -0,0 +1,185 @@
+#include "cellrefcache.hpp"
+
+#include <osg/Stats>
+
+#include <components/esm/loadcell.hpp>
+#include <components/misc/stringops.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+namespace
+{
+    std::size_t getSize(const ESM::CellRef& ref)
+    {
+        return sizeof(std::pair<ESM::CellRef, bool>) + ref.mRefID.capacity() + ref.mOwner.capacity()
+            + ref.mGlobalVariable.capacity() + ref.mSoul.capacity() + ref.mFaction.capacity()
+            + ref.mDestCell.capacity() + ref.mKey.capacity() + ref.mTrap.capacity();
+    }
+}
+
+namespace MWWorld
+{
+    CellRefCache::CellRefCache(const ToUTF8::Utf8Encoder* encoder, std::size_t maxSize)
+        : mMaxSize(maxSize)
+        , mEncoder(encoder ? std::make_unique<ToUTF8::Utf8Encoder>(*encoder) : nullptr)
+        , mSize(0)
+        , mHitCount(0)
+        , mGetCount(0)
+    {
+    }
+
+    CellRefCache::~CellRefCache() = default;
+
+    std::shared_ptr<const CellRefCache::Refs> CellRefCache::getRefs(const ESM::Cell& cell, std::size_t contextIndex)
+    {
+        const ESM::ESM_Context& context = cell.mContextList.at(contextIndex);
+
+        if (mMaxSize == 0)
+        {
+            ESM::ESMReader reader;
+            const auto encoder = copyEncoder();
+            reader.setEncoder(encoder.get());
+            return read(cell, contextIndex, reader);
+        }
+
+        const Key key(context.index, context.filePos);
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            ++mGetCount;
+            if (auto refs = use(key))
+            {
+                ++mHitCount;
+                return refs;
+            }
+        }
+
+        Reader& reader = getReader(context.index);
+        const std::lock_guard<std::mutex> readLock(reader.mMutex);
+
+        // Another thread may have read the same context while this one was waiting
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            if (auto refs = use(key))
+                return refs;
+        }
+
+        std::shared_ptr<const Refs> refs = read(cell, contextIndex, reader.mReader);
+        insert(key, refs);
+        return refs;
+    }
+
+    void CellRefCache::clear()
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mEntries.clear();
+        mUses.clear();
+        mSize = 0;
+    }
+
+    CellRefCache::Stats CellRefCache::getStats() const
+    {
+        Stats result;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            result.mSize = mSize;
+            result.mContexts = mEntries.size();
+            result.mHitCount = mHitCount;
+            result.mGetCount = mGetCount;
+        }
+        return result;
+    }
+
+    void CellRefCache::reportStats(unsigned int frameNumber, osg::Stats& out) const
+    {
+        const Stats stats = getStats();
+        out.setAttribute(frameNumber, "CellRef CacheSize", stats.mSize);
+        out.setAttribute(frameNumber, "CellRef CachedContexts", stats.mContexts);
+        if (stats.mGetCount > 0)
+            out.setAttribute(frameNumber, "CellRef CacheHitRate", static_cast<double>(stats.mHitCount) / stats.mGetCount * 100.0);
+    }
+
+    std::shared_ptr<const CellRefCache::Refs> CellRefCache::use(const Key& key)
+    {
+        const auto it = mEntries.find(key);
+        if (it == mEntries.end())
+            return nullptr;
+
+        mUses.splice(mUses.begin(), mUses, it->second.mUsePosition);
+        return it->second.mRefs;
+    }
+
+    CellRefCache::Reader& CellRefCache::getReader(int index)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mReaders.size() <= static_cast<std::size_t>(index))
+            mReaders.resize(index + 1);
+
+        std::unique_ptr<Reader>& reader = mReaders[index];
+        if (!reader)
+        {
+            reader = std::make_unique<Reader>();
+            reader->mEncoder = copyEncoder();
+            reader->mReader.setEncoder(reader->mEncoder.get());
+        }
+
+        return *reader;
+    }
+
+    std::unique_ptr<ToUTF8::Utf8Encoder> CellRefCache::copyEncoder() const
+    {
+        return mEncoder ? std::make_unique<ToUTF8::Utf8Encoder>(*mEncoder) : nullptr;
+    }
+
+    std::shared_ptr<const CellRefCache::Refs> CellRefCache::read(const ESM::Cell& cell, std::size_t contextIndex,
+        ESM::ESMReader& reader)
+    {
+        auto refs = std::make_shared<Refs>();
+
+        try
+        {
+            // Reopen the ESM reader and seek to the right position.
+            cell.restore(reader, contextIndex);
+
+            ESM::CellRef ref;
+            ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
+
+            bool deleted = false;
+            while (cell.getNextRef(reader, ref, deleted))
+            {
+                Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
+                refs->mRefs.emplace_back(ref, deleted);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            refs->mError = e.what();
+        }
+
+        return refs;
+    }
+
+    void CellRefCache::insert(const Key& key, const std::shared_ptr<const Refs>& refs)
+    {
+        std::size_t size = sizeof(Refs) + refs->mError.capacity();
+        for (const auto& ref : refs->mRefs)
+            size += getSize(ref.first);
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        if (size > mMaxSize)
+            return;
+
+        mUses.push_front(key);
+        mEntries.emplace(key, Entry {refs, size, mUses.begin()});
+        mSize += size;
+
+        while (mSize > mMaxSize)
+        {
+            const auto it = mEntries.find(mUses.back());
+            mSize -= it->second.mSize;
+            mEntries.erase(it);
+            mUses.pop_back();
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef GAME_MWWORLD_CELLREFCACHE_H
+#define GAME_MWWORLD_CELLREFCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <components/esm/cellref.hpp>
+#include <components/esm/esmreader.hpp>
+
+namespace ESM
+{
+    struct Cell;
+}
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    /// \brief Cache of the references content files list for cells, shared by everything that reads them
+    ///
+    /// CellStore and the object paging and groundcover chunk builders all go through the same references,
+    /// and the chunk builders do it again every time a chunk is rebuilt. References are read once for each
+    /// of a cell's contexts and kept until the cache grows past its size limit, at which point the least
+    /// recently used ones are dropped.
+    ///
+    /// References are read through the cache's own readers, which each have their own copy of the encoder
+    /// and are only used by one thread at a time, so getRefs() can be called from any thread. Contexts in
+    /// different content files are read at the same time, while ones in the same content file wait for
+    /// each other.
+    ///
+    /// With a size limit of 0 nothing is cached or locked, and every call reads the references again with
+    /// a reader of its own.
+    class CellRefCache
+    {
+        public:
+
+            struct Refs
+            {
+                /// References in the order they're listed, with whether each is deleted. Moved references
+                /// are included, and IDs are lower case.
+                std::vector<std::pair<ESM::CellRef, bool>> mRefs;
+
+                /// Why reading stopped before the end of the context, if it did
+                std::string mError;
+            };
+
+            struct Stats
+            {
+                std::size_t mSize = 0;
+                std::size_t mContexts = 0;
+                std::size_t mHitCount = 0;
+                std::size_t mGetCount = 0;
+            };
+
+            /// \param encoder Encoding to read strings with, which is copied so it's only used by the cache
+            /// \param maxSize Approximate number of bytes the cached references can take up
+            CellRefCache(const ToUTF8::Utf8Encoder* encoder, std::size_t maxSize);
+
+            ~CellRefCache();
+
+            /// Get the references listed by one of a cell's contexts, reading them if they aren't cached.
+            std::shared_ptr<const Refs> getRefs(const ESM::Cell& cell, std::size_t contextIndex);
+
+            void clear();
+
+            Stats getStats() const;
+
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+        private:
+
+            // Content file index and position of a context
+            typedef std::pair<int, std::size_t> Key;
+
+            struct Entry
+            {
+                std::shared_ptr<const Refs> mRefs;
+                std::size_t mSize;
+                std::list<Key>::iterator mUsePosition;
+            };
+
+            // A content file's reader, used by one thread at a time
+            struct Reader
+            {
+                std::mutex mMutex;
+                ESM::ESMReader mReader;
+                std::unique_ptr<ToUTF8::Utf8Encoder> mEncoder;
+            };
+
+            /// Get a cached entry and make it the most recently used one, with mMutex locked
+            std::shared_ptr<const Refs> use(const Key& key);
+
+            /// Get the reader of a content file, creating it if there isn't one yet
+            Reader& getReader(int index);
+
+            std::unique_ptr<ToUTF8::Utf8Encoder> copyEncoder() const;
+
+            static std::shared_ptr<const Refs> read(const ESM::Cell& cell, std::size_t contextIndex,
+                ESM::ESMReader& reader);
+
+            void insert(const Key& key, const std::shared_ptr<const Refs>& refs);
+
+            const std::size_t mMaxSize;
+            std::unique_ptr<ToUTF8::Utf8Encoder> mEncoder;
+
+            mutable std::mutex mMutex;
+            std::map<Key, Entry> mEntries;
+            // Most recently used first
+            std::list<Key> mUses;
+            std::size_t mSize;
+            std::size_t mHitCount;
+            std::size_t mGetCount;
+
+            // By content file index, only ever added to while mMutex is locked, so the readers don't move
+            std::vector<std::unique_ptr<Reader>> mReaders;
+    };
+}
+
+#endif
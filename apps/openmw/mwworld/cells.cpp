@@ -69,7 +69,15 @@ MWWorld::CellStore *MWWorld::Cells::getCellStore (const ESM::Cell *cell)
 
         if (result==mInteriors.end())
         {
-            result = mInteriors.insert (std::make_pair (lowerName, CellStore (cell, mStore, mReader))).first;
+            /*
+                Start of tes3mp change (minor)
+
+                Cells don't have readers of their own anymore
+            */
+            result = mInteriors.insert (std::make_pair (lowerName, CellStore (cell, mStore))).first;
+            /*
+                End of tes3mp change (minor)
+            */
         }
 
         return &result->second;
@@ -81,8 +89,16 @@ MWWorld::CellStore *MWWorld::Cells::getCellStore (const ESM::Cell *cell)
 
         if (result==mExteriors.end())
         {
+            /*
+                Start of tes3mp change (minor)
+
+                Cells don't have readers of their own anymore
+            */
             result = mExteriors.insert (std::make_pair (
-                std::make_pair (cell->getGridX(), cell->getGridY()), CellStore (cell, mStore, mReader))).first;
+                std::make_pair (cell->getGridX(), cell->getGridY()), CellStore (cell, mStore))).first;
+            /*
+                End of tes3mp change (minor)
+            */
 
         }
 
@@ -153,13 +169,21 @@ void MWWorld::Cells::writeCell (ESM::ESMWriter& writer, CellStore& cell) const
     writer.endRecord (ESM::REC_CSTA);
 }
 
-MWWorld::Cells::Cells (const MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& reader)
-: mStore (store), mReader (reader),
+/*
+    Start of tes3mp change (minor)
+
+    Don't take the world's readers, because cells read their references through the CellRefCache
+*/
+MWWorld::Cells::Cells (const MWWorld::ESMStore& store)
+: mStore (store),
   mIdCacheIndex (0)
 {
     int cacheSize = std::clamp(Settings::Manager::getInt("pointers cache size", "Cells"), 40, 1000);
     mIdCache = IdCache(cacheSize, std::pair<std::string, CellStore *> ("", (CellStore*)nullptr));
 }
+/*
+    End of tes3mp change (minor)
+*/
 
 MWWorld::CellStore *MWWorld::Cells::getExterior (int x, int y)
 {
@@ -188,8 +212,16 @@ MWWorld::CellStore *MWWorld::Cells::getExterior (int x, int y)
             cell = MWBase::Environment::get().getWorld()->createRecord (record);
         }
 
+        /*
+            Start of tes3mp change (minor)
+
+            Cells don't have readers of their own anymore
+        */
         result = mExteriors.insert (std::make_pair (
-            std::make_pair (x, y), CellStore (cell, mStore, mReader))).first;
+            std::make_pair (x, y), CellStore (cell, mStore))).first;
+        /*
+            End of tes3mp change (minor)
+        */
     }
 
     if (result->second.getState()!=CellStore::State_Loaded)
@@ -209,7 +241,15 @@ MWWorld::CellStore *MWWorld::Cells::getInterior (const std::string& name)
     {
         const ESM::Cell *cell = mStore.get<ESM::Cell>().find(lowerName);
 
-        result = mInteriors.insert (std::make_pair (lowerName, CellStore (cell, mStore, mReader))).first;
+        /*
+            Start of tes3mp change (minor)
+
+            Cells don't have readers of their own anymore
+        */
+        result = mInteriors.insert (std::make_pair (lowerName, CellStore (cell, mStore))).first;
+        /*
+            End of tes3mp change (minor)
+        */
     }
 
     if (result->second.getState()!=CellStore::State_Loaded)
@@ -30,7 +30,6 @@ namespace MWWorld
     {
             typedef std::vector<std::pair<std::string, CellStore *> > IdCache;
             const MWWorld::ESMStore& mStore;
-            std::vector<ESM::ESMReader>& mReader;
             mutable std::map<std::string, CellStore> mInteriors;
             mutable std::map<std::pair<int, int>, CellStore> mExteriors;
             IdCache mIdCache;
@@ -62,7 +61,15 @@ namespace MWWorld
                 End of tes3mp addition
             */
 
-            Cells (const MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& reader);
+            /*
+                Start of tes3mp change (minor)
+
+                Don't take the world's readers, because cells read their references through the CellRefCache
+            */
+            Cells (const MWWorld::ESMStore& store);
+            /*
+                End of tes3mp change (minor)
+            */
 
             CellStore *getExterior (int x, int y);
 
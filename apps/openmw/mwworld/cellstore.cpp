@@ -39,6 +39,15 @@
 
 #include "ptr.hpp"
 #include "esmstore.hpp"
+/*
+    Start of tes3mp addition
+
+    Include the cache of references read from content files
+*/
+#include "cellrefcache.hpp"
+/*
+    End of tes3mp addition
+*/
 #include "class.hpp"
 #include "containerstore.hpp"
 
@@ -303,6 +312,16 @@ namespace MWWorld
             mMovedHere.insert(std::make_pair(object.getBase(), from));
         }
         updateMergedRefs();
+
+        /*
+            Start of tes3mp addition
+
+            Keep the index of references by their numbers current without rebuilding it
+        */
+        mRefNumIndex.add(object.getBase());
+        /*
+            End of tes3mp addition
+        */
     }
 
     MWWorld::Ptr CellStore::moveTo(const Ptr &object, CellStore *cellToMoveTo)
@@ -318,6 +337,16 @@ namespace MWWorld
         if (searchViaRefNum(object.getCellRef().getRefNum()).isEmpty())
             throw std::runtime_error("moveTo: object is not in this cell");
 
+        /*
+            Start of tes3mp addition
+
+            Rebuild the index of references by their numbers once the object has left
+        */
+        mRefNumIndex.invalidate();
+        /*
+            End of tes3mp addition
+        */
+
 
         // Objects with no refnum can't be handled correctly in the merging process that happens
         // on a save/load, so do a simple copy & delete for these objects.
@@ -481,11 +510,19 @@ namespace MWWorld
         return false;
     }
 
-    CellStore::CellStore (const ESM::Cell *cell, const MWWorld::ESMStore& esmStore, std::vector<ESM::ESMReader>& readerList)
-        : mStore(esmStore), mReader(readerList), mCell (cell), mState (State_Unloaded), mHasState (false), mLastRespawn(0,0), mRechargingItemsUpToDate(false)
+    /*
+        Start of tes3mp change (minor)
+
+        Don't take the world's readers, because references are read through the CellRefCache
+    */
+    CellStore::CellStore (const ESM::Cell *cell, const MWWorld::ESMStore& esmStore)
+        : mStore(esmStore), mCell (cell), mState (State_Unloaded), mHasState (false), mLastRespawn(0,0), mRechargingItemsUpToDate(false)
     {
         mWaterLevel = cell->mWater;
     }
+    /*
+        End of tes3mp change (minor)
+    */
 
     const ESM::Cell *CellStore::getCell() const
     {
@@ -665,9 +702,23 @@ namespace MWWorld
         if (refNum == 0 && mpNum == 0)
             return 0;
 
-        SearchExactVisitor searchVisitor(refNum, mpNum);
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+        LiveCellRefBase* found;
+
+        switch (searchRefNumIndex(refNum, mpNum, found))
+        {
+            case TRefNumIndex::Search_Found:
+                return isAccessible(found->mData, found->mRef) ? Ptr(found, this) : Ptr();
+            case TRefNumIndex::Search_Ambiguous:
+            {
+                // References from different content files can share a refNum, so pick the first
+                // accessible one the same way as before there was an index
+                SearchExactVisitor searchVisitor(refNum, mpNum);
+                forEach(searchVisitor);
+                return searchVisitor.mFound;
+            }
+            default:
+                return Ptr();
+        }
     }
     /*
         End of tes3mp addition
@@ -685,9 +736,49 @@ namespace MWWorld
         if (refNum == 0 && mpNum == 0)
             return 0;
 
-        SearchExactPlusVisitor searchVisitor(refId, refNum, mpNum);
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+        LiveCellRefBase* found;
+
+        switch (searchRefNumIndex(refNum, mpNum, found))
+        {
+            case TRefNumIndex::Search_Found:
+                if (!isAccessible(found->mData, found->mRef) || !Misc::StringUtils::ciEqual(found->mRef.getRefId(), refId))
+                    return Ptr();
+
+                return Ptr(found, this);
+            case TRefNumIndex::Search_Ambiguous:
+            {
+                SearchExactPlusVisitor searchVisitor(refId, refNum, mpNum);
+                forEach(searchVisitor);
+                return searchVisitor.mFound;
+            }
+            default:
+                return Ptr();
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Find the references with these numbers through mRefNumIndex instead of visiting every
+        reference in the cell
+    */
+    CellStore::TRefNumIndex::SearchResult CellStore::searchRefNumIndex(unsigned int refNum, unsigned int mpNum, LiveCellRefBase*& found)
+    {
+        found = nullptr;
+
+        if (mState != State_Loaded || mMergedRefs.empty())
+            return TRefNumIndex::Search_NotFound;
+
+        // Searches are expected to trigger the hasState flag the same way forEach() does
+        mHasState = true;
+
+        if (!mRefNumIndex.isUpToDate())
+            mRefNumIndex.rebuild(mMergedRefs);
+
+        return mRefNumIndex.search(refNum, mpNum, found);
     }
     /*
         End of tes3mp addition
@@ -801,47 +892,45 @@ namespace MWWorld
 
     void CellStore::listRefs()
     {
-        std::vector<ESM::ESMReader>& esm = mReader;
-
         assert (mCell);
 
         if (mCell->mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
 
+        /*
+            Start of tes3mp change (major)
+
+            Get the references from the cache shared with loadRefs() and the distant object and groundcover
+            chunk builders, which only reads them from the content files if they aren't there already
+        */
+        CellRefCache& cellRefCache = MWBase::Environment::get().getWorld()->getCellRefCache();
+
         // Load references from all plugins that do something with this cell.
         for (size_t i = 0; i < mCell->mContextList.size(); i++)
         {
-            try
-            {
-                // Reopen the ESM reader and seek to the right position.
-                int index = mCell->mContextList[i].index;
-                mCell->restore (esm[index], i);
+            const auto cellRefs = cellRefCache.getRefs(*mCell, i);
 
-                ESM::CellRef ref;
-
-                // Get each reference in turn
-                bool deleted = false;
-                while (mCell->getNextRef (esm[index], ref, deleted))
-                {
-                    if (deleted)
-                        continue;
-
-                    // Don't list reference if it was moved to a different cell.
-                    ESM::MovedCellRefTracker::const_iterator iter =
-                        std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
-                    if (iter != mCell->mMovedRefs.end()) {
-                        continue;
-                    }
+            for (const auto& [ref, deleted] : cellRefs->mRefs)
+            {
+                if (deleted)
+                    continue;
 
-                    Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
-                    mIds.push_back(std::move(ref.mRefID));
+                // Don't list reference if it was moved to a different cell.
+                ESM::MovedCellRefTracker::const_iterator iter =
+                    std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
+                if (iter != mCell->mMovedRefs.end()) {
+                    continue;
                 }
+
+                mIds.push_back(ref.mRefID);
             }
-            catch (std::exception& e)
-            {
-                Log(Debug::Error) << "An error occurred listing references for cell " << getCell()->getDescription() << ": " << e.what();
-            }
+
+            if (!cellRefs->mError.empty())
+                Log(Debug::Error) << "An error occurred listing references for cell " << getCell()->getDescription() << ": " << cellRefs->mError;
         }
+        /*
+            End of tes3mp change (major)
+        */
 
         // List moved references, from separately tracked list.
         for (const auto& [ref, deleted]: mCell->mLeasedRefs)
@@ -855,8 +944,6 @@ namespace MWWorld
 
     void CellStore::loadRefs()
     {
-        std::vector<ESM::ESMReader>& esm = mReader;
-
         assert (mCell);
 
         if (mCell->mContextList.empty())
@@ -864,37 +951,46 @@ namespace MWWorld
 
         std::map<ESM::RefNum, std::string> refNumToID; // used to detect refID modifications
 
+        /*
+            Start of tes3mp change (major)
+
+            Get the references from the cache shared with listRefs() and the distant object and groundcover
+            chunk builders, which only reads them from the content files if they aren't there already
+        */
+        CellRefCache& cellRefCache = MWBase::Environment::get().getWorld()->getCellRefCache();
+
         // Load references from all plugins that do something with this cell.
         for (size_t i = 0; i < mCell->mContextList.size(); i++)
         {
+            const auto cellRefs = cellRefCache.getRefs(*mCell, i);
+            std::string error = cellRefs->mError;
+
             try
             {
-                // Reopen the ESM reader and seek to the right position.
-                int index = mCell->mContextList[i].index;
-                mCell->restore (esm[index], i);
-
-                ESM::CellRef ref;
-                ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
-
-                // Get each reference in turn
-                bool deleted = false;
-                while(mCell->getNextRef(esm[index], ref, deleted))
+                for (const auto& [cachedRef, deleted] : cellRefs->mRefs)
                 {
                     // Don't load reference if it was moved to a different cell.
                     ESM::MovedCellRefTracker::const_iterator iter =
-                        std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
+                        std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), cachedRef.mRefNum);
                     if (iter != mCell->mMovedRefs.end()) {
                         continue;
                     }
 
+                    ESM::CellRef ref = cachedRef;
                     loadRef (ref, deleted, refNumToID);
                 }
             }
             catch (std::exception& e)
             {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription() << ": " << e.what();
+                error = e.what();
             }
+
+            if (!error.empty())
+                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription() << ": " << error;
         }
+        /*
+            End of tes3mp change (major)
+        */
 
         // Load moved references, from separately tracked list.
         for (const auto& leasedRef : mCell->mLeasedRefs)
@@ -906,6 +1002,16 @@ namespace MWWorld
         }
 
         updateMergedRefs();
+
+        /*
+            Start of tes3mp addition
+
+            Rebuild the index of references by their numbers on the next search
+        */
+        mRefNumIndex.invalidate();
+        /*
+            End of tes3mp addition
+        */
     }
 
     bool CellStore::isExterior() const
@@ -1219,6 +1325,16 @@ namespace MWWorld
         // This update is only needed for old saves that used the old copy&delete way of moving objects
         updateMergedRefs();
 
+        /*
+            Start of tes3mp addition
+
+            Rebuild the index of references by their numbers on the next search
+        */
+        mRefNumIndex.invalidate();
+        /*
+            End of tes3mp addition
+        */
+
         while (reader.isNextSub("MVRF"))
         {
             reader.cacheSubName();
@@ -11,6 +11,16 @@
 #include "livecellref.hpp"
 #include "cellreflist.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include "refnumindex.hpp"
+/*
+    End of tes3mp addition
+*/
+
 #include <components/esm/loadacti.hpp>
 #include <components/esm/loadalch.hpp>
 #include <components/esm/loadappa.hpp>
@@ -61,7 +71,6 @@ namespace MWWorld
         private:
 
             const MWWorld::ESMStore& mStore;
-            std::vector<ESM::ESMReader>& mReader;
 
             // Even though fog actually belongs to the player and not cells,
             // it makes sense to store it here since we need it once for each cell.
@@ -125,6 +134,25 @@ namespace MWWorld
 
             bool mRechargingItemsUpToDate;
 
+            /*
+                Start of tes3mp addition
+
+                Index mMergedRefs by refNum and mpNum for searchExact() and searchExactPlus()
+            */
+            struct RefNumbers
+            {
+                static unsigned int getRefNum(const LiveCellRefBase& ref) { return ref.mRef.getRefNum().mIndex; }
+                static unsigned int getMpNum(const LiveCellRefBase& ref) { return ref.mRef.getMpNum(); }
+            };
+
+            typedef RefNumIndex<LiveCellRefBase, RefNumbers> TRefNumIndex;
+            TRefNumIndex mRefNumIndex;
+
+            TRefNumIndex::SearchResult searchRefNumIndex(unsigned int refNum, unsigned int mpNum, LiveCellRefBase*& found);
+            /*
+                End of tes3mp addition
+            */
+
             void updateRechargingItems();
             void rechargeItems(float duration);
             void checkItem(Ptr ptr);
@@ -218,13 +246,30 @@ namespace MWWorld
                 CellRefList<T>& list = get<T>();
                 LiveCellRefBase* ret = &list.insert(*ref);
                 updateMergedRefs();
+
+                /*
+                    Start of tes3mp addition
+
+                    Keep the index of references by their numbers current without rebuilding it
+                */
+                mRefNumIndex.add(ret);
+                /*
+                    End of tes3mp addition
+                */
+
                 return ret;
             }
 
-            /// @param readerList The readers to use for loading of the cell on-demand.
+            /*
+                Start of tes3mp change (minor)
+
+                Don't take the world's readers, because references are read through the CellRefCache
+            */
             CellStore (const ESM::Cell *cell_,
-                       const MWWorld::ESMStore& store,
-                       std::vector<ESM::ESMReader>& readerList);
+                       const MWWorld::ESMStore& store);
+            /*
+                End of tes3mp change (minor)
+            */
 
             const ESM::Cell *getCell() const;
 
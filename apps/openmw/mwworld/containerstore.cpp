@@ -223,7 +223,8 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::unstack(const Ptr &ptr,
     /*
         Start of tes3mp addition
 
-        Send an ID_PLAYER_INVENTORY packet every time an item stack gets added for a player here
+        Queue an item change for the next ID_PLAYER_INVENTORY packet every time an item stack gets added
+        for a player here
     */
     Ptr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
 
@@ -232,7 +233,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::unstack(const Ptr &ptr,
         mwmp::LocalPlayer *localPlayer = mwmp::Main::get().getLocalPlayer();
 
         if (!localPlayer->avoidSendingInventoryPackets)
-            localPlayer->sendItemChange(ptr, ptr.getRefData().getCount() - count, mwmp::InventoryChanges::ADD);
+            localPlayer->queueItemChange(ptr, ptr.getRefData().getCount() - count, mwmp::InventoryChanges::ADD);
     }
     /*
         End of tes3mp addition
@@ -329,7 +330,8 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::add (const Ptr& itemPtr
     /*
         Start of tes3mp addition
 
-        Send an ID_PLAYER_INVENTORY packet every time an item gets added for a player here
+        Queue an item change for the next ID_PLAYER_INVENTORY packet every time an item gets added for a
+        player here
     */
     if (actorPtr == player && this == &player.getClass().getContainerStore(player))
     {
@@ -344,7 +346,7 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::add (const Ptr& itemPtr
                 realCount = realCount * itemPtr.getClass().getValue(itemPtr);
             }
 
-            localPlayer->sendItemChange(item, realCount, mwmp::InventoryChanges::ADD);
+            localPlayer->queueItemChange(item, realCount, mwmp::InventoryChanges::ADD);
         }
     }
     /*
@@ -558,7 +560,8 @@ int MWWorld::ContainerStore::remove(const Ptr& item, int count, const Ptr& actor
     /*
         Start of tes3mp addition
 
-        Send an ID_PLAYER_INVENTORY packet every time an item gets removed for a player here
+        Queue an item change for the next ID_PLAYER_INVENTORY packet every time an item gets removed for a
+        player here
     */
     Ptr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
 
@@ -567,7 +570,7 @@ int MWWorld::ContainerStore::remove(const Ptr& item, int count, const Ptr& actor
         mwmp::LocalPlayer *localPlayer = mwmp::Main::get().getLocalPlayer();
 
         if (!localPlayer->avoidSendingInventoryPackets)
-            localPlayer->sendItemChange(item, count, mwmp::InventoryChanges::REMOVE);
+            localPlayer->queueItemChange(item, count, mwmp::InventoryChanges::REMOVE);
     }
     /*
         End of tes3mp addition
@@ -3,6 +3,21 @@
 #include <algorithm>
 #include <set>
 
+/*
+    Start of tes3mp addition
+
+    Parse the records of content files on worker threads
+*/
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+/*
+    End of tes3mp addition
+*/
+
 #include <boost/filesystem/operations.hpp>
 
 #include <components/debug/debuglog.hpp>
@@ -11,6 +26,16 @@
 #include <components/esm/esmwriter.hpp>
 #include <components/misc/algorithm.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Parse the records of content files on worker threads
+*/
+#include <components/files/memorystream.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include "../mwmechanics/spelllist.hpp"
 
 namespace
@@ -128,6 +153,305 @@ static bool isCacheableRecord(int id)
     return false;
 }
 
+/*
+    Start of tes3mp addition
+
+    Parse the records of content files on worker threads
+*/
+// Records of generic stores that don't depend on the records before them or on the file header,
+// so they can be parsed on any thread
+static bool isDecodableRecord(int id)
+{
+    if (id == ESM::REC_ACTI || id == ESM::REC_ALCH || id == ESM::REC_APPA || id == ESM::REC_ARMO ||
+        id == ESM::REC_BODY || id == ESM::REC_BOOK || id == ESM::REC_BSGN || id == ESM::REC_CLAS ||
+        id == ESM::REC_CLOT || id == ESM::REC_CONT || id == ESM::REC_CREA || id == ESM::REC_DOOR ||
+        id == ESM::REC_ENCH || id == ESM::REC_FACT || id == ESM::REC_GLOB || id == ESM::REC_GMST ||
+        id == ESM::REC_INGR || id == ESM::REC_LEVC || id == ESM::REC_LEVI || id == ESM::REC_LIGH ||
+        id == ESM::REC_LOCK || id == ESM::REC_MISC || id == ESM::REC_NPC_ || id == ESM::REC_PROB ||
+        id == ESM::REC_RACE || id == ESM::REC_REPA || id == ESM::REC_SCPT || id == ESM::REC_SNDG ||
+        id == ESM::REC_SOUN || id == ESM::REC_SPEL || id == ESM::REC_SSCR || id == ESM::REC_STAT ||
+        id == ESM::REC_WEAP)
+    {
+        return true;
+    }
+    return false;
+}
+
+namespace
+{
+    // Name, size, an unused field and flags
+    constexpr std::size_t recordHeaderSize = 16;
+
+    // Amount of record data handed to a worker thread at once
+    constexpr std::size_t recordBatchSize = 256 * 1024;
+
+    struct ScannedRecord
+    {
+        std::size_t mOffset;
+        // Store the record is parsed by on a worker thread, nullptr if it's loaded on the main thread
+        StoreBase *mStore;
+        std::unique_ptr<StoreBase::DecodedRecord> mDecoded;
+    };
+
+    // Consecutive records of a file, with a copy of the ones parsed on a worker thread
+    struct RecordBatch
+    {
+        std::vector<ScannedRecord> mRecords;
+        std::vector<char> mData;
+        std::size_t mEnd = 0;
+        bool mDecoded = false;
+        std::exception_ptr mError;
+    };
+
+    class RecordDecoder
+    {
+        public:
+
+            RecordDecoder(std::size_t threads, const std::string &fileName, const ToUTF8::Utf8Encoder *encoder)
+                : mFileName(fileName)
+                , mStopped(false)
+            {
+                // Encoders keep their output in a buffer of their own, so they can't be shared between threads
+                for (std::size_t i = 0; i < threads; ++i)
+                    mEncoders.push_back(encoder != nullptr ? std::make_unique<ToUTF8::Utf8Encoder>(*encoder) : nullptr);
+
+                for (std::size_t i = 0; i < threads; ++i)
+                    mThreads.emplace_back([this, i] { run(mEncoders[i].get()); });
+            }
+
+            ~RecordDecoder()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mMutex);
+                    mStopped = true;
+                }
+                mHasBatches.notify_all();
+                for (std::thread &thread : mThreads)
+                    thread.join();
+            }
+
+            void push(RecordBatch &batch)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mMutex);
+                    mBatches.push_back(&batch);
+                }
+                mHasBatches.notify_one();
+            }
+
+            void wait(RecordBatch &batch)
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mBatchDecoded.wait(lock, [&] { return batch.mDecoded; });
+                if (batch.mError)
+                    std::rethrow_exception(batch.mError);
+            }
+
+        private:
+
+            const std::string mFileName;
+            std::vector<std::unique_ptr<ToUTF8::Utf8Encoder>> mEncoders;
+            std::mutex mMutex;
+            std::condition_variable mHasBatches;
+            std::condition_variable mBatchDecoded;
+            std::deque<RecordBatch*> mBatches;
+            bool mStopped;
+            std::vector<std::thread> mThreads;
+
+            void run(ToUTF8::Utf8Encoder *encoder)
+            {
+                ESM::ESMReader reader;
+                reader.setEncoder(encoder);
+
+                while (true)
+                {
+                    RecordBatch *batch = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(mMutex);
+                        mHasBatches.wait(lock, [&] { return mStopped || !mBatches.empty(); });
+                        if (mStopped)
+                            return;
+                        batch = mBatches.front();
+                        mBatches.pop_front();
+                    }
+
+                    try
+                    {
+                        decode(reader, *batch);
+                    }
+                    catch (...)
+                    {
+                        batch->mError = std::current_exception();
+                    }
+
+                    {
+                        const std::lock_guard<std::mutex> lock(mMutex);
+                        batch->mDecoded = true;
+                    }
+                    mBatchDecoded.notify_all();
+                }
+            }
+
+            void decode(ESM::ESMReader &reader, RecordBatch &batch) const
+            {
+                reader.openRaw(std::make_shared<Files::IMemStream>(batch.mData.data(), batch.mData.size()), mFileName);
+
+                for (ScannedRecord &record : batch.mRecords)
+                {
+                    if (record.mStore == nullptr)
+                        continue;
+
+                    reader.getRecName();
+                    reader.getRecHeader();
+                    record.mDecoded = record.mStore->decode(reader);
+                }
+
+                reader.close();
+            }
+    };
+}
+
+void ESMStore::loadRecord(ESM::ESMReader &esm, ESM::Dialogue *&dialogue)
+{
+    ESM::NAME n = esm.getRecName();
+    esm.getRecHeader();
+
+    // Look up the record type.
+    std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+
+    if (it == mStores.end()) {
+        if (n.intval == ESM::REC_INFO) {
+            if (dialogue)
+            {
+                dialogue->readInfo(esm, esm.getIndex() != 0);
+            }
+            else
+            {
+                Log(Debug::Error) << "Error: info record without dialog";
+                esm.skipRecord();
+            }
+        } else if (n.intval == ESM::REC_MGEF) {
+            mMagicEffects.load (esm);
+        } else if (n.intval == ESM::REC_SKIL) {
+            mSkills.load (esm);
+        }
+        else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+        {
+            // ignore project file only records
+            esm.skipRecord();
+        }
+        else {
+            std::stringstream error;
+            error << "Unknown record: " << n.toString();
+            throw std::runtime_error(error.str());
+        }
+    } else {
+        RecordId id = it->second->load(esm);
+        if (id.mIsDeleted)
+        {
+            it->second->eraseStatic(id.mId);
+            return;
+        }
+
+        if (n.intval==ESM::REC_DIAL) {
+            dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
+        } else {
+            dialogue = nullptr;
+        }
+    }
+}
+
+void ESMStore::loadDecoded(ESM::ESMReader &esm, Loading::Listener* listener)
+{
+    ESM::Dialogue *dialogue = nullptr;
+
+    // Records loaded on this thread are read by going back to where they start in the file
+    const ESM::ESM_Context start = esm.getContext();
+    std::size_t offset = start.filePos;
+
+    // Declared before the decoder, so its threads are done with the batches when they're destroyed
+    std::deque<std::unique_ptr<RecordBatch>> batches;
+    RecordDecoder decoder(mLoadingThreads, esm.getName(), esm.getEncoder());
+
+    while (esm.hasMoreRecs() || !batches.empty())
+    {
+        // Keep the worker threads busy while this thread adds the oldest batch to the stores
+        while (esm.hasMoreRecs() && batches.size() < 2 * mLoadingThreads)
+        {
+            batches.push_back(std::make_unique<RecordBatch>());
+            RecordBatch &batch = *batches.back();
+
+            while (esm.hasMoreRecs() && batch.mData.size() < recordBatchSize)
+            {
+                const ESM::NAME name = esm.getRecName();
+                uint32_t flags = 0;
+                esm.getRecHeader(flags);
+
+                if (!isDecodableRecord(name.intval))
+                {
+                    batch.mRecords.push_back(ScannedRecord {offset, nullptr, nullptr});
+                    esm.skipRecord();
+                    offset = esm.getFileOffset();
+                    continue;
+                }
+
+                batch.mRecords.push_back(ScannedRecord {offset, mStores.find(name.intval)->second, nullptr});
+
+                const std::size_t begin = batch.mData.size();
+                batch.mData.resize(begin + recordHeaderSize);
+                esm.getRecordData(batch.mData);
+
+                const uint32_t size = static_cast<uint32_t>(batch.mData.size() - begin - recordHeaderSize);
+                const uint32_t header[] = {name.intval, size, 0, flags};
+                std::memcpy(batch.mData.data() + begin, header, recordHeaderSize);
+                offset += recordHeaderSize + size;
+            }
+
+            batch.mEnd = offset;
+            decoder.push(batch);
+        }
+
+        RecordBatch &batch = *batches.front();
+        decoder.wait(batch);
+
+        const ESM::ESM_Context scanned = esm.getContext();
+        bool moved = false;
+
+        for (ScannedRecord &record : batch.mRecords)
+        {
+            if (record.mStore == nullptr)
+            {
+                ESM::ESM_Context context = start;
+                context.filePos = record.mOffset;
+                context.leftFile = start.leftFile - (record.mOffset - start.filePos);
+                esm.restoreContext(context);
+                moved = true;
+
+                loadRecord(esm, dialogue);
+                continue;
+            }
+
+            const RecordId id = record.mDecoded->insert();
+            if (id.mIsDeleted)
+            {
+                record.mStore->eraseStatic(id.mId);
+                continue;
+            }
+
+            dialogue = nullptr;
+        }
+
+        if (moved)
+            esm.restoreContext(scanned);
+
+        listener->setProgress(static_cast<size_t>(batch.mEnd / (float)esm.getFileSize() * 1000));
+        batches.pop_front();
+    }
+}
+/*
+    End of tes3mp addition
+*/
+
 void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
 {
     listener->setProgressRange(1000);
@@ -168,57 +492,27 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         esm.addParentFileIndex(index);
     }
 
+    /*
+        Start of tes3mp change (minor)
+
+        Parse records on worker threads when there are any, and move the loading of a single
+        record to a method of its own to share it with them
+    */
+    if (mLoadingThreads > 0)
+    {
+        loadDecoded(esm, listener);
+        return;
+    }
+
     // Loop through all records
     while(esm.hasMoreRecs())
     {
-        ESM::NAME n = esm.getRecName();
-        esm.getRecHeader();
-
-        // Look up the record type.
-        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
-
-        if (it == mStores.end()) {
-            if (n.intval == ESM::REC_INFO) {
-                if (dialogue)
-                {
-                    dialogue->readInfo(esm, esm.getIndex() != 0);
-                }
-                else
-                {
-                    Log(Debug::Error) << "Error: info record without dialog";
-                    esm.skipRecord();
-                }
-            } else if (n.intval == ESM::REC_MGEF) {
-                mMagicEffects.load (esm);
-            } else if (n.intval == ESM::REC_SKIL) {
-                mSkills.load (esm);
-            }
-            else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
-            {
-                // ignore project file only records
-                esm.skipRecord();
-            }
-            else {
-                std::stringstream error;
-                error << "Unknown record: " << n.toString();
-                throw std::runtime_error(error.str());
-            }
-        } else {
-            RecordId id = it->second->load(esm);
-            if (id.mIsDeleted)
-            {
-                it->second->eraseStatic(id.mId);
-                continue;
-            }
-
-            if (n.intval==ESM::REC_DIAL) {
-                dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
-            } else {
-                dialogue = nullptr;
-            }
-        }
+        loadRecord(esm, dialogue);
         listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
     }
+    /*
+        End of tes3mp change (minor)
+    */
 }
 
 void ESMStore::setUp(bool validateRecords)
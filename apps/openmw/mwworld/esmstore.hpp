@@ -85,6 +85,20 @@ namespace MWWorld
 
         mutable std::map<std::string, std::weak_ptr<MWMechanics::SpellList> > mSpellListCache;
 
+        /*
+            Start of tes3mp addition
+
+            Parse the records of content files on worker threads
+        */
+        std::size_t mLoadingThreads;
+
+        void loadRecord(ESM::ESMReader &esm, ESM::Dialogue *&dialogue);
+
+        void loadDecoded(ESM::ESMReader &esm, Loading::Listener* listener);
+        /*
+            End of tes3mp addition
+        */
+
         /// Validate entries in store after setup
         void validate();
 
@@ -122,6 +136,15 @@ namespace MWWorld
 
         ESMStore()
           : mDynamicCount(0)
+          /*
+              Start of tes3mp addition
+
+              Parse the records of content files on worker threads
+          */
+          , mLoadingThreads(0)
+          /*
+              End of tes3mp addition
+          */
         {
             mStores[ESM::REC_ACTI] = &mActivators;
             mStores[ESM::REC_ALCH] = &mPotions;
@@ -185,6 +208,19 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /*
+            Start of tes3mp addition
+
+            Parse the records of content files on worker threads
+        */
+        /// Number of threads load() parses records on, in addition to the calling thread, which
+        /// still adds them to the stores in the order they come in. 0 loads each record on the
+        /// calling thread in turn.
+        void setLoadingThreads(std::size_t threads) { mLoadingThreads = threads; }
+        /*
+            End of tes3mp addition
+        */
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
@@ -0,0 +1,138 @@
+#ifndef GAME_MWWORLD_REFNUMINDEX_H
+#define GAME_MWWORLD_REFNUMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace MWWorld
+{
+    /// \brief Index of a cell's references by the refNum index and mpNum pairs that multiplayer identifies them by
+    ///
+    /// Rebuilding the index means hashing every reference in the cell, so references added since the last
+    /// rebuild are kept in a short list that is searched linearly instead. This also covers the numbers of
+    /// a reference changing right after it's been placed, which is when multiplayer assigns them. Numbers
+    /// changing on older references are only noticed when they no longer match, so such references can't
+    /// be found by their new numbers until the index is rebuilt.
+    ///
+    /// RefNum indexes are only unique within a content file, so several references can share a key. Rather
+    /// than pick one of them, a search reports that it's ambiguous and leaves the caller to pick one in its
+    /// own order.
+    ///
+    /// \note Numbers provides static getRefNum(const Ref&) and getMpNum(const Ref&) functions.
+    template <class Ref, class Numbers>
+    class RefNumIndex
+    {
+        public:
+
+            enum SearchResult
+            {
+                Search_NotFound,
+                Search_Found,
+                Search_Ambiguous
+            };
+
+            static const std::size_t sMaxAddedRefs = 64;
+
+            RefNumIndex() : mUpToDate(false) {}
+
+            bool isUpToDate() const
+            {
+                return mUpToDate;
+            }
+
+            /// Require a rebuild before the next search, e.g. after references have left the cell.
+            void invalidate()
+            {
+                mUpToDate = false;
+            }
+
+            void rebuild(const std::vector<Ref*>& refs)
+            {
+                mEntries.clear();
+                mEntries.reserve(refs.size());
+                mAddedRefs.clear();
+
+                for (Ref* ref : refs)
+                {
+                    auto result = mEntries.emplace(makeKey(Numbers::getRefNum(*ref), Numbers::getMpNum(*ref)), Entry {ref, false});
+
+                    if (!result.second)
+                        result.first->second.mIsShared = true;
+                }
+
+                mUpToDate = true;
+            }
+
+            /// Track a reference added to the cell since the last rebuild.
+            void add(Ref* ref)
+            {
+                if (!mUpToDate)
+                    return;
+
+                if (mAddedRefs.size() >= sMaxAddedRefs)
+                {
+                    mUpToDate = false;
+                    return;
+                }
+
+                mAddedRefs.push_back(ref);
+            }
+
+            /// \param found Set to the only reference with these numbers if Search_Found is returned.
+            /// \note The index must be up to date.
+            SearchResult search(unsigned int refNum, unsigned int mpNum, Ref*& found) const
+            {
+                found = nullptr;
+
+                auto entry = mEntries.find(makeKey(refNum, mpNum));
+
+                if (entry != mEntries.end())
+                {
+                    if (entry->second.mIsShared)
+                        return Search_Ambiguous;
+
+                    if (matches(*entry->second.mRef, refNum, mpNum))
+                        found = entry->second.mRef;
+                }
+
+                for (Ref* ref : mAddedRefs)
+                {
+                    if (ref == found || !matches(*ref, refNum, mpNum))
+                        continue;
+
+                    if (found != nullptr)
+                        return Search_Ambiguous;
+
+                    found = ref;
+                }
+
+                return found != nullptr ? Search_Found : Search_NotFound;
+            }
+
+        private:
+
+            struct Entry
+            {
+                Ref* mRef;
+                bool mIsShared;
+            };
+
+            static std::uint64_t makeKey(unsigned int refNum, unsigned int mpNum)
+            {
+                return (static_cast<std::uint64_t>(refNum) << 32) | mpNum;
+            }
+
+            static bool matches(const Ref& ref, unsigned int refNum, unsigned int mpNum)
+            {
+                return Numbers::getRefNum(ref) == refNum && Numbers::getMpNum(ref) == mpNum;
+            }
+
+            std::unordered_map<std::uint64_t, Entry> mEntries;
+            std::vector<Ref*> mAddedRefs;
+            bool mUpToDate;
+    };
+}
+
+#endif
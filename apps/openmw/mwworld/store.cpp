@@ -184,6 +184,45 @@ namespace MWWorld
 
         return RecordId(record.mId, isDeleted);
     }
+    /*
+        Start of tes3mp addition
+
+        Allow records of content files to be parsed on other threads
+    */
+    template<typename T>
+    class Store<T>::Decoded : public StoreBase::DecodedRecord
+    {
+        Store<T> &mStore;
+        T mRecord;
+        bool mIsDeleted;
+
+    public:
+        Decoded(Store<T> &store, ESM::ESMReader &esm)
+            : mStore(store), mIsDeleted(false)
+        {
+            mRecord.load(esm, mIsDeleted);
+            Misc::StringUtils::lowerCaseInPlace(mRecord.mId);
+        }
+
+        RecordId insert() override
+        {
+            const std::string id = mRecord.mId;
+
+            std::pair<typename Static::iterator, bool> inserted = mStore.mStatic.insert_or_assign(id, std::move(mRecord));
+            if (inserted.second)
+                mStore.mShared.push_back(&inserted.first->second);
+
+            return RecordId(id, mIsDeleted);
+        }
+    };
+    template<typename T>
+    std::unique_ptr<StoreBase::DecodedRecord> Store<T>::decode(ESM::ESMReader &esm)
+    {
+        return std::make_unique<Decoded>(*this, esm);
+    }
+    /*
+        End of tes3mp addition
+    */
     template<typename T>
     void Store<T>::setUp()
     {
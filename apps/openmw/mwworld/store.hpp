@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include "recordcmp.hpp"
 
@@ -48,6 +49,30 @@ namespace MWWorld
 
         virtual RecordId read (ESM::ESMReader& reader, bool overrideOnly = false) { return RecordId(); }
         ///< Read into dynamic storage
+
+        /*
+            Start of tes3mp addition
+
+            Allow records of content files to be parsed on other threads and added to the
+            store later on the main thread, in the order they came in
+        */
+        /// A record that has been parsed, but is not in its store yet.
+        class DecodedRecord
+        {
+        public:
+            virtual ~DecodedRecord() {}
+
+            virtual RecordId insert() = 0;
+            ///< Add the record to the store that decoded it, like load() would have.
+        };
+
+        virtual std::unique_ptr<DecodedRecord> decode(ESM::ESMReader &esm) { return nullptr; }
+        ///< Parse a record like load(), without changing the store. Can be called for different
+        /// readers on several threads at once. Returns nullptr for stores that need to be loaded
+        /// in order.
+        /*
+            End of tes3mp addition
+        */
     };
 
     template <class T>
@@ -156,6 +181,16 @@ namespace MWWorld
 
         friend class ESMStore;
 
+        /*
+            Start of tes3mp addition
+
+            Allow records of content files to be parsed on other threads
+        */
+        class Decoded;
+        /*
+            End of tes3mp addition
+        */
+
     public:
         Store();
         Store(const Store<T> &orig);
@@ -198,6 +233,16 @@ namespace MWWorld
         RecordId load(ESM::ESMReader &esm) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+
+        /*
+            Start of tes3mp addition
+
+            Allow records of content files to be parsed on other threads
+        */
+        std::unique_ptr<DecodedRecord> decode(ESM::ESMReader &esm) override;
+        /*
+            End of tes3mp addition
+        */
     };
 
     template <>
@@ -98,6 +98,16 @@
 #include "contentloader.hpp"
 #include "esmloader.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include the cache of references read from content files
+*/
+#include "cellrefcache.hpp"
+/*
+    End of tes3mp addition
+*/
+
 #ifdef USE_OPENXR
 #include "../mwvr/vranimation.hpp"
 #include "../mwvr/vrenvironment.hpp"
@@ -178,7 +188,15 @@ namespace MWWorld
         const std::string& startCell, const std::string& startupScript,
         const std::string& resourcePath, const std::string& userDataPath)
     : mResourceSystem(resourceSystem), mLocalScripts (mStore),
-      mCells (mStore, mEsm), mSky (true),
+      /*
+          Start of tes3mp change (minor)
+
+          Don't give cells the readers, because they read their references through the CellRefCache
+      */
+      mCells (mStore), mSky (true),
+      /*
+          End of tes3mp change (minor)
+      */
       mGodMode(false), mScriptsEnabled(true), mDiscardMovements(true), mContentFiles (contentFiles),
       mUserDataPath(userDataPath), mShouldUpdateNavigator(false),
       mActivationDistanceOverride (activationDistanceOverride),
@@ -190,6 +208,16 @@ namespace MWWorld
         Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         listener->loadingOn();
 
+        /*
+            Start of tes3mp addition
+
+            Parse the records of content files on worker threads
+        */
+        mStore.setLoadingThreads(static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("content loading threads", "General"))));
+        /*
+            End of tes3mp addition
+        */
+
         GameContentLoader gameContentLoader(*listener);
         EsmLoader esmLoader(mStore, mEsm, encoder, *listener);
 
@@ -203,6 +231,17 @@ namespace MWWorld
 
         listener->loadingOff();
 
+        /*
+            Start of tes3mp addition
+
+            Create the cache of references read from the content files that were just loaded
+        */
+        mCellRefCache.reset(new CellRefCache(encoder,
+            static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("reference cache size", "Cells"))) * 1024 * 1024));
+        /*
+            End of tes3mp addition
+        */
+
         // insert records that may not be present in all versions of MW
         if (mEsm[0].getFormat() == 0)
             ensureNeededRecords();
@@ -223,6 +262,15 @@ namespace MWWorld
             navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
             navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
             navigatorSettings->mSwimHeightScale = mSwimHeightScale;
+            /*
+                Start of tes3mp addition
+
+                Keep the tiles built in earlier sessions with the rest of the user's data
+            */
+            navigatorSettings->mNavMeshDiskCachePath = mUserDataPath + "/navmesh";
+            /*
+                End of tes3mp addition
+            */
             DetourNavigator::RecastGlobalAllocator::init();
             mNavigator.reset(new DetourNavigator::NavigatorImpl(*navigatorSettings));
         }
@@ -643,6 +691,19 @@ namespace MWWorld
         return mStore;
     }
 
+    /*
+        Start of tes3mp addition
+
+        Make it possible to get the references of cells without reading them from the content files again
+    */
+    CellRefCache& World::getCellRefCache()
+    {
+        return *mCellRefCache;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     /*
         Start of tes3mp addition
 
@@ -1459,6 +1520,17 @@ namespace MWWorld
             MWBase::Environment::get().getWindowManager()->updateConsoleObjectPtr(ptr, newPtr);
             MWBase::Environment::get().getScriptManager()->getGlobalScripts().updatePtrs(ptr, newPtr);
         }
+
+        /*
+            Start of tes3mp addition
+
+            Keep the spatial index of actors up to date
+        */
+        MWBase::Environment::get().getMechanicsManager()->updatePosition(newPtr);
+        /*
+            End of tes3mp addition
+        */
+
         if (haveToMove && newPtr.getRefData().getBaseNode())
         {
             mWorldScene->updateObjectPosition(newPtr, vec, movePhysics);
@@ -4665,6 +4737,16 @@ namespace MWWorld
     {
         mNavigator->reportStats(frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
+
+        /*
+            Start of tes3mp addition
+
+            Report how often references are found in the cache instead of being read again
+        */
+        mCellRefCache->reportStats(frameNumber, stats);
+        /*
+            End of tes3mp addition
+        */
     }
 
     void World::updateSkyDate()
@@ -72,6 +72,7 @@ namespace MWWorld
     class WeatherManager;
     class Player;
     class ProjectileManager;
+    class CellRefCache;
 
     /// \brief The game world and its visual representation
 
@@ -87,6 +88,17 @@ namespace MWWorld
 
             Cells mCells;
 
+            /*
+                Start of tes3mp addition
+
+                Keep the references read from content files for CellStore and the object paging and
+                groundcover chunk builders
+            */
+            std::unique_ptr<CellRefCache> mCellRefCache;
+            /*
+                End of tes3mp addition
+            */
+
             std::string mCurrentWorldSpace;
 
             std::unique_ptr<MWWorld::Player> mPlayer;
@@ -266,6 +278,16 @@ namespace MWWorld
 
             std::vector<ESM::ESMReader>& getEsmReader() override;
 
+            /*
+                Start of tes3mp addition
+
+                Make it possible to get the references of cells without reading them from the content files again
+            */
+            CellRefCache& getCellRefCache() override;
+            /*
+                End of tes3mp addition
+            */
+
             LocalScripts& getLocalScripts() override;
 
             bool hasCellChanged() const override;
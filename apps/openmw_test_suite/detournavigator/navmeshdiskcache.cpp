@@ -0,0 +1,161 @@
+#include "operators.hpp"
+
+#include <components/detournavigator/navmeshdiskcache.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <LinearMath/btTransform.h>
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDiskCacheTest : Test
+    {
+        const osg::Vec3f mAgentHalfExtents {1, 2, 3};
+        const TilePosition mTilePosition {0, 0};
+        const std::size_t mGeneration = 0;
+        const std::size_t mRevision = 0;
+        const std::vector<int> mIndices {{0, 1, 2}};
+        const std::vector<float> mVertices {{0, 0, 0, 1, 0, 0, 1, 1, 0}};
+        const std::vector<AreaType> mAreaTypes {1, AreaType_ground};
+        const std::vector<RecastMesh::Water> mWater {};
+        const RecastMesh mRecastMesh {mGeneration, mRevision, mIndices, mVertices, mAreaTypes, mWater};
+        const std::vector<OffMeshConnection> mOffMeshConnections {};
+        std::vector<unsigned char> mData {1, 2, 3, 4, 5, 6, 7, 8};
+        const boost::filesystem::path mPath = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-navmeshdiskcache-%%%%-%%%%-%%%%");
+        const std::size_t mMaxSize = 1024 * 1024;
+        Settings mSettings;
+
+        DetourNavigatorNavMeshDiskCacheTest()
+        {
+            mSettings.mCellHeight = 0.2f;
+            mSettings.mCellSize = 0.2f;
+            mSettings.mTileSize = 64;
+        }
+
+        ~DetourNavigatorNavMeshDiskCacheTest()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(mPath, ec);
+        }
+
+        NavMeshDataRef getData()
+        {
+            return NavMeshDataRef {mData.data(), static_cast<int>(mData.size())};
+        }
+
+        bool isEqualToData(const NavMeshData& value) const
+        {
+            return value.mValue != nullptr && value.mSize == static_cast<int>(mData.size())
+                && std::memcmp(value.mValue.get(), mData.data(), mData.size()) == 0;
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_for_empty_cache_should_return_empty_value)
+    {
+        NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+
+        EXPECT_EQ(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections).mValue, nullptr);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_after_put_should_return_equal_value)
+    {
+        NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+
+        cache.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, getData());
+        cache.wait();
+
+        EXPECT_TRUE(isEqualToData(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections)));
+
+        const auto stats = cache.getStats();
+        EXPECT_EQ(stats.mTiles, 1u);
+        EXPECT_EQ(stats.mHitCount, 1u);
+        EXPECT_EQ(stats.mGetCount, 1u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_from_new_cache_for_same_path_should_return_equal_value)
+    {
+        {
+            NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+            cache.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, getData());
+        }
+
+        NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+
+        EXPECT_TRUE(isEqualToData(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections)));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_for_different_key_should_return_empty_value)
+    {
+        NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+
+        cache.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, getData());
+        cache.wait();
+
+        const std::vector<float> vertices {{0, 0, 0, 1, 0, 0, 1, 2, 0}};
+        const RecastMesh recastMesh(mGeneration, mRevision, mIndices, vertices, mAreaTypes, mWater);
+        const std::vector<OffMeshConnection> offMeshConnections {{osg::Vec3f(0, 0, 0), osg::Vec3f(1, 1, 1), AreaType_door}};
+
+        EXPECT_EQ(cache.get(mAgentHalfExtents, mTilePosition, recastMesh, mOffMeshConnections).mValue, nullptr);
+        EXPECT_EQ(cache.get(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections).mValue, nullptr);
+        EXPECT_EQ(cache.get(osg::Vec3f(1, 2, 4), mTilePosition, mRecastMesh, mOffMeshConnections).mValue, nullptr);
+        EXPECT_EQ(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, offMeshConnections).mValue, nullptr);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_for_different_settings_should_return_empty_value)
+    {
+        {
+            NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+            cache.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, getData());
+        }
+
+        mSettings.mTileSize = 128;
+        NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+
+        EXPECT_EQ(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections).mValue, nullptr);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, put_over_max_size_should_remove_least_recently_used_tiles)
+    {
+        std::size_t tileSize = 0;
+        {
+            NavMeshDiskCache cache(mPath.string(), mMaxSize, mSettings);
+            cache.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, getData());
+            cache.wait();
+            tileSize = cache.getStats().mSize;
+        }
+
+        NavMeshDiskCache cache(mPath.string(), tileSize * 2, mSettings);
+
+        cache.put(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections, getData());
+        cache.wait();
+        EXPECT_TRUE(isEqualToData(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections)));
+        cache.put(mAgentHalfExtents, TilePosition(0, 2), mRecastMesh, mOffMeshConnections, getData());
+        cache.wait();
+
+        EXPECT_EQ(cache.getStats().mTiles, 2u);
+        EXPECT_TRUE(isEqualToData(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections)));
+        EXPECT_EQ(cache.get(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections).mValue, nullptr);
+        EXPECT_TRUE(isEqualToData(cache.get(mAgentHalfExtents, TilePosition(0, 2), mRecastMesh, mOffMeshConnections)));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, put_bigger_than_max_size_should_not_write_tile)
+    {
+        NavMeshDiskCache cache(mPath.string(), mData.size(), mSettings);
+
+        cache.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, getData());
+        cache.wait();
+
+        EXPECT_EQ(cache.getStats().mTiles, 0u);
+        EXPECT_EQ(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections).mValue, nullptr);
+    }
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <components/esm/cellref.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/loadcell.hpp>
+
+#include "apps/openmw/mwworld/cellrefcache.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using MWWorld::CellRefCache;
+
+    constexpr int sCellCount = 3;
+    constexpr int sRefCount = 50;
+    constexpr int sDeletedRef = 7;
+
+    struct CellRefCacheTest : ::testing::Test
+    {
+        const std::string mPath = std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".esp";
+        std::vector<ESM::Cell> mCells;
+
+        CellRefCacheTest()
+        {
+            {
+                boost::filesystem::ofstream stream(mPath, std::ios::binary | std::ios::trunc);
+                ESM::ESMWriter writer;
+                writer.setFormat(0);
+                writer.save(stream);
+
+                for (int x = 0; x < sCellCount; ++x)
+                {
+                    ESM::Cell cell;
+                    cell.blank();
+                    cell.mData.mFlags = 0;
+                    cell.mData.mX = x;
+                    cell.mData.mY = 0;
+
+                    writer.startRecord(ESM::REC_CELL);
+                    cell.save(writer);
+
+                    for (int i = 0; i < sRefCount; ++i)
+                    {
+                        ESM::CellRef ref;
+                        ref.blank();
+                        ref.mRefNum.mIndex = x * sRefCount + i;
+                        ref.mRefID = "Misc_Com_Bottle_0" + std::to_string(i % 10);
+                        ref.mPos.pos[0] = static_cast<float>(i);
+                        ref.save(writer, false, false, i == sDeletedRef);
+                    }
+
+                    writer.endRecord(ESM::REC_CELL);
+                }
+
+                writer.close();
+            }
+
+            ESM::ESMReader reader;
+            reader.setIndex(0);
+            reader.open(mPath);
+
+            while (reader.hasMoreRecs())
+            {
+                reader.getRecName();
+                reader.getRecHeader();
+
+                ESM::Cell cell;
+                bool deleted = false;
+                cell.load(reader, deleted, true);
+                mCells.push_back(cell);
+            }
+        }
+
+        ~CellRefCacheTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+
+        void expectRefs(const CellRefCache::Refs& refs, int x)
+        {
+            EXPECT_TRUE(refs.mError.empty());
+            ASSERT_EQ(refs.mRefs.size(), static_cast<std::size_t>(sRefCount));
+
+            for (int i = 0; i < sRefCount; ++i)
+            {
+                const auto& [ref, deleted] = refs.mRefs[i];
+                EXPECT_EQ(ref.mRefNum.mIndex & 0xffffff, static_cast<unsigned int>(x * sRefCount + i));
+                EXPECT_EQ(ref.mRefID, "misc_com_bottle_0" + std::to_string(i % 10));
+                if (!deleted)
+                    EXPECT_EQ(ref.mPos.pos[0], static_cast<float>(i));
+                EXPECT_EQ(deleted, i == sDeletedRef);
+            }
+        }
+    };
+
+    TEST_F(CellRefCacheTest, should_read_every_reference_of_a_context)
+    {
+        ASSERT_EQ(mCells.size(), static_cast<std::size_t>(sCellCount));
+
+        CellRefCache cache(nullptr, 1 << 20);
+
+        for (int x = 0; x < sCellCount; ++x)
+            expectRefs(*cache.getRefs(mCells[x], 0), x);
+
+        const CellRefCache::Stats stats = cache.getStats();
+        EXPECT_EQ(stats.mContexts, static_cast<std::size_t>(sCellCount));
+        EXPECT_EQ(stats.mHitCount, 0u);
+        EXPECT_EQ(stats.mGetCount, static_cast<std::size_t>(sCellCount));
+    }
+
+    TEST_F(CellRefCacheTest, should_share_references_read_once)
+    {
+        CellRefCache cache(nullptr, 1 << 20);
+
+        const auto refs = cache.getRefs(mCells[1], 0);
+        EXPECT_EQ(cache.getRefs(mCells[1], 0), refs);
+
+        const CellRefCache::Stats stats = cache.getStats();
+        EXPECT_EQ(stats.mHitCount, 1u);
+        EXPECT_EQ(stats.mGetCount, 2u);
+    }
+
+    TEST_F(CellRefCacheTest, should_read_each_context_once_from_several_threads)
+    {
+        CellRefCache cache(nullptr, 1 << 20);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&] {
+                for (int x = 0; x < sCellCount; ++x)
+                    cache.getRefs(mCells[x], 0);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        const CellRefCache::Stats stats = cache.getStats();
+        EXPECT_EQ(stats.mContexts, static_cast<std::size_t>(sCellCount));
+        EXPECT_EQ(stats.mGetCount - stats.mHitCount, static_cast<std::size_t>(sCellCount));
+    }
+
+    TEST_F(CellRefCacheTest, should_drop_the_least_recently_used_references_past_the_size_limit)
+    {
+        CellRefCache unbounded(nullptr, 1 << 20);
+        unbounded.getRefs(mCells[0], 0);
+        const std::size_t contextSize = unbounded.getStats().mSize;
+
+        CellRefCache cache(nullptr, contextSize * 2);
+        const auto first = cache.getRefs(mCells[0], 0);
+        cache.getRefs(mCells[1], 0);
+        cache.getRefs(mCells[0], 0);
+        cache.getRefs(mCells[2], 0);
+
+        EXPECT_EQ(cache.getStats().mContexts, 2u);
+        EXPECT_LE(cache.getStats().mSize, contextSize * 2);
+        EXPECT_EQ(cache.getRefs(mCells[0], 0), first);
+
+        // References that were dropped are still there for whoever is using them
+        expectRefs(*first, 0);
+    }
+
+    TEST_F(CellRefCacheTest, should_read_without_caching_when_the_size_is_0)
+    {
+        CellRefCache cache(nullptr, 0);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&] {
+                for (int x = 0; x < sCellCount; ++x)
+                    expectRefs(*cache.getRefs(mCells[x], 0), x);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        EXPECT_NE(cache.getRefs(mCells[0], 0), cache.getRefs(mCells[0], 0));
+        EXPECT_EQ(cache.getStats().mContexts, 0u);
+        EXPECT_EQ(cache.getStats().mSize, 0u);
+    }
+}
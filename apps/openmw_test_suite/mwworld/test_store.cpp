@@ -318,3 +318,97 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that parsing records on worker threads gives the same records in the same order as loading them in turn.
+TEST_F(StoreTest, loading_threads_test)
+{
+    // Enough records for several batches of worker threads
+    const int count = 10000;
+
+    ESM::ESMWriter writer;
+    std::stringstream stream;
+    writer.setFormat(0);
+    writer.save(stream);
+
+    const auto save = [&] (const auto& record, bool deleted)
+    {
+        writer.startRecord(record.sRecordId);
+        record.save(writer, deleted);
+        writer.endRecord(record.sRecordId);
+    };
+
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    ESM::DialInfo info;
+    info.blank();
+
+    for (int i = 0; i < count; ++i)
+    {
+        apparatus.mId = "Apparatus" + std::to_string(i);
+        apparatus.mModel = "model" + std::to_string(i);
+        save(apparatus, false);
+
+        // Dialogue is loaded on the main thread in between parsed records
+        if (i % 100 == 0)
+        {
+            dialogue.mId = "dialogue" + std::to_string(i);
+            save(dialogue, false);
+            info.mId = "info" + std::to_string(i);
+            save(info, false);
+        }
+
+        // Later records of the same file override and delete earlier ones
+        if (i % 3 == 0)
+        {
+            apparatus.mId = "apparatus" + std::to_string(i / 3);
+            apparatus.mModel = "changed" + std::to_string(i);
+            save(apparatus, false);
+        }
+
+        if (i % 7 == 0)
+        {
+            apparatus.mId = "apparatus" + std::to_string(i / 2);
+            save(apparatus, true);
+        }
+    }
+
+    const std::string data = stream.str();
+
+    const auto load = [&] (MWWorld::ESMStore& store)
+    {
+        ESM::ESMReader reader;
+        std::vector<ESM::ESMReader> readerList;
+        readerList.push_back(reader);
+        reader.setGlobalReaderList(&readerList);
+        reader.open(Files::IStreamPtr(new std::stringstream(data)), "filename");
+        store.load(reader, &dummyListener);
+        store.setUp();
+    };
+
+    load(mEsmStore);
+
+    MWWorld::ESMStore threadedStore;
+    threadedStore.setLoadingThreads(3);
+    load(threadedStore);
+
+    const MWWorld::Store<ESM::Apparatus>& expected = mEsmStore.get<ESM::Apparatus>();
+    const MWWorld::Store<ESM::Apparatus>& actual = threadedStore.get<ESM::Apparatus>();
+
+    ASSERT_EQ(actual.getSize(), expected.getSize());
+    ASSERT_LT(expected.getSize(), static_cast<size_t>(count));
+
+    for (auto expectedIt = expected.begin(), actualIt = actual.begin(); expectedIt != expected.end(); ++expectedIt, ++actualIt)
+    {
+        EXPECT_EQ(actualIt->mId, expectedIt->mId);
+        EXPECT_EQ(actualIt->mModel, expectedIt->mModel);
+    }
+
+    const MWWorld::Store<ESM::Dialogue>& actualDialogues = threadedStore.get<ESM::Dialogue>();
+
+    ASSERT_EQ(actualDialogues.getSize(), mEsmStore.get<ESM::Dialogue>().getSize());
+
+    for (const ESM::Dialogue& actualDialogue : actualDialogues)
+        EXPECT_EQ(actualDialogue.mInfo.size(), 1u);
+}
@@ -0,0 +1,191 @@
+#include <components/openmw-mp/ChecksumCache.hpp>
+#include <components/openmw-mp/Utils.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using mwmp::ChecksumCache;
+
+    std::string makeData(std::size_t size, uint32_t seed)
+    {
+        std::string data(size, '\0');
+
+        for (std::size_t i = 0; i < size; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            data[i] = static_cast<char>(seed >> 24);
+        }
+
+        return data;
+    }
+
+    uint32_t boostChecksum(const std::string &data)
+    {
+        boost::crc_32_type crc32;
+        crc32.process_bytes(data.data(), data.size());
+        return crc32.checksum();
+    }
+
+    struct ChecksumCacheTest : Test
+    {
+        const std::string directory = std::string(UnitTest::GetInstance()->current_test_info()->name()) + "_files";
+
+        ChecksumCacheTest()
+        {
+            boost::filesystem::remove_all(directory);
+            boost::filesystem::create_directories(directory);
+        }
+
+        ~ChecksumCacheTest()
+        {
+            boost::filesystem::remove_all(directory);
+        }
+
+        std::string writeFile(const std::string &name, const std::string &data)
+        {
+            const std::string path = directory + "/" + name;
+            boost::filesystem::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(data.data(), data.size());
+            return path;
+        }
+
+        // Make a file look like it was last changed a while ago, as data files usually were
+        std::time_t age(const std::string &path)
+        {
+            const std::time_t modificationTime = std::time(nullptr) - 60;
+            boost::filesystem::last_write_time(path, modificationTime);
+            return modificationTime;
+        }
+    };
+
+    TEST(Crc32Test, should_match_the_standard_check_value)
+    {
+        EXPECT_EQ(Utils::crc32("123456789", 9), 0xCBF43926u);
+        EXPECT_EQ(Utils::crc32("", 0), 0u);
+    }
+
+    TEST(Crc32Test, should_match_boost_for_every_length_and_alignment)
+    {
+        const std::string data = makeData(300, 7);
+
+        for (std::size_t offset = 0; offset < 8; offset++)
+        {
+            for (std::size_t size = 0; size + offset <= data.size(); size += 13)
+                EXPECT_EQ(Utils::crc32(data.data() + offset, size), boostChecksum(data.substr(offset, size)));
+        }
+    }
+
+    TEST(Crc32Test, should_continue_from_a_previous_part)
+    {
+        const std::string data = makeData(1000, 11);
+        const uint32_t first = Utils::crc32(data.data(), 333);
+
+        EXPECT_EQ(Utils::crc32(data.data() + 333, data.size() - 333, first), boostChecksum(data));
+    }
+
+    TEST_F(ChecksumCacheTest, file_checksum_should_match_boost)
+    {
+        const std::string data = makeData(200000, 3);
+
+        EXPECT_EQ(Utils::crc32Checksum(writeFile("data.esp", data)), boostChecksum(data));
+        EXPECT_EQ(Utils::crc32Checksum(writeFile("empty.esp", "")), 0u);
+        EXPECT_EQ(Utils::crc32Checksum(directory + "/missing.esp"), 0u);
+    }
+
+    TEST_F(ChecksumCacheTest, should_compute_every_file_in_a_batch)
+    {
+        std::vector<std::string> files;
+        std::vector<uint32_t> expected;
+
+        for (uint32_t i = 0; i < 9; i++)
+        {
+            const std::string data = makeData(10000 + i * 4097, i);
+            files.push_back(writeFile("plugin" + std::to_string(i) + ".esp", data));
+            age(files.back());
+            expected.push_back(boostChecksum(data));
+        }
+
+        files.push_back(directory + "/missing.esp");
+        expected.push_back(0);
+
+        ChecksumCache cache;
+
+        EXPECT_EQ(cache.getChecksums(files), expected);
+        EXPECT_EQ(cache.getSize(), 9u);
+    }
+
+    TEST_F(ChecksumCacheTest, should_reuse_checksums_until_the_file_changes)
+    {
+        const std::string path = writeFile("data.esm", makeData(5000, 1));
+        const uint32_t checksum = boostChecksum(makeData(5000, 1));
+        const std::time_t modificationTime = age(path);
+
+        ChecksumCache cache;
+        EXPECT_EQ(cache.getChecksum(path), checksum);
+
+        // A cached checksum is used as long as the size and modification time match
+        writeFile("data.esm", makeData(5000, 2));
+        boost::filesystem::last_write_time(path, modificationTime);
+        EXPECT_EQ(cache.getChecksum(path), checksum);
+
+        boost::filesystem::last_write_time(path, modificationTime + 10);
+        EXPECT_EQ(cache.getChecksum(path), boostChecksum(makeData(5000, 2)));
+    }
+
+    TEST_F(ChecksumCacheTest, should_not_keep_checksums_of_files_just_modified)
+    {
+        const std::string path = writeFile("data.esm", makeData(5000, 1));
+
+        ChecksumCache cache;
+        EXPECT_EQ(cache.getChecksum(path), boostChecksum(makeData(5000, 1)));
+        EXPECT_EQ(cache.getSize(), 0u);
+
+        // Changed again within the same second, which the modification time can't tell
+        const std::time_t modificationTime = boost::filesystem::last_write_time(path);
+        writeFile("data.esm", makeData(5000, 2));
+        boost::filesystem::last_write_time(path, modificationTime);
+        EXPECT_EQ(cache.getChecksum(path), boostChecksum(makeData(5000, 2)));
+    }
+
+    TEST_F(ChecksumCacheTest, should_load_saved_checksums)
+    {
+        const std::string path = writeFile("data file.esm", makeData(5000, 1));
+        const std::string cachePath = directory + "/cache/checksums.txt";
+        const std::time_t modificationTime = age(path);
+
+        ChecksumCache cache;
+        EXPECT_FALSE(cache.load(cachePath));
+        const uint32_t checksum = cache.getChecksum(path);
+        EXPECT_TRUE(cache.save());
+
+        // Swap the contents without the size or modification time changing, which only a checksum
+        // loaded from the cache would miss
+        writeFile("data file.esm", makeData(5000, 2));
+        boost::filesystem::last_write_time(path, modificationTime);
+
+        ChecksumCache loadedCache;
+        EXPECT_TRUE(loadedCache.load(cachePath));
+        EXPECT_EQ(loadedCache.getSize(), 1u);
+        EXPECT_EQ(loadedCache.getChecksum(path), checksum);
+    }
+
+    TEST_F(ChecksumCacheTest, should_ignore_a_cache_file_in_another_format)
+    {
+        const std::string cachePath = writeFile("checksums.txt", "something else\n1234 10 10 data.esm\n");
+
+        ChecksumCache cache;
+        EXPECT_FALSE(cache.load(cachePath));
+        EXPECT_EQ(cache.getSize(), 0u);
+    }
+}
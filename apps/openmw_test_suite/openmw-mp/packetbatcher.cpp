@@ -0,0 +1,235 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Packets/PacketBatcher.hpp>
+#include <components/openmw-mp/Packets/StringTables.hpp>
+
+#include <gtest/gtest.h>
+
+#include <RakPeer.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using mwmp::PacketBatcher;
+    using mwmp::StringTables;
+
+    typedef std::vector<std::pair<const unsigned char *, unsigned int>> Messages;
+
+    void addMessage(RakNet::BitStream &batch, const std::string &message)
+    {
+        StringTables::writeVarint(&batch, static_cast<uint32_t>(message.size()));
+        batch.Write(message.data(), static_cast<unsigned int>(message.size()));
+    }
+
+    std::string getMessage(const Messages &messages, std::size_t index)
+    {
+        return std::string(reinterpret_cast<const char *>(messages[index].first), messages[index].second);
+    }
+
+    // Keeps what the batcher hands to RakNet instead of sending it
+    struct RecordingPeer : RakNet::RakPeer
+    {
+        struct Sent
+        {
+            std::string data;
+            PacketPriority priority;
+            PacketReliability reliability;
+            char orderChannel;
+            uint64_t guid;
+            bool broadcast;
+        };
+
+        std::vector<Sent> sent;
+
+        uint32_t Send(const char *data, const int length, PacketPriority priority, PacketReliability reliability,
+                      char orderingChannel, const RakNet::AddressOrGUID systemIdentifier, bool broadcast,
+                      uint32_t = 0) override
+        {
+            sent.push_back({std::string(data, length), priority, reliability, orderingChannel,
+                systemIdentifier.rakNetGuid.g, broadcast});
+            return static_cast<uint32_t>(sent.size());
+        }
+
+        uint32_t Send(const RakNet::BitStream *bitStream, PacketPriority priority, PacketReliability reliability,
+                      char orderingChannel, const RakNet::AddressOrGUID systemIdentifier, bool broadcast,
+                      uint32_t forceReceiptNumber = 0) override
+        {
+            return Send(reinterpret_cast<const char *>(bitStream->GetData()),
+                static_cast<int>(bitStream->GetNumberOfBytesUsed()), priority, reliability, orderingChannel,
+                systemIdentifier, broadcast, forceReceiptNumber);
+        }
+    };
+
+    struct PacketBatcherSendTest : Test
+    {
+        const RakNet::RakNetGUID player = RakNet::RakNetGUID(1);
+        const char channel = 2;
+
+        RecordingPeer peer;
+        PacketBatcher batcher;
+
+        PacketBatcherSendTest() : batcher(&peer)
+        {
+
+        }
+
+        void send(const std::string &message, PacketPriority priority = HIGH_PRIORITY,
+                  PacketReliability reliability = RELIABLE_ORDERED, bool broadcast = false)
+        {
+            RakNet::BitStream stream;
+            stream.Write(message.data(), static_cast<unsigned int>(message.size()));
+            batcher.send(&stream, priority, reliability, channel, player, broadcast);
+        }
+
+        std::vector<std::string> getSentMessages(std::size_t index)
+        {
+            const std::string &data = peer.sent.at(index).data;
+            Messages messages;
+
+            if (!PacketBatcher::unpack(reinterpret_cast<const unsigned char *>(data.data()),
+                    static_cast<unsigned int>(data.size()), messages))
+                return {data};
+
+            std::vector<std::string> result;
+
+            for (std::size_t i = 0; i < messages.size(); ++i)
+                result.push_back(getMessage(messages, i));
+
+            return result;
+        }
+    };
+
+    TEST(PacketBatcherTest, should_unpack_every_message_in_order)
+    {
+        const std::string longMessage(300, 'x');
+
+        RakNet::BitStream batch;
+        batch.Write(static_cast<RakNet::MessageID>(ID_PACKET_BATCH));
+        addMessage(batch, "first");
+        addMessage(batch, longMessage);
+        addMessage(batch, "last");
+
+        Messages messages;
+        ASSERT_TRUE(PacketBatcher::unpack(batch.GetData(), batch.GetNumberOfBytesUsed(), messages));
+        ASSERT_EQ(messages.size(), 3u);
+        EXPECT_EQ(getMessage(messages, 0), "first");
+        EXPECT_EQ(getMessage(messages, 1), longMessage);
+        EXPECT_EQ(getMessage(messages, 2), "last");
+    }
+
+    TEST(PacketBatcherTest, should_reject_a_message_running_past_the_end)
+    {
+        RakNet::BitStream batch;
+        batch.Write(static_cast<RakNet::MessageID>(ID_PACKET_BATCH));
+        addMessage(batch, "first");
+        StringTables::writeVarint(&batch, 10);
+        batch.Write("short", 5);
+
+        Messages messages;
+        EXPECT_FALSE(PacketBatcher::unpack(batch.GetData(), batch.GetNumberOfBytesUsed(), messages));
+        EXPECT_TRUE(messages.empty());
+    }
+
+    TEST(PacketBatcherTest, should_reject_empty_batches_and_other_messages)
+    {
+        RakNet::BitStream batch;
+        batch.Write(static_cast<RakNet::MessageID>(ID_PACKET_BATCH));
+
+        Messages messages;
+        EXPECT_FALSE(PacketBatcher::unpack(batch.GetData(), batch.GetNumberOfBytesUsed(), messages));
+
+        RakNet::BitStream chatMessage;
+        chatMessage.Write(static_cast<RakNet::MessageID>(ID_CHAT_MESSAGE));
+        addMessage(chatMessage, "hello");
+
+        EXPECT_FALSE(PacketBatcher::unpack(chatMessage.GetData(), chatMessage.GetNumberOfBytesUsed(), messages));
+    }
+
+    TEST_F(PacketBatcherSendTest, should_hold_messages_until_flushed)
+    {
+        send("first");
+        send("second");
+        EXPECT_TRUE(peer.sent.empty());
+
+        batcher.flush();
+        ASSERT_EQ(peer.sent.size(), 1u);
+        EXPECT_EQ(getSentMessages(0), std::vector<std::string>({"first", "second"}));
+        EXPECT_EQ(peer.sent[0].reliability, RELIABLE_ORDERED);
+        EXPECT_EQ(peer.sent[0].orderChannel, channel);
+        EXPECT_EQ(peer.sent[0].guid, player.g);
+    }
+
+    TEST_F(PacketBatcherSendTest, should_send_batch_before_broadcast_on_same_channel)
+    {
+        send("batched");
+        send("broadcast", HIGH_PRIORITY, RELIABLE_ORDERED, true);
+
+        ASSERT_EQ(peer.sent.size(), 2u);
+        EXPECT_EQ(peer.sent[0].data, "batched");
+        EXPECT_FALSE(peer.sent[0].broadcast);
+        EXPECT_EQ(peer.sent[1].data, "broadcast");
+        EXPECT_TRUE(peer.sent[1].broadcast);
+
+        batcher.flush();
+        EXPECT_EQ(peer.sent.size(), 2u);
+    }
+
+    TEST_F(PacketBatcherSendTest, should_send_batch_before_message_that_cannot_be_batched)
+    {
+        send("batched");
+        send("sequenced", HIGH_PRIORITY, RELIABLE_SEQUENCED);
+
+        ASSERT_EQ(peer.sent.size(), 2u);
+        EXPECT_EQ(peer.sent[0].data, "batched");
+        EXPECT_EQ(peer.sent[1].data, "sequenced");
+        EXPECT_EQ(peer.sent[1].reliability, RELIABLE_SEQUENCED);
+    }
+
+    TEST_F(PacketBatcherSendTest, should_send_immediate_priority_right_away_after_batch)
+    {
+        send("batched");
+        send("immediate", IMMEDIATE_PRIORITY);
+
+        ASSERT_EQ(peer.sent.size(), 2u);
+        EXPECT_EQ(peer.sent[0].data, "batched");
+        EXPECT_EQ(peer.sent[1].data, "immediate");
+        EXPECT_EQ(peer.sent[1].priority, IMMEDIATE_PRIORITY);
+    }
+
+    TEST_F(PacketBatcherSendTest, should_start_new_batch_when_priority_changes)
+    {
+        send("high");
+        send("medium", MEDIUM_PRIORITY);
+
+        ASSERT_EQ(peer.sent.size(), 1u);
+        EXPECT_EQ(peer.sent[0].data, "high");
+        EXPECT_EQ(peer.sent[0].priority, HIGH_PRIORITY);
+
+        batcher.flush();
+        ASSERT_EQ(peer.sent.size(), 2u);
+        EXPECT_EQ(peer.sent[1].data, "medium");
+        EXPECT_EQ(peer.sent[1].priority, MEDIUM_PRIORITY);
+    }
+
+    TEST_F(PacketBatcherSendTest, should_split_batches_at_max_batch_size)
+    {
+        const std::string first(500, 'a');
+        const std::string second(500, 'b');
+        const std::string third(500, 'c');
+
+        send(first);
+        send(second);
+        EXPECT_TRUE(peer.sent.empty());
+
+        send(third);
+        ASSERT_EQ(peer.sent.size(), 1u);
+        EXPECT_LE(peer.sent[0].data.size(), static_cast<std::size_t>(PacketBatcher::maxBatchSize));
+        EXPECT_EQ(getSentMessages(0), std::vector<std::string>({first, second}));
+
+        batcher.flush();
+        ASSERT_EQ(peer.sent.size(), 2u);
+        EXPECT_EQ(peer.sent[1].data, third);
+    }
+}
@@ -0,0 +1,172 @@
+#include <components/openmw-mp/SnapshotBuffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using mwmp::SnapshotBuffer;
+
+    struct RecordedPacket
+    {
+        uint32_t sentAt; // Milliseconds on the sender's clock
+        uint32_t receivedAt; // Milliseconds on the receiver's clock
+    };
+
+    // Positions sent by a player running at a frame rate that dips now and then, as they arrived
+    // over a connection with up to 45 ms of jitter; some of them overtook each other on the way
+    const std::vector<RecordedPacket> recordedTrace {
+        {52326, 52335}, {52343, 52384}, {52358, 52362}, {52374, 52380}, {52390, 52427},
+        {52405, 52437}, {52421, 52423}, {52436, 52463}, {52453, 52457}, {52469, 52474},
+        {52485, 52512}, {52500, 52536}, {52515, 52529}, {52548, 52588}, {52564, 52567},
+        {52580, 52617}, {52597, 52600}, {52613, 52615}, {52629, 52637}, {52645, 52671},
+        {52661, 52715}, {52676, 52712}, {52692, 52727}, {52725, 52736}, {52740, 52777},
+        {52756, 52796}, {52772, 52795}, {52787, 52822}, {52820, 52824}, {52836, 52839},
+        {52852, 52865}, {52869, 52912}, {52885, 52912}, {52901, 52930}, {52917, 52946},
+        {52933, 52952}, {52949, 52960}, {52982, 52997}, {52997, 53033}, {53013, 53046}
+    };
+
+    const float runSpeed = 300.f;
+    const double frameTime = 1.0 / 60;
+    // The receiver's clock has nothing to do with the sender's
+    const double receiverEpoch = 3600.0;
+
+    ESM::Position makePosition(float x)
+    {
+        ESM::Position position {};
+        position.pos[0] = x;
+        return position;
+    }
+
+    float getRunPosition(uint32_t sentAt)
+    {
+        return runSpeed * (sentAt - recordedTrace.front().sentAt) / 1000.f;
+    }
+
+    struct MwmpSnapshotBufferTest : Test
+    {
+        SnapshotBuffer mBuffer;
+
+        float sample(double time)
+        {
+            ESM::Position position = makePosition(-1.f);
+            EXPECT_TRUE(mBuffer.sample(time, position));
+            return position.pos[0];
+        }
+    };
+
+    TEST_F(MwmpSnapshotBufferTest, sample_should_fail_without_snapshots)
+    {
+        ESM::Position position = makePosition(42.f);
+        EXPECT_FALSE(mBuffer.sample(receiverEpoch, position));
+        EXPECT_EQ(position.pos[0], 42.f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, recorded_trace_should_play_back_smoothly_and_stop_where_it_ends)
+    {
+        std::vector<RecordedPacket> arrivals = recordedTrace;
+        std::stable_sort(arrivals.begin(), arrivals.end(),
+            [] (const RecordedPacket &a, const RecordedPacket &b) { return a.receivedAt < b.receivedAt; });
+
+        std::size_t nextArrival = 0;
+        uint32_t newestSentAt = 0;
+        double time = receiverEpoch + arrivals.front().receivedAt / 1000.0;
+        const double endTime = receiverEpoch + arrivals.back().receivedAt / 1000.0 + 0.5;
+        float shownX = 0.f;
+
+        for (; time < endTime; time += frameTime)
+        {
+            for (; nextArrival < arrivals.size() && receiverEpoch + arrivals[nextArrival].receivedAt / 1000.0 <= time;
+                 ++nextArrival)
+            {
+                const RecordedPacket &packet = arrivals[nextArrival];
+                mBuffer.add(makePosition(getRunPosition(packet.sentAt)), packet.sentAt,
+                    receiverEpoch + packet.receivedAt / 1000.0);
+                newestSentAt = std::max(newestSentAt, packet.sentAt);
+            }
+
+            const float x = sample(time);
+
+            // The player never turned back until they stopped, and each frame only moves them about
+            // as far as they ran in it, give or take the playout delay adapting and the clocks being
+            // lined up again
+            if (nextArrival < arrivals.size())
+                EXPECT_GE(x, shownX);
+            EXPECT_LE(std::abs(x - shownX), runSpeed * frameTime * 2);
+            EXPECT_LE(x, getRunPosition(newestSentAt) + runSpeed * SnapshotBuffer::maxExtrapolation + 0.01f);
+
+            EXPECT_GE(mBuffer.getPlayoutDelay(), SnapshotBuffer::minPlayoutDelay);
+            EXPECT_LE(mBuffer.getPlayoutDelay(), SnapshotBuffer::maxPlayoutDelay);
+
+            shownX = x;
+        }
+
+        EXPECT_EQ(nextArrival, arrivals.size());
+        // Once the extrapolation runs out, the player is shown where they were last seen
+        EXPECT_NEAR(shownX, getRunPosition(recordedTrace.back().sentAt), 0.01f);
+        EXPECT_EQ(sample(time + 1), shownX);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, add_should_drop_snapshot_older_than_newest)
+    {
+        mBuffer.add(makePosition(0.f), 1000, receiverEpoch);
+        mBuffer.add(makePosition(10.f), 1100, receiverEpoch + 0.1);
+        mBuffer.add(makePosition(20.f), 1200, receiverEpoch + 0.2);
+        mBuffer.add(makePosition(300.f), 1150, receiverEpoch + 0.21);
+
+        const double halfway = receiverEpoch + 0.15 + mBuffer.getPlayoutDelay();
+        EXPECT_NEAR(sample(halfway), 15.f, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, add_should_replace_snapshots_with_correction_of_same_timestamp)
+    {
+        mBuffer.add(makePosition(0.f), 1000, receiverEpoch);
+        mBuffer.add(makePosition(10.f), 1100, receiverEpoch + 0.1);
+        mBuffer.add(makePosition(150.f), 1100, receiverEpoch + 0.12);
+
+        EXPECT_EQ(sample(receiverEpoch + 0.12), 150.f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, add_should_replace_snapshots_with_teleport)
+    {
+        mBuffer.add(makePosition(0.f), 1000, receiverEpoch);
+        mBuffer.add(makePosition(5.f), 1016, receiverEpoch + 0.016);
+        mBuffer.add(makePosition(10000.f), 1032, receiverEpoch + 0.032);
+
+        EXPECT_EQ(sample(receiverEpoch + 0.032), 10000.f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, add_should_start_over_with_snapshots_from_another_clock)
+    {
+        mBuffer.add(makePosition(0.f), 4000000, receiverEpoch);
+        mBuffer.add(makePosition(5.f), 4000016, receiverEpoch + 0.016);
+        mBuffer.add(makePosition(8.f), 700, receiverEpoch + 0.05);
+
+        EXPECT_EQ(sample(receiverEpoch + 0.05), 8.f);
+
+        mBuffer.add(makePosition(13.f), 716, receiverEpoch + 0.066);
+        mBuffer.add(makePosition(18.f), 732, receiverEpoch + 0.082);
+
+        EXPECT_GT(sample(receiverEpoch + 0.3), 8.f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, sample_should_interpolate_rotation_along_shortest_arc)
+    {
+        ESM::Position from = makePosition(0.f);
+        from.rot[2] = 3.0f;
+        ESM::Position to = makePosition(0.f);
+        to.rot[2] = -3.0f;
+
+        mBuffer.add(from, 1000, receiverEpoch);
+        mBuffer.add(to, 1100, receiverEpoch + 0.1);
+
+        ESM::Position position;
+        ASSERT_TRUE(mBuffer.sample(receiverEpoch + 0.05 + mBuffer.getPlayoutDelay(), position));
+        EXPECT_GT(std::abs(position.rot[2]), 3.0f);
+    }
+}
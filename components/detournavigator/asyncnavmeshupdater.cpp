@@ -73,6 +73,10 @@ namespace DetourNavigator
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
     {
+        if (settings.mEnableNavMeshDiskCache && !settings.mNavMeshDiskCachePath.empty())
+            mNavMeshDiskCache = std::make_unique<NavMeshDiskCache>(settings.mNavMeshDiskCachePath,
+                settings.mMaxNavMeshDiskCacheSize, settings);
+
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
             mThreads.emplace_back([&] { process(); });
     }
@@ -235,6 +239,9 @@ namespace DetourNavigator
         stats.setAttribute(frameNumber, "NavMesh UpdateJobs", jobs);
 
         mNavMeshTilesCache.reportStats(frameNumber, stats);
+
+        if (mNavMeshDiskCache)
+            mNavMeshDiskCache->reportStats(frameNumber, stats);
     }
 
     void AsyncNavMeshUpdater::process() noexcept
@@ -282,7 +289,7 @@ namespace DetourNavigator
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
         const auto status = updateNavMesh(job.mAgentHalfExtents, recastMesh.get(), job.mChangedTile, playerTile,
-            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache);
+            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache, mNavMeshDiskCache.get());
 
         if (recastMesh != nullptr)
         {
@@ -0,0 +1,444 @@
+#include "navmeshdiskcache.hpp"
+#include "settings.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <tuple>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    constexpr char sMagic[] = {'O', 'M', 'W', 'N', 'A', 'V', 'T', 'L'};
+    constexpr std::uint32_t sFormatVersion = 1;
+    constexpr std::size_t sMaxPendingWrites = 256;
+    // Anything bigger isn't a tile written by this cache
+    constexpr std::uint64_t sMaxTileSize = 64 * 1024 * 1024;
+    const std::string sExtension = ".navtile";
+    const std::string sTemporaryExtension = ".tmp";
+
+    template <class T>
+    void writeValue(std::vector<char>& out, const T& value)
+    {
+        const char* const data = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), data, data + sizeof(T));
+    }
+
+    template <class T>
+    void writeArray(std::vector<char>& out, const T* values, std::size_t size)
+    {
+        writeValue(out, static_cast<std::uint64_t>(size));
+        const char* const data = reinterpret_cast<const char*>(values);
+        out.insert(out.end(), data, data + size * sizeof(T));
+    }
+
+    void writeVec3f(std::vector<char>& out, const osg::Vec3f& value)
+    {
+        writeValue(out, value.x());
+        writeValue(out, value.y());
+        writeValue(out, value.z());
+    }
+
+    void writeVector3(std::vector<char>& out, const btVector3& value)
+    {
+        writeValue(out, value.x());
+        writeValue(out, value.y());
+        writeValue(out, value.z());
+    }
+
+    // FNV-1a, which unlike std::hash gives the same result in every session
+    std::uint64_t getHash(const char* data, std::size_t size)
+    {
+        std::uint64_t result = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            result ^= static_cast<unsigned char>(data[i]);
+            result *= 1099511628211ull;
+        }
+        return result;
+    }
+
+    std::uint64_t getSettingsHash(const Settings& settings)
+    {
+        std::vector<char> data;
+        writeValue(data, settings.mCellHeight);
+        writeValue(data, settings.mCellSize);
+        writeValue(data, settings.mDetailSampleDist);
+        writeValue(data, settings.mDetailSampleMaxError);
+        writeValue(data, settings.mMaxClimb);
+        writeValue(data, settings.mMaxSimplificationError);
+        writeValue(data, settings.mMaxSlope);
+        writeValue(data, settings.mRecastScaleFactor);
+        writeValue(data, settings.mSwimHeightScale);
+        writeValue(data, settings.mBorderSize);
+        writeValue(data, settings.mMaxEdgeLen);
+        writeValue(data, settings.mMaxPolys);
+        writeValue(data, settings.mMaxVertsPerPoly);
+        writeValue(data, settings.mRegionMergeSize);
+        writeValue(data, settings.mRegionMinSize);
+        writeValue(data, settings.mTileSize);
+        return getHash(data.data(), data.size());
+    }
+
+    std::string getName(const std::vector<char>& key)
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::uint64_t hash = getHash(key.data(), key.size());
+        std::string result(16, '0');
+        for (auto it = result.rbegin(); it != result.rend(); ++it, hash >>= 4)
+            *it = digits[hash & 0xf];
+        return result + sExtension;
+    }
+
+    bool readKey(std::istream& stream, const std::vector<char>& key)
+    {
+        char magic[sizeof(sMagic)];
+        std::uint32_t version = 0;
+        std::uint64_t keySize = 0;
+
+        stream.read(magic, sizeof(magic));
+        stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+        stream.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+
+        if (!stream || std::memcmp(magic, sMagic, sizeof(sMagic)) != 0 || version != sFormatVersion
+                || keySize != key.size())
+            return false;
+
+        std::vector<char> storedKey(key.size());
+        stream.read(storedKey.data(), static_cast<std::streamsize>(storedKey.size()));
+
+        return stream && storedKey == key;
+    }
+}
+
+namespace DetourNavigator
+{
+    NavMeshDiskCache::NavMeshDiskCache(const std::string& path, std::size_t maxSize, const Settings& settings)
+        : mPath(path)
+        , mMaxSize(maxSize)
+        , mSettingsHash(getSettingsHash(settings))
+        , mWriting(false)
+        , mShouldStop(false)
+        , mSize(0)
+        , mHitCount(0)
+        , mGetCount(0)
+    {
+        loadIndex();
+        mThread = std::thread([this] { run(); });
+    }
+
+    NavMeshDiskCache::~NavMeshDiskCache()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasWrite.notify_all();
+        mThread.join();
+    }
+
+    NavMeshData NavMeshDiskCache::get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+    {
+        const std::vector<char> key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        const std::string name = getName(key);
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+
+            ++mGetCount;
+
+            if (mEntries.find(name) == mEntries.end())
+                return NavMeshData();
+        }
+
+        const boost::filesystem::path filePath = boost::filesystem::path(mPath) / name;
+        boost::filesystem::ifstream stream(filePath, std::ios::binary);
+
+        if (!stream || !readKey(stream, key))
+            return NavMeshData();
+
+        std::uint64_t size = 0;
+        stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+        if (!stream || size == 0 || size > sMaxTileSize)
+            return NavMeshData();
+
+        NavMeshData result(static_cast<unsigned char*>(dtAlloc(static_cast<std::size_t>(size), DT_ALLOC_PERM)),
+                           static_cast<int>(size));
+
+        if (!result.mValue)
+            return NavMeshData();
+
+        stream.read(reinterpret_cast<char*>(result.mValue.get()), static_cast<std::streamsize>(size));
+
+        if (!stream)
+            return NavMeshData();
+
+        // Keep the tile from being the first to go in the next session too
+        boost::system::error_code ec;
+        boost::filesystem::last_write_time(filePath, std::time(nullptr), ec);
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        ++mHitCount;
+
+        const auto entry = mEntries.find(name);
+        if (entry != mEntries.end())
+            mUses.splice(mUses.begin(), mUses, entry->second.mUsePosition);
+
+        return result;
+    }
+
+    void NavMeshDiskCache::put(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+        const NavMeshDataRef& value)
+    {
+        if (value.mValue == nullptr || value.mSize <= 0)
+            return;
+
+        const std::vector<char> key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+
+        Write write;
+        write.mName = getName(key);
+        write.mContent.reserve(sizeof(sMagic) + sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t)
+                               + key.size() + static_cast<std::size_t>(value.mSize));
+        write.mContent.insert(write.mContent.end(), std::begin(sMagic), std::end(sMagic));
+        writeValue(write.mContent, sFormatVersion);
+        writeArray(write.mContent, key.data(), key.size());
+        writeArray(write.mContent, value.mValue, static_cast<std::size_t>(value.mSize));
+
+        if (write.mContent.size() > mMaxSize)
+            return;
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+
+            if (mShouldStop || mWrites.size() >= sMaxPendingWrites)
+                return;
+
+            mWrites.push_back(std::move(write));
+        }
+
+        mHasWrite.notify_one();
+    }
+
+    void NavMeshDiskCache::wait()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWritten.wait(lock, [&] { return mWrites.empty() && !mWriting; });
+    }
+
+    NavMeshDiskCache::Stats NavMeshDiskCache::getStats() const
+    {
+        Stats result;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            result.mSize = mSize;
+            result.mTiles = mEntries.size();
+            result.mPendingWrites = mWrites.size();
+            result.mHitCount = mHitCount;
+            result.mGetCount = mGetCount;
+        }
+        return result;
+    }
+
+    void NavMeshDiskCache::reportStats(unsigned int frameNumber, osg::Stats& out) const
+    {
+        const Stats stats = getStats();
+        out.setAttribute(frameNumber, "NavMesh DiskCacheSize", stats.mSize);
+        out.setAttribute(frameNumber, "NavMesh DiskCachedTiles", stats.mTiles);
+        if (stats.mGetCount > 0)
+            out.setAttribute(frameNumber, "NavMesh DiskCacheHitRate", static_cast<double>(stats.mHitCount) / stats.mGetCount * 100.0);
+    }
+
+    void NavMeshDiskCache::loadIndex()
+    {
+        namespace fs = boost::filesystem;
+
+        boost::system::error_code ec;
+        fs::create_directories(mPath, ec);
+
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to create navmesh disk cache directory \"" << mPath << "\": " << ec.message();
+            return;
+        }
+
+        std::vector<std::tuple<std::time_t, std::string, std::size_t>> files;
+
+        for (fs::directory_iterator it(mPath, ec), end; !ec && it != end; it.increment(ec))
+        {
+            const fs::path& path = it->path();
+
+            if (!fs::is_regular_file(path, ec))
+                continue;
+
+            const std::string extension = path.extension().string();
+
+            if (extension == sTemporaryExtension)
+            {
+                // Left by a session that stopped while writing
+                fs::remove(path, ec);
+                continue;
+            }
+
+            if (extension != sExtension)
+                continue;
+
+            const auto size = fs::file_size(path, ec);
+            if (ec)
+                continue;
+
+            files.emplace_back(fs::last_write_time(path, ec), path.filename().string(), static_cast<std::size_t>(size));
+        }
+
+        std::sort(files.begin(), files.end(), [] (const auto& lhs, const auto& rhs) { return lhs > rhs; });
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        for (const auto& [time, name, size] : files)
+        {
+            mUses.push_back(name);
+            mEntries.emplace(name, Entry {size, std::prev(mUses.end())});
+            mSize += size;
+        }
+
+        while (mSize > mMaxSize && !mUses.empty())
+            removeLeastRecentlyUsedUnsafe();
+
+        Log(Debug::Verbose) << "Found " << mEntries.size() << " navmesh tiles (" << mSize << " bytes) in \"" << mPath << "\"";
+    }
+
+    void NavMeshDiskCache::run()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        while (true)
+        {
+            mHasWrite.wait(lock, [&] { return mShouldStop || !mWrites.empty(); });
+
+            // Tiles queued before stopping are still written to not lose them
+            if (mWrites.empty())
+                break;
+
+            const Write next = std::move(mWrites.front());
+            mWrites.pop_front();
+            mWriting = true;
+
+            lock.unlock();
+            write(next);
+            lock.lock();
+
+            mWriting = false;
+            mWritten.notify_all();
+        }
+    }
+
+    void NavMeshDiskCache::write(const Write& write)
+    {
+        namespace fs = boost::filesystem;
+
+        const fs::path path = fs::path(mPath) / write.mName;
+        const fs::path temporaryPath = fs::path(mPath) / (write.mName + sTemporaryExtension);
+
+        // Readers never see a partly written tile because it only gets its name once it's complete
+        {
+            fs::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            stream.write(write.mContent.data(), static_cast<std::streamsize>(write.mContent.size()));
+
+            if (!stream)
+            {
+                Log(Debug::Warning) << "Failed to write navmesh tile to \"" << temporaryPath.string() << "\"";
+                return;
+            }
+        }
+
+        boost::system::error_code ec;
+        fs::rename(temporaryPath, path, ec);
+
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to write navmesh tile to \"" << path.string() << "\": " << ec.message();
+            fs::remove(temporaryPath, ec);
+            return;
+        }
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto entry = mEntries.find(write.mName);
+
+        if (entry != mEntries.end())
+        {
+            mSize -= entry->second.mSize;
+            mUses.erase(entry->second.mUsePosition);
+            mEntries.erase(entry);
+        }
+
+        mUses.push_front(write.mName);
+        mEntries.emplace(write.mName, Entry {write.mContent.size(), mUses.begin()});
+        mSize += write.mContent.size();
+
+        while (mSize > mMaxSize && !mUses.empty())
+            removeLeastRecentlyUsedUnsafe();
+    }
+
+    void NavMeshDiskCache::removeLeastRecentlyUsedUnsafe()
+    {
+        const auto entry = mEntries.find(mUses.back());
+
+        boost::system::error_code ec;
+        boost::filesystem::remove(boost::filesystem::path(mPath) / entry->first, ec);
+
+        mSize -= entry->second.mSize;
+        mEntries.erase(entry);
+        mUses.pop_back();
+    }
+
+    std::vector<char> NavMeshDiskCache::makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const
+    {
+        std::vector<char> result;
+        result.reserve(sizeof(std::uint64_t) * 6 + sizeof(float) * 3 + sizeof(int) * 2
+            + recastMesh.getIndices().size() * sizeof(int)
+            + recastMesh.getVertices().size() * sizeof(float)
+            + recastMesh.getAreaTypes().size() * sizeof(AreaType)
+            + recastMesh.getWater().size() * (sizeof(int) + sizeof(btScalar) * 12)
+            + offMeshConnections.size() * (sizeof(float) * 6 + sizeof(AreaType)));
+
+        writeValue(result, mSettingsHash);
+        writeVec3f(result, agentHalfExtents);
+        writeValue(result, changedTile.x());
+        writeValue(result, changedTile.y());
+        writeArray(result, recastMesh.getIndices().data(), recastMesh.getIndices().size());
+        writeArray(result, recastMesh.getVertices().data(), recastMesh.getVertices().size());
+        writeArray(result, recastMesh.getAreaTypes().data(), recastMesh.getAreaTypes().size());
+
+        writeValue(result, static_cast<std::uint64_t>(recastMesh.getWater().size()));
+        for (const auto& water : recastMesh.getWater())
+        {
+            writeValue(result, water.mCellSize);
+            writeVector3(result, water.mTransform.getOrigin());
+            for (int i = 0; i < 3; ++i)
+                writeVector3(result, water.mTransform.getBasis().getRow(i));
+        }
+
+        writeValue(result, static_cast<std::uint64_t>(offMeshConnections.size()));
+        for (const auto& connection : offMeshConnections)
+        {
+            writeVec3f(result, connection.mStart);
+            writeVec3f(result, connection.mEnd);
+            writeValue(result, connection.mAreaType);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDISKCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDISKCACHE_H
+
+#include "offmeshconnection.hpp"
+#include "navmeshdata.hpp"
+#include "navmeshtilescache.hpp"
+#include "recastmesh.hpp"
+#include "tileposition.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    struct Settings;
+
+    /// \brief Keeps navmesh tiles in files to reuse them in later sessions
+    ///
+    /// A tile is stored under a hash of everything it's built from: the agent, the tile position, the recast mesh,
+    /// the off mesh connections and the navigator settings that change the result. The whole key is written to the
+    /// file too and compared on read, so a hash collision is just a miss.
+    ///
+    /// Tiles are read by the thread asking for them and written by a thread of the cache's own. When the files take
+    /// up more than the size limit, the least recently used ones are removed.
+    class NavMeshDiskCache
+    {
+    public:
+        struct Stats
+        {
+            std::size_t mSize;
+            std::size_t mTiles;
+            std::size_t mPendingWrites;
+            std::size_t mHitCount;
+            std::size_t mGetCount;
+        };
+
+        NavMeshDiskCache(const std::string& path, std::size_t maxSize, const Settings& settings);
+
+        ~NavMeshDiskCache();
+
+        /// Read a tile, returning empty data when there is no file for it.
+        NavMeshData get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections);
+
+        /// Queue a tile to be written. The data is copied.
+        void put(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+            const NavMeshDataRef& value);
+
+        /// Wait until every queued tile is written.
+        void wait();
+
+        Stats getStats() const;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Write
+        {
+            std::string mName;
+            std::vector<char> mContent;
+        };
+
+        struct Entry
+        {
+            std::size_t mSize;
+            std::list<std::string>::iterator mUsePosition;
+        };
+
+        const std::string mPath;
+        const std::size_t mMaxSize;
+        const std::uint64_t mSettingsHash;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasWrite;
+        std::condition_variable mWritten;
+        std::deque<Write> mWrites;
+        bool mWriting;
+        bool mShouldStop;
+        std::map<std::string, Entry> mEntries;
+        // Most recently used first
+        std::list<std::string> mUses;
+        std::size_t mSize;
+        std::size_t mHitCount;
+        std::size_t mGetCount;
+        std::thread mThread;
+
+        void loadIndex();
+
+        void run();
+
+        void write(const Write& write);
+
+        void removeLeastRecentlyUsedUnsafe();
+
+        std::vector<char> makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const;
+    };
+}
+
+#endif
@@ -273,6 +273,23 @@ void ESMReader::skipRecord()
     mCtx.subCached = false;
 }
 
+/*
+    Start of tes3mp addition
+
+    Allow a record to be copied as it is, to be parsed later by a reader of its own
+*/
+void ESMReader::getRecordData(std::vector<char> &data)
+{
+    const size_t begin = data.size();
+    data.resize(begin + mCtx.leftRec);
+    getExact(data.data() + begin, mCtx.leftRec);
+    mCtx.leftRec = 0;
+    mCtx.subCached = false;
+}
+/*
+    End of tes3mp addition
+*/
+
 void ESMReader::getRecHeader(uint32_t &flags)
 {
     // General error checking
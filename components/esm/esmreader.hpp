@@ -223,6 +223,19 @@ public:
   // already been read
   void skipRecord();
 
+  /*
+      Start of tes3mp addition
+
+      Allow a record to be copied as it is, to be parsed later by a reader of its own
+  */
+  // Append the rest of this record to data without parsing it and
+  // move on to the next record. Assumes the name and header have
+  // already been read
+  void getRecordData(std::vector<char> &data);
+  /*
+      End of tes3mp addition
+  */
+
   /* Read record header. This updatesleftFile BEYOND the data that
      follows the header, ie beyond the entire record. You should use
      leftRec to orient yourself inside the record itself.
@@ -259,6 +272,16 @@ public:
   /// Sets font encoder for ESM strings
   void setEncoder(ToUTF8::Utf8Encoder* encoder);
 
+  /*
+      Start of tes3mp addition
+
+      Allow other readers of the same file to convert strings the same way
+  */
+  ToUTF8::Utf8Encoder* getEncoder() const { return mEncoder; }
+  /*
+      End of tes3mp addition
+  */
+
   /// Get record flags of last record
   unsigned int getRecordFlags() { return mRecordFlags; }
 
@@ -7,41 +7,29 @@
 
 namespace Interpreter
 {
-    void Interpreter::execute (Type_Code code)
+    void Interpreter::decodeInstruction (Type_Code code, Program::Instruction& instruction) const
     {
+        // Unknown codes are left without an opcode and only make execute() fail if they're run
+        instruction.mOpcode0 = nullptr;
+        instruction.mOpcode1 = nullptr;
+        instruction.mArg0 = 0;
+        instruction.mCode = code;
+
         unsigned int segSpec = code>>30;
 
         switch (segSpec)
         {
             case 0:
-            {
-                int opcode = code>>24;
-                unsigned int arg0 = code & 0xffffff;
-
-                std::map<int, Opcode1 *>::iterator iter = mSegment0.find (opcode);
-
-                if (iter==mSegment0.end())
-                    abortUnknownCode (0, opcode);
-
-                iter->second->execute (mRuntime, arg0);
 
+                instruction.mOpcode1 = mSegment0.get (code>>24);
+                instruction.mArg0 = code & 0xffffff;
                 return;
-            }
 
             case 2:
-            {
-                int opcode = (code>>20) & 0x3ff;
-                unsigned int arg0 = code & 0xfffff;
-
-                std::map<int, Opcode1 *>::iterator iter = mSegment2.find (opcode);
-
-                if (iter==mSegment2.end())
-                    abortUnknownCode (2, opcode);
-
-                iter->second->execute (mRuntime, arg0);
 
+                instruction.mOpcode1 = mSegment2.get ((code>>20) & 0x3ff);
+                instruction.mArg0 = code & 0xfffff;
                 return;
-            }
         }
 
         segSpec = code>>26;
@@ -49,36 +37,37 @@ namespace Interpreter
         switch (segSpec)
         {
             case 0x30:
-            {
-                int opcode = (code>>8) & 0x3ffff;
-                unsigned int arg0 = code & 0xff;
-
-                std::map<int, Opcode1 *>::iterator iter = mSegment3.find (opcode);
-
-                if (iter==mSegment3.end())
-                    abortUnknownCode (3, opcode);
-
-                iter->second->execute (mRuntime, arg0);
 
+                instruction.mOpcode1 = mSegment3.get ((code>>8) & 0x3ffff);
+                instruction.mArg0 = code & 0xff;
                 return;
-            }
 
             case 0x32:
-            {
-                int opcode = code & 0x3ffffff;
-
-                std::map<int, Opcode0 *>::iterator iter = mSegment5.find (opcode);
-
-                if (iter==mSegment5.end())
-                    abortUnknownCode (5, opcode);
-
-                iter->second->execute (mRuntime);
 
+                instruction.mOpcode0 = mSegment5.get (code & 0x3ffffff);
                 return;
-            }
         }
+    }
 
-        abortUnknownSegment (code);
+    void Interpreter::execute (Type_Code code)
+    {
+        Program::Instruction instruction;
+        decodeInstruction (code, instruction);
+
+        if (instruction.mOpcode1)
+            instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+        else if (instruction.mOpcode0)
+            instruction.mOpcode0->execute (mRuntime);
+        else if (code>>30==0)
+            abortUnknownCode (0, code>>24);
+        else if (code>>30==2)
+            abortUnknownCode (2, (code>>20) & 0x3ff);
+        else if (code>>26==0x30)
+            abortUnknownCode (3, (code>>8) & 0x3ffff);
+        else if (code>>26==0x32)
+            abortUnknownCode (5, code & 0x3ffffff);
+        else
+            abortUnknownSegment (code);
     }
 
     void Interpreter::abortUnknownCode (int segment, int opcode)
@@ -123,47 +112,52 @@ namespace Interpreter
     Interpreter::Interpreter() : mRunning (false)
     {}
 
-    Interpreter::~Interpreter()
-    {
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment0.begin());
-            iter!=mSegment0.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment2.begin());
-            iter!=mSegment2.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment3.begin());
-            iter!=mSegment3.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode0 *>::iterator iter (mSegment5.begin());
-            iter!=mSegment5.end(); ++iter)
-            delete iter->second;
-    }
+    Interpreter::~Interpreter() = default;
 
     void Interpreter::installSegment0 (int code, Opcode1 *opcode)
     {
-        assert(mSegment0.find(code) == mSegment0.end());
-        mSegment0.insert (std::make_pair (code, opcode));
+        const bool installed = mSegment0.install (code, opcode);
+        assert(installed);
+        (void) installed;
     }
 
     void Interpreter::installSegment2 (int code, Opcode1 *opcode)
     {
-        assert(mSegment2.find(code) == mSegment2.end());
-        mSegment2.insert (std::make_pair (code, opcode));
+        const bool installed = mSegment2.install (code, opcode);
+        assert(installed);
+        (void) installed;
     }
 
     void Interpreter::installSegment3 (int code, Opcode1 *opcode)
     {
-        assert(mSegment3.find(code) == mSegment3.end());
-        mSegment3.insert (std::make_pair (code, opcode));
+        const bool installed = mSegment3.install (code, opcode);
+        assert(installed);
+        (void) installed;
     }
 
     void Interpreter::installSegment5 (int code, Opcode0 *opcode)
     {
-        assert(mSegment5.find(code) == mSegment5.end());
-        mSegment5.insert (std::make_pair (code, opcode));
+        const bool installed = mSegment5.install (code, opcode);
+        assert(installed);
+        (void) installed;
+    }
+
+    Program Interpreter::decode (const Type_Code *code, int codeSize) const
+    {
+        assert (codeSize>=4);
+
+        Program program;
+        program.mCode = code;
+        program.mCodeSize = codeSize;
+
+        const int opcodes = static_cast<int> (code[0]);
+
+        program.mInstructions.resize (opcodes);
+
+        for (int i = 0; i<opcodes; ++i)
+            decodeInstruction (code[4+i], program.mInstructions[i]);
+
+        return program;
     }
 
     void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
@@ -195,4 +189,38 @@ namespace Interpreter
 
         end();
     }
+
+    void Interpreter::run (const Program& program, Context& context)
+    {
+        assert (!program.empty());
+
+        begin();
+
+        try
+        {
+            mRuntime.configure (program.mCode, program.mCodeSize, context);
+
+            const int opcodes = static_cast<int> (program.mInstructions.size());
+
+            while (mRuntime.getPC()>=0 && mRuntime.getPC()<opcodes)
+            {
+                const Program::Instruction& instruction = program.mInstructions[mRuntime.getPC()];
+                mRuntime.setPC (mRuntime.getPC()+1);
+
+                if (instruction.mOpcode1)
+                    instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+                else if (instruction.mOpcode0)
+                    instruction.mOpcode0->execute (mRuntime);
+                else
+                    execute (instruction.mCode);
+            }
+        }
+        catch (...)
+        {
+            end();
+            throw;
+        }
+
+        end();
+    }
 }
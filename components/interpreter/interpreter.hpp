@@ -1,8 +1,9 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
+#include <memory>
 #include <stack>
+#include <vector>
 
 #include "runtime.hpp"
 #include "types.hpp"
@@ -12,20 +13,91 @@ namespace Interpreter
     class Opcode0;
     class Opcode1;
 
+    /// Opcodes of one segment, stored by code so finding one is just indexing.
+    ///
+    /// Built-in opcodes have low codes and extensions get codes from \a extensionBase, so each range
+    /// is stored in an array of its own.
+    template <class T, unsigned int extensionBase>
+    class OpcodeTable
+    {
+            std::vector<std::unique_ptr<T>> mBuiltIn;
+            std::vector<std::unique_ptr<T>> mExtensions;
+
+            std::unique_ptr<T>& getSlot (unsigned int code)
+            {
+                std::vector<std::unique_ptr<T>>& opcodes = code<extensionBase ? mBuiltIn : mExtensions;
+                const unsigned int index = code<extensionBase ? code : code - extensionBase;
+
+                if (index>=opcodes.size())
+                    opcodes.resize (index+1);
+
+                return opcodes[index];
+            }
+
+        public:
+
+            T *get (unsigned int code) const
+            {
+                const std::vector<std::unique_ptr<T>>& opcodes = code<extensionBase ? mBuiltIn : mExtensions;
+                const unsigned int index = code<extensionBase ? code : code - extensionBase;
+
+                return index<opcodes.size() ? opcodes[index].get() : nullptr;
+            }
+
+            bool install (unsigned int code, T *opcode)
+            {
+                std::unique_ptr<T> owned (opcode);
+                std::unique_ptr<T>& slot = getSlot (code);
+
+                if (slot!=nullptr)
+                    return false;
+
+                slot = std::move (owned);
+                return true;
+            }
+    };
+
+    /// Code of a script with the opcode of each instruction already looked up, to run it without
+    /// decoding it again each time.
+    class Program
+    {
+            friend class Interpreter;
+
+            struct Instruction
+            {
+                Opcode0 *mOpcode0;
+                Opcode1 *mOpcode1;
+                unsigned int mArg0;
+                Type_Code mCode;
+            };
+
+            const Type_Code *mCode;
+            int mCodeSize;
+            std::vector<Instruction> mInstructions;
+
+        public:
+
+            Program() : mCode (nullptr), mCodeSize (0) {}
+
+            bool empty() const { return mCode==nullptr; }
+    };
+
     class Interpreter
     {
             std::stack<Runtime> mCallstack;
             bool mRunning;
             Runtime mRuntime;
-            std::map<int, Opcode1 *> mSegment0;
-            std::map<int, Opcode1 *> mSegment2;
-            std::map<int, Opcode1 *> mSegment3;
-            std::map<int, Opcode0 *> mSegment5;
+            OpcodeTable<Opcode1, 32> mSegment0;
+            OpcodeTable<Opcode1, 512> mSegment2;
+            OpcodeTable<Opcode1, 131072> mSegment3;
+            OpcodeTable<Opcode0, 33554432> mSegment5;
 
             // not implemented
             Interpreter (const Interpreter&);
             Interpreter& operator= (const Interpreter&);
 
+            void decodeInstruction (Type_Code code, Program::Instruction& instruction) const;
+
             void execute (Type_Code code);
 
             void abortUnknownCode (int segment, int opcode);
@@ -54,7 +126,13 @@ namespace Interpreter
             void installSegment5 (int code, Opcode0 *opcode);
             ///< ownership of \a opcode is transferred to *this.
 
+            Program decode (const Type_Code *code, int codeSize) const;
+            ///< Look up the opcodes of \a code, which must exist at least as long as the returned
+            /// program. Opcodes installed later are not seen by the program.
+
             void run (const Type_Code *code, int codeSize, Context& context);
+
+            void run (const Program& program, Context& context);
     };
 }
 
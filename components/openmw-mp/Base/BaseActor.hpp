@@ -25,6 +25,7 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        uint32_t positionTimestamp = 0; // When the position was taken, in milliseconds on its sender's clock
 
         ESM::Cell cell;
 
@@ -65,7 +66,7 @@ namespace mwmp
     {
     public:
 
-        BaseActorList()
+        BaseActorList() : batchedActorCount(0), sentBatch(nullptr)
         {
 
         }
@@ -100,6 +101,50 @@ namespace mwmp
         unsigned char action; // 0 - Clear and set in entirety, 1 - Add item, 2 - Remove item, 3 - Request items
 
         bool isValid;
+
+        /**
+         * Copy an actor into the pool shared by every batch and add its index to a batch.
+         *
+         * Pooled actors are only ever assigned over, so once a list has batched as many actors as
+         * it usually does, their strings and vectors already have the capacity to take new ones.
+         */
+        void addToBatch(std::vector<unsigned int> &batch, const BaseActor &actor)
+        {
+            if (batchedActorCount < batchedActors.size())
+                batchedActors[batchedActorCount] = actor;
+            else
+                batchedActors.push_back(actor);
+
+            batch.push_back(batchedActorCount++);
+        }
+
+        // Let the pool be reused, which leaves the indexes in every batch invalid
+        void clearBatches()
+        {
+            batchedActorCount = 0;
+            sentBatch = nullptr;
+        }
+
+        // Send the actors of a batch in place of baseActors, until it's set back to nullptr
+        void setSentBatch(const std::vector<unsigned int> *batch)
+        {
+            sentBatch = batch;
+        }
+
+        unsigned int getSentActorCount() const
+        {
+            return (unsigned int)(sentBatch != nullptr ? sentBatch->size() : baseActors.size());
+        }
+
+        BaseActor &getSentActor(unsigned int i)
+        {
+            return sentBatch != nullptr ? batchedActors[(*sentBatch)[i]] : baseActors[i];
+        }
+
+    private:
+        std::vector<BaseActor> batchedActors;
+        unsigned int batchedActorCount;
+        const std::vector<unsigned int> *sentBatch;
     };
 }
 
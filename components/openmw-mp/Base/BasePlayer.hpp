@@ -139,6 +139,16 @@ namespace mwmp
         SELECTED_SPELL
     };
 
+    // The keyframe that compact position deltas are encoded against, with coordinates
+    // quantized to 1/8 of a unit
+    struct PositionBaseline
+    {
+        bool isValid = false;
+        uint8_t keyframeId = 0;
+        unsigned int age = 0;
+        int32_t position[3] = {0, 0, 0};
+    };
+
     class BasePlayer
     {
     public:
@@ -238,8 +248,10 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        uint32_t positionTimestamp = 0; // When the position was taken, in milliseconds on its sender's clock
         ESM::Position previousCellPosition;
         ESM::Position momentum;
+        PositionBaseline positionBaseline;
         ESM::Cell cell;
         ESM::NPC npc;
         ESM::NpcStats npcStats;
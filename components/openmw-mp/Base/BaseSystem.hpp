@@ -11,6 +11,13 @@ namespace mwmp
     {
     public:
 
+        // Optional protocol features a client can handle, sent along with its handshake
+        enum CAPABILITY
+        {
+            COMPACT_POSITION = 1 << 0,
+            STRING_TABLE = 1 << 1
+        };
+
         BaseSystem(RakNet::RakNetGUID guid) : guid(guid)
         {
 
@@ -24,6 +31,7 @@ namespace mwmp
         RakNet::RakNetGUID guid;
         std::string playerName;
         std::string serverPassword;
+        uint32_t capabilities = 0;
 
     };
 }
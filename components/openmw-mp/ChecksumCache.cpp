@@ -0,0 +1,205 @@
+#include "ChecksumCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include "Utils.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    const char *const fileHeader = "tes3mp-checksums 1";
+}
+
+ChecksumCache::ChecksumCache() : isChanged(false)
+{
+
+}
+
+bool ChecksumCache::load(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    this->path = path;
+    entries.clear();
+    isChanged = false;
+
+    std::ifstream stream(path);
+    std::string line;
+
+    if (!stream || !std::getline(stream, line) || line != fileHeader)
+        return false;
+
+    // Each line holds the checksum, size and modification time, followed by the path of the file
+    while (std::getline(stream, line))
+    {
+        std::istringstream lineStream(line);
+        Entry entry;
+        std::string file;
+
+        lineStream >> std::hex >> entry.checksum >> std::dec >> entry.size >> entry.modificationTime;
+
+        if (!lineStream || lineStream.get() != ' ' || !std::getline(lineStream, file) || file.empty())
+            continue;
+
+        entries[file] = entry;
+    }
+
+    return true;
+}
+
+bool ChecksumCache::save()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (path.empty() || !isChanged)
+        return true;
+
+    boost::system::error_code error;
+    const boost::filesystem::path directory = boost::filesystem::path(path).parent_path();
+
+    if (!directory.empty())
+        boost::filesystem::create_directories(directory, error);
+
+    std::ofstream stream(path, std::ios::trunc);
+
+    if (!stream)
+        return false;
+
+    stream << fileHeader << '\n';
+
+    for (const auto &entry : entries)
+    {
+        stream << std::hex << entry.second.checksum << std::dec << ' ' << entry.second.size << ' ' <<
+            entry.second.modificationTime << ' ' << entry.first << '\n';
+    }
+
+    if (!stream.flush())
+        return false;
+
+    isChanged = false;
+    return true;
+}
+
+uint32_t ChecksumCache::getChecksum(const std::string &file)
+{
+    return getChecksums({file}).front();
+}
+
+std::vector<uint32_t> ChecksumCache::getChecksums(const std::vector<std::string> &files)
+{
+    std::vector<uint32_t> checksums(files.size(), 0);
+    std::vector<Entry> fileInfos(files.size());
+    std::vector<std::size_t> missing;
+
+    // Modification times only have a resolution of a second, so a file changed within the second
+    // it's read in could change again without its time doing so. Checksums of such files are only
+    // used for this call and computed again the next time
+    const int64_t readTime = static_cast<int64_t>(std::time(nullptr));
+
+    for (std::size_t i = 0; i < files.size(); i++)
+    {
+        // Files that can't be read keep a checksum of 0, like an empty file
+        if (!getFileInfo(files[i], fileInfos[i]))
+            continue;
+
+        if (!findChecksum(files[i], fileInfos[i], checksums[i]))
+            missing.push_back(i);
+    }
+
+    if (missing.empty())
+        return checksums;
+
+    // Reading is mostly bound by the disk, so a few threads are enough to keep it busy
+    const std::size_t threadCount = std::min<std::size_t>(missing.size(),
+        std::max(1u, std::min(4u, std::thread::hardware_concurrency())));
+    std::atomic<std::size_t> nextMissing(0);
+
+    auto computeMissing = [&]() {
+        for (std::size_t next = nextMissing++; next < missing.size(); next = nextMissing++)
+        {
+            const std::size_t i = missing[next];
+            checksums[i] = Utils::crc32Checksum(files[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < threadCount; i++)
+        threads.emplace_back(computeMissing);
+
+    computeMissing();
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (std::size_t i : missing)
+    {
+        if (fileInfos[i].modificationTime >= readTime - 1)
+            continue;
+
+        Entry entry = fileInfos[i];
+        entry.checksum = checksums[i];
+        addChecksum(files[i], entry);
+    }
+
+    return checksums;
+}
+
+std::size_t ChecksumCache::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void ChecksumCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    isChanged = isChanged || !entries.empty();
+    entries.clear();
+}
+
+bool ChecksumCache::getFileInfo(const std::string &file, Entry &entry)
+{
+    boost::system::error_code error;
+
+    entry.size = boost::filesystem::file_size(file, error);
+
+    if (error)
+        return false;
+
+    entry.modificationTime = static_cast<int64_t>(boost::filesystem::last_write_time(file, error));
+    entry.checksum = 0;
+
+    return !error;
+}
+
+bool ChecksumCache::findChecksum(const std::string &file, const Entry &fileInfo, uint32_t &checksum) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entries.find(file);
+
+    if (it == entries.end() || it->second.size != fileInfo.size ||
+        it->second.modificationTime != fileInfo.modificationTime)
+        return false;
+
+    checksum = it->second.checksum;
+    return true;
+}
+
+void ChecksumCache::addChecksum(const std::string &file, const Entry &entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    entries[file] = entry;
+    isChanged = true;
+}
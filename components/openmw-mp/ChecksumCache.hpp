@@ -0,0 +1,58 @@
+#ifndef OPENMW_CHECKSUMCACHE_HPP
+#define OPENMW_CHECKSUMCACHE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mwmp
+{
+    /**
+     * Remembers the CRC-32 checksums of data files by path, along with their size and modification
+     * time, so a file only has to be read again once it has changed. Files modified within a second
+     * of being read are never remembered, since they could still change without their time doing so.
+     *
+     * The checksums can be saved to a file and loaded back in by the next run.
+     */
+    class ChecksumCache
+    {
+    public:
+        ChecksumCache();
+
+        // Load the checksums saved to a file, replacing any already known, and save to the same file
+        // from then on. A missing or unreadable file leaves the cache empty
+        bool load(const std::string &path);
+        // Save the checksums to the file they were loaded from, if any have changed since
+        bool save();
+
+        uint32_t getChecksum(const std::string &file);
+        // Get the checksums of several files, computing the ones that aren't known yet in parallel
+        std::vector<uint32_t> getChecksums(const std::vector<std::string> &files);
+
+        std::size_t getSize() const;
+        void clear();
+
+    private:
+        struct Entry
+        {
+            uintmax_t size;
+            int64_t modificationTime;
+            uint32_t checksum;
+        };
+
+        // Get the size and modification time of a file, returning false if it can't be read
+        static bool getFileInfo(const std::string &file, Entry &entry);
+        bool findChecksum(const std::string &file, const Entry &fileInfo, uint32_t &checksum) const;
+        void addChecksum(const std::string &file, const Entry &entry);
+
+        std::string path;
+        std::unordered_map<std::string, Entry> entries;
+        bool isChanged;
+
+        mutable std::mutex mutex;
+    };
+}
+
+#endif //OPENMW_CHECKSUMCACHE_HPP
@@ -58,10 +58,5 @@ void mwmp::ActorPacketController::SetStream(RakNet::BitStream *inStream, RakNet:
 
 bool mwmp::ActorPacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets.find((unsigned char)id) != packets.end();
 }
@@ -81,10 +81,5 @@ void mwmp::ObjectPacketController::SetStream(RakNet::BitStream *inStream, RakNet
 
 bool mwmp::ObjectPacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets.find((unsigned char)id) != packets.end();
 }
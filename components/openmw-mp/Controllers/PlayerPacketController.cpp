@@ -31,6 +31,7 @@
 #include "../Packets/Player/PacketPlayerMiscellaneous.hpp"
 #include "../Packets/Player/PacketPlayerMomentum.hpp"
 #include "../Packets/Player/PacketPlayerPosition.hpp"
+#include "../Packets/Player/PacketPlayerPositionCompact.hpp"
 #include "../Packets/Player/PacketPlayerQuickKeys.hpp"
 #include "../Packets/Player/PacketPlayerReputation.hpp"
 #include "../Packets/Player/PacketPlayerRest.hpp"
@@ -88,6 +89,7 @@ mwmp::PlayerPacketController::PlayerPacketController(RakNet::RakPeerInterface *p
     AddPacket<PacketPlayerMiscellaneous>(&packets, peer);
     AddPacket<PacketPlayerMomentum>(&packets, peer);
     AddPacket<PacketPlayerPosition>(&packets, peer);
+    AddPacket<PacketPlayerPositionCompact>(&packets, peer);
     AddPacket<PacketPlayerQuickKeys>(&packets, peer);
     AddPacket<PacketPlayerReputation>(&packets, peer);
     AddPacket<PacketPlayerRest>(&packets, peer);
@@ -114,10 +116,5 @@ void mwmp::PlayerPacketController::SetStream(RakNet::BitStream *inStream, RakNet
 
 bool mwmp::PlayerPacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets.find((unsigned char)id) != packets.end();
 }
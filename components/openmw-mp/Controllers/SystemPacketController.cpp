@@ -29,10 +29,5 @@ void mwmp::SystemPacketController::SetStream(RakNet::BitStream *inStream, RakNet
 
 bool mwmp::SystemPacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets.find((unsigned char)id) != packets.end();
 }
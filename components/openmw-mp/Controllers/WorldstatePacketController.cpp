@@ -49,10 +49,5 @@ void mwmp::WorldstatePacketController::SetStream(RakNet::BitStream *inStream, Ra
 
 bool mwmp::WorldstatePacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets.find((unsigned char)id) != packets.end();
 }
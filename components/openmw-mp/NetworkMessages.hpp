@@ -113,6 +113,8 @@ enum GameMessages
     ID_WORLD_DESTINATION_OVERRIDE,
     ID_ACTOR_SPELLS_ACTIVE,
     ID_PLAYER_COOLDOWNS,
+    ID_PLAYER_POSITION_COMPACT,
+    ID_PACKET_BATCH,
     ID_PLACEHOLDER
 };
 
@@ -123,7 +125,8 @@ enum OrderingChannel
     CHANNEL_PLAYER,
     CHANNEL_OBJECT,
     CHANNEL_MASTER,
-    CHANNEL_WORLDSTATE
+    CHANNEL_WORLDSTATE,
+    CHANNEL_PLAYER_POSITION
 };
 
 
@@ -30,20 +30,18 @@ void ActorPacket::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    BaseActor actor;
-
     for (unsigned int i = 0; i < actorList->count; i++)
     {
-        if (send)
-            actor = actorList->baseActors.at(i);
+        // Write actors from wherever the list keeps them and read them straight into it
+        if (!send)
+            actorList->baseActors.emplace_back();
+
+        BaseActor &actor = send ? actorList->getSentActor(i) : actorList->baseActors.back();
 
         RW(actor.refNum, send);
         RW(actor.mpNum, send);
 
         Actor(actor, send);
-
-        if (!send)
-            actorList->baseActors.push_back(actor);
     }
 }
 
@@ -55,7 +53,7 @@ bool ActorPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
     RW(actorList->cell.mName, send, true);
 
     if (send)
-        actorList->count = (unsigned int)(actorList->baseActors.size());
+        actorList->count = actorList->getSentActorCount();
     else
         actorList->baseActors.clear();
 
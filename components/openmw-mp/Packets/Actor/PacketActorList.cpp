@@ -15,12 +15,12 @@ void PacketActorList::Packet(RakNet::BitStream *newBitstream, bool send)
 
     RW(actorList->action, send);
 
-    BaseActor actor;
-
     for (unsigned int i = 0; i < actorList->count; i++)
     {
-        if (send)
-            actor = actorList->baseActors.at(i);
+        if (!send)
+            actorList->baseActors.emplace_back();
+
+        BaseActor &actor = send ? actorList->getSentActor(i) : actorList->baseActors.back();
 
         RW(actor.refId, send);
         RW(actor.refNum, send);
@@ -28,11 +28,11 @@ void PacketActorList::Packet(RakNet::BitStream *newBitstream, bool send)
 
         if (actor.refId.empty() || (actor.refNum != 0 && actor.mpNum != 0))
         {
+            if (!send)
+                actorList->baseActors.pop_back();
+
             actorList->isValid = false;
             return;
         }
-
-        if (!send)
-            actorList->baseActors.push_back(actor);
     }
 }
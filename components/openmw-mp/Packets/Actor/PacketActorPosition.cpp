@@ -13,6 +13,7 @@ void PacketActorPosition::Actor(BaseActor &actor, bool send)
 {
     RW(actor.position, send, true);
     RW(actor.direction, send, true);
+    RW(actor.positionTimestamp, send);
 
     actor.hasPositionData = true;
 }
@@ -2,9 +2,14 @@
 #include <PacketPriority.h>
 #include <RakPeer.h>
 #include "BasePacket.hpp"
+#include "PacketBatcher.hpp"
 
 using namespace mwmp;
 
+std::array<PacketTraffic, 256> BasePacket::traffic;
+BasePacket::StringTablesLookup BasePacket::stringTablesLookup = nullptr;
+PacketBatcher *BasePacket::packetBatcher = nullptr;
+
 BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
 {
     packetID = 0;
@@ -12,6 +17,9 @@ BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
     reliability = RELIABLE_ORDERED;
     orderChannel = CHANNEL_SYSTEM;
     this->peer = peer;
+    stringTables = nullptr;
+    stringEncoder = nullptr;
+    stringDecoder = nullptr;
 }
 
 void BasePacket::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -24,6 +32,215 @@ void BasePacket::Packet(RakNet::BitStream *newBitstream, bool send)
         bs->Write(packetID);
         bs->Write(guid);
     }
+    else
+        stringDecoder = nullptr;
+
+    const int stringChannel = StringTables::getChannel(packetID);
+
+    if (stringChannel == -1)
+        return;
+
+    // Serialize() puts any strings defined while writing the rest of the packet in front of it
+    // afterwards, so only say whether the string tables are used here
+    if (send)
+    {
+        StringTables::writeVarint(bs, stringEncoder != nullptr ? 1 : 0);
+        return;
+    }
+
+    // The definitions were already learned when the packet was received
+    uint32_t marker;
+
+    if (!StringTables::readVarint(bs, marker) || marker == 0)
+        return;
+
+    if (stringTables == nullptr || !StringTables::skipDefinitions(bs, marker - 1))
+    {
+        packetValid = false;
+        return;
+    }
+
+    stringDecoder = &stringTables->getDecoder(stringChannel);
+}
+
+bool BasePacket::RWStringIndex(std::string &str, bool write, std::string::size_type maxSize, bool &result)
+{
+    result = true;
+
+    if (write)
+    {
+        uint32_t index;
+        bool isNew;
+
+        if (str.size() > maxSize || !stringEncoder->encode(str, index, isNew))
+        {
+            stringReferences.push_back({str, 0, false, false});
+            StringTables::writeVarint(bs, 0);
+            return false;
+        }
+
+        stringReferences.push_back({str, index, true, isNew});
+
+        if (isNew)
+            stringDefinitions.push_back(str);
+
+        StringTables::writeVarint(bs, index + 1);
+        return true;
+    }
+
+    uint32_t value;
+
+    if (!StringTables::readVarint(bs, value))
+    {
+        str = std::string();
+        result = false;
+        return true;
+    }
+
+    if (value == 0)
+        return false;
+
+    if (!stringDecoder->lookup(value - 1, str))
+    {
+        str = std::string();
+        result = false;
+        return true;
+    }
+
+    if (str.size() > maxSize)
+        str.resize(maxSize);
+
+    return true;
+}
+
+RakNet::BitStream *BasePacket::Serialize(StringTables *tables)
+{
+    stringEncoder = tables != nullptr ? &tables->getEncoder(StringTables::getChannel(packetID)) : nullptr;
+    stringDefinitions.clear();
+    stringReferences.clear();
+
+    bsSend->ResetWritePointer();
+    Packet(bsSend, true);
+    stringEncoder = nullptr;
+
+    if (stringDefinitions.empty())
+        return bsSend;
+
+    // Copy the packet over with the new definitions replacing the 1 byte marker that follows its header
+    const RakNet::BitSize_t dataOffset = BYTES_TO_BITS(headerSize() + 1);
+
+    bsDefinitions.Reset();
+    bsDefinitions.Write(reinterpret_cast<const char *>(bsSend->GetData()), headerSize());
+    StringTables::writeDefinitions(&bsDefinitions, stringDefinitions);
+    bsSend->SetReadOffset(dataOffset);
+    bsDefinitions.Write(bsSend, bsSend->GetNumberOfBitsUsed() - dataOffset);
+
+    return &bsDefinitions;
+}
+
+bool BasePacket::SharedSerialization::matches(const StringTableEncoder &encoder) const
+{
+    if (encoder.size() != encoderSize)
+        return false;
+
+    // New strings get the next indexes in the order they're written, so an encoder of the same
+    // size only has to agree on the strings that were already there and not have the others
+    for (const auto &reference : references)
+    {
+        uint32_t index;
+        const bool isFound = encoder.find(reference.str, index);
+
+        if (reference.isIndexed && !reference.isNew)
+        {
+            // A repeat of a string this packet defines itself
+            if (reference.index >= encoderSize)
+                continue;
+
+            if (!isFound || index != reference.index)
+                return false;
+        }
+        else if (isFound)
+            return false;
+    }
+
+    return true;
+}
+
+uint32_t BasePacket::SendWithStringTables(const std::vector<RakNet::RakNetGUID> &destinations)
+{
+    uint32_t result = 0;
+    std::vector<RakNet::RakNetGUID> textDestinations;
+
+    // Every connection has its own string tables, but the ones that were sent the same strings
+    // in the same order, such as everyone who got the same broadcasts, encode packets the same
+    // way and can share a serialization
+    std::vector<std::unique_ptr<SharedSerialization>> serializations;
+
+    for (const auto &destination : destinations)
+    {
+        StringTables *tables = stringTablesLookup(destination);
+
+        if (tables == nullptr)
+        {
+            textDestinations.push_back(destination);
+            continue;
+        }
+
+        StringTableEncoder &encoder = tables->getEncoder(StringTables::getChannel(packetID));
+        SharedSerialization *serialization = nullptr;
+
+        for (const auto &candidate : serializations)
+        {
+            if (candidate->matches(encoder))
+            {
+                serialization = candidate.get();
+                break;
+            }
+        }
+
+        if (serialization != nullptr)
+        {
+            uint32_t index;
+            bool isNew;
+
+            for (const auto &definition : serialization->definitions)
+                encoder.encode(definition, index, isNew);
+
+            traffic[packetID].bytesSent += serialization->stream.GetNumberOfBytesUsed();
+            result = sendStream(&serialization->stream, priority, reliability, destination, false);
+            continue;
+        }
+
+        auto serializeStart = std::chrono::steady_clock::now();
+        const uint32_t encoderSize = encoder.size();
+        RakNet::BitStream *stream = Serialize(tables);
+
+        const uint32_t length = stream->GetNumberOfBytesUsed();
+        countTraffic(length, length, serializeStart);
+
+        result = sendStream(stream, priority, reliability, destination, false);
+
+        std::unique_ptr<SharedSerialization> shared(new SharedSerialization());
+        shared->encoderSize = encoderSize;
+        shared->references.swap(stringReferences);
+        shared->definitions = stringDefinitions;
+        shared->stream.Write(reinterpret_cast<const char *>(stream->GetData()), length);
+        serializations.push_back(std::move(shared));
+    }
+
+    if (textDestinations.empty())
+        return result;
+
+    auto serializeStart = std::chrono::steady_clock::now();
+    RakNet::BitStream *stream = Serialize(nullptr);
+
+    const uint32_t length = stream->GetNumberOfBytesUsed();
+    countTraffic(length, length * static_cast<uint32_t>(textDestinations.size()), serializeStart);
+
+    for (const auto &destination : textDestinations)
+        result = sendStream(stream, priority, reliability, destination, false);
+
+    return result;
 }
 
 void BasePacket::SetReadStream(RakNet::BitStream *bitStream)
@@ -49,26 +266,139 @@ uint32_t BasePacket::RequestData(RakNet::RakNetGUID targetGuid)
     bsSend->ResetWritePointer();
     bsSend->Write(packetID);
     bsSend->Write(targetGuid);
-    return peer->Send(bsSend, HIGH_PRIORITY, RELIABLE_ORDERED, orderChannel, targetGuid, false);
+    return sendStream(bsSend, HIGH_PRIORITY, RELIABLE_ORDERED, targetGuid, false);
 }
 
 uint32_t BasePacket::Send(RakNet::AddressOrGUID destination)
 {
-    bsSend->ResetWritePointer();
-    Packet(bsSend, true);
-    return peer->Send(bsSend, priority, reliability, orderChannel, destination, false);
+    auto serializeStart = std::chrono::steady_clock::now();
+    RakNet::BitStream *stream = Serialize(usesStringTables() ? stringTablesLookup(destination) : nullptr);
+
+    const uint32_t length = stream->GetNumberOfBytesUsed();
+    countTraffic(length, length, serializeStart);
+
+    return sendStream(stream, priority, reliability, destination, false);
+}
+
+uint32_t BasePacket::Send(const std::vector<RakNet::RakNetGUID> &destinations)
+{
+    if (destinations.empty())
+        return 0;
+
+    if (usesStringTables())
+        return SendWithStringTables(destinations);
+
+    auto serializeStart = std::chrono::steady_clock::now();
+    RakNet::BitStream *stream = Serialize(nullptr);
+
+    const uint32_t length = stream->GetNumberOfBytesUsed();
+    countTraffic(length, length * static_cast<uint32_t>(destinations.size()), serializeStart);
+
+    // RakPeer copies the stream's data when queueing it, so the same serialized
+    // payload can be reused for every recipient
+    uint32_t result = 0;
+    for (const auto &destination : destinations)
+        result = sendStream(stream, priority, reliability, destination, false);
+
+    return result;
+}
+
+void BasePacket::Send(const std::vector<RakNet::RakNetGUID> &destinations, std::vector<uint32_t> &receipts)
+{
+    receipts.clear();
+
+    if (destinations.empty())
+        return;
+
+    if (usesStringTables())
+    {
+        for (const auto &destination : destinations)
+            receipts.push_back(Send(RakNet::AddressOrGUID(destination)));
+        return;
+    }
+
+    auto serializeStart = std::chrono::steady_clock::now();
+    RakNet::BitStream *stream = Serialize(nullptr);
+
+    const uint32_t length = stream->GetNumberOfBytesUsed();
+    countTraffic(length, length * static_cast<uint32_t>(destinations.size()), serializeStart);
+
+    for (const auto &destination : destinations)
+        receipts.push_back(sendStream(stream, priority, reliability, destination, false));
 }
 
 uint32_t BasePacket::Send(bool toOther)
 {
-    bsSend->ResetWritePointer();
-    Packet(bsSend, true);
-    return peer->Send(bsSend, priority, reliability, orderChannel, guid, toOther);
+    if (usesStringTables())
+    {
+        std::vector<RakNet::RakNetGUID> destinations;
+
+        if (toOther)
+        {
+            // Make the same list of connections a broadcast would go out to
+            DataStructures::List<RakNet::SystemAddress> addresses;
+            DataStructures::List<RakNet::RakNetGUID> guids;
+            peer->GetSystemList(addresses, guids);
+
+            for (unsigned int i = 0; i < guids.Size(); i++)
+            {
+                if (guids[i] != guid)
+                    destinations.push_back(guids[i]);
+            }
+        }
+        else
+            destinations.push_back(guid);
+
+        return SendWithStringTables(destinations);
+    }
+
+    auto serializeStart = std::chrono::steady_clock::now();
+    RakNet::BitStream *stream = Serialize(nullptr);
+
+    // A broadcast goes out to at most every open connection
+    const uint32_t length = stream->GetNumberOfBytesUsed();
+    countTraffic(length, toOther ? length * peer->NumberOfConnections() : length, serializeStart);
+
+    return sendStream(stream, priority, reliability, guid, toOther);
+}
+
+uint32_t BasePacket::sendStream(RakNet::BitStream *stream, PacketPriority sendPriority, PacketReliability sendReliability,
+                                const RakNet::AddressOrGUID &destination, bool broadcast)
+{
+    if (packetBatcher != nullptr && packetBatcher->getPeer() == peer)
+        return packetBatcher->send(stream, sendPriority, sendReliability, orderChannel, destination, broadcast);
+
+    return peer->Send(stream, sendPriority, sendReliability, orderChannel, destination, broadcast);
+}
+
+void BasePacket::countTraffic(uint32_t serialized, uint32_t sent, std::chrono::steady_clock::time_point serializeStart) const
+{
+    PacketTraffic &packetTraffic = traffic[packetID];
+    packetTraffic.serializeTime += std::chrono::steady_clock::now() - serializeStart;
+    packetTraffic.packetsSerialized++;
+    packetTraffic.bytesSerialized += serialized;
+    packetTraffic.bytesSent += sent;
 }
 
 void BasePacket::Read()
 {
     Packet(bsRead, false);
+    stringDecoder = nullptr;
+}
+
+void BasePacket::setStringTables(StringTables *tables)
+{
+    stringTables = tables;
+}
+
+void BasePacket::setStringTablesLookup(StringTablesLookup lookup)
+{
+    stringTablesLookup = lookup;
+}
+
+void BasePacket::setPacketBatcher(PacketBatcher *batcher)
+{
+    packetBatcher = batcher;
 }
 
 void BasePacket::setGUID(RakNet::RakNetGUID newGuid)
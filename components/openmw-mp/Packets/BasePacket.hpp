@@ -1,17 +1,35 @@
 #ifndef OPENMW_BASEPACKET_HPP
 #define OPENMW_BASEPACKET_HPP
 
+#include <array>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
 #include <RakNetTypes.h>
 #include <BitStream.h>
 #include <PacketPriority.h>
 
+#include "StringTables.hpp"
 
 namespace mwmp
 {
+    class PacketBatcher;
+
+    struct PacketTraffic
+    {
+        uint64_t packetsSerialized = 0;
+        uint64_t bytesSerialized = 0;
+        uint64_t bytesSent = 0;
+        std::chrono::steady_clock::duration serializeTime = std::chrono::steady_clock::duration::zero();
+    };
+
     class BasePacket
     {
     public:
+        // Find the string tables to use for a connection, or nullptr if it can't use them
+        typedef StringTables *(*StringTablesLookup)(const RakNet::AddressOrGUID &connection);
+
         explicit BasePacket(RakNet::RakPeerInterface *peer);
 
         virtual ~BasePacket() = default;
@@ -19,11 +37,21 @@ namespace mwmp
         virtual void Packet(RakNet::BitStream *newBitstream, bool send);
         virtual uint32_t Send(bool toOtherPlayers = true);
         virtual uint32_t Send(RakNet::AddressOrGUID destination);
+        // Serialize once and hand the same BitStream to every destination
+        virtual uint32_t Send(const std::vector<RakNet::RakNetGUID> &destinations);
+        // Same as above, keeping the receipt of every message for the ones sent with an ack receipt
+        void Send(const std::vector<RakNet::RakNetGUID> &destinations, std::vector<uint32_t> &receipts);
         virtual void Read();
 
         void setGUID(RakNet::RakNetGUID newGuid);
         RakNet::RakNetGUID getGUID();
 
+        // Set the string tables of the connection whose packet is read next
+        void setStringTables(StringTables *tables);
+        static void setStringTablesLookup(StringTablesLookup lookup);
+        // Send messages through a batcher when they go out through its peer, or directly for nullptr
+        static void setPacketBatcher(PacketBatcher *batcher);
+
         void SetReadStream(RakNet::BitStream *bitStream);
         void SetSendStream(RakNet::BitStream *bitStream);
         void SetStreams(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
@@ -44,6 +72,16 @@ namespace mwmp
             return packetValid;
         }
 
+        static const PacketTraffic &getTraffic(uint8_t packetID)
+        {
+            return traffic[packetID];
+        }
+
+        static void resetTraffic()
+        {
+            traffic.fill(PacketTraffic());
+        }
+
     protected:
         template<class templateType>
         bool RW(templateType &data, uint32_t size, bool write)
@@ -89,6 +127,9 @@ namespace mwmp
         bool RW(std::string &str, bool write, bool compress = false, std::string::size_type maxSize = maxStrSize)
         {
             bool res = true;
+            if ((stringEncoder != nullptr || stringDecoder != nullptr) && RWStringIndex(str, write, maxSize, res))
+                return res;
+
             if (write)
             {
                 if (compress)
@@ -120,6 +161,48 @@ namespace mwmp
         }
 
     protected:
+        /**
+         * Write or read a string as its index in the connection's string table.
+         *
+         * \return False if the string has to be sent as text instead, which is then what follows.
+         */
+        bool RWStringIndex(std::string &str, bool write, std::string::size_type maxSize, bool &result);
+
+        // A string written by the last serialization, and how its encoder stood before it
+        struct StringReference
+        {
+            std::string str;
+            uint32_t index;
+            bool isIndexed;
+            bool isNew;
+        };
+
+        // A packet serialized for one connection's string tables, which every other connection
+        // whose encoder is in the same state would get byte for byte
+        struct SharedSerialization
+        {
+            uint32_t encoderSize;
+            std::vector<StringReference> references;
+            std::vector<std::string> definitions;
+            RakNet::BitStream stream;
+
+            bool matches(const StringTableEncoder &encoder) const;
+        };
+
+        // Serialize the packet for a connection using these string tables, or as text for nullptr
+        RakNet::BitStream *Serialize(StringTables *tables);
+        uint32_t SendWithStringTables(const std::vector<RakNet::RakNetGUID> &destinations);
+
+        bool usesStringTables() const
+        {
+            return stringTablesLookup != nullptr && StringTables::getChannel(packetID) != -1;
+        }
+
+        uint32_t sendStream(RakNet::BitStream *stream, PacketPriority sendPriority, PacketReliability sendReliability,
+                            const RakNet::AddressOrGUID &destination, bool broadcast);
+
+        void countTraffic(uint32_t serialized, uint32_t sent, std::chrono::steady_clock::time_point serializeStart) const;
+
         uint8_t packetID;
         PacketReliability reliability;
         PacketPriority priority;
@@ -128,6 +211,18 @@ namespace mwmp
         RakNet::RakPeerInterface *peer;
         RakNet::RakNetGUID guid;
         bool packetValid;
+
+        StringTables *stringTables;
+        StringTableEncoder *stringEncoder;
+        const StringTableDecoder *stringDecoder;
+        std::vector<std::string> stringDefinitions;
+        std::vector<StringReference> stringReferences;
+        RakNet::BitStream bsDefinitions;
+
+    private:
+        static std::array<PacketTraffic, 256> traffic;
+        static StringTablesLookup stringTablesLookup;
+        static PacketBatcher *packetBatcher;
     };
 }
 
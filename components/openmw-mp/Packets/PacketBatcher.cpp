@@ -0,0 +1,164 @@
+#include <limits>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <RakPeerInterface.h>
+#include "PacketBatcher.hpp"
+#include "StringTables.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    // The size a message takes up in a batch, which is never more than maxBatchSize, so its
+    // varint fits in 2 bytes
+    unsigned int getBatchedSize(unsigned int length)
+    {
+        return (length < 0x80 ? 1 : 2) + length;
+    }
+}
+
+PacketBatcher::PacketBatcher(RakNet::RakPeerInterface *peer) : peer(peer)
+{
+
+}
+
+uint32_t PacketBatcher::send(const RakNet::BitStream *stream, PacketPriority priority, PacketReliability reliability,
+                             char orderChannel, const RakNet::AddressOrGUID &destination, bool broadcast)
+{
+    const unsigned int length = stream->GetNumberOfBytesUsed();
+
+    RakNet::RakNetGUID guid = destination.rakNetGuid;
+
+    if (guid == RakNet::UNASSIGNED_CRABNET_GUID)
+        guid = peer->GetGuidFromSystemAddress(destination.systemAddress);
+
+    const BatchKey key(guid.g, orderChannel);
+
+    // Only reliable ordered messages keep their order when they're unpacked, messages sent
+    // to an address are left alone because they can come before the connection is set up, and
+    // ones with immediate priority can't wait for the end of the tick
+    if (broadcast || reliability != RELIABLE_ORDERED || priority == IMMEDIATE_PRIORITY ||
+        destination.rakNetGuid == RakNet::UNASSIGNED_CRABNET_GUID || length == 0 ||
+        1 + getBatchedSize(length) > maxBatchSize)
+    {
+        if (broadcast)
+            flushChannel(orderChannel);
+        else
+        {
+            auto it = batches.find(key);
+
+            if (it != batches.end())
+            {
+                send(key, it->second);
+                batches.erase(it);
+            }
+        }
+
+        return peer->Send(stream, priority, reliability, orderChannel, destination, broadcast);
+    }
+
+    Batch &batch = batches[key];
+
+    if (batch.messageCount != 0 && (batch.priority != priority ||
+        batch.stream.GetNumberOfBytesUsed() + getBatchedSize(length) > maxBatchSize))
+        send(key, batch);
+
+    if (batch.messageCount == 0)
+    {
+        batch.stream.Write(static_cast<RakNet::MessageID>(ID_PACKET_BATCH));
+        batch.priority = priority;
+    }
+
+    StringTables::writeVarint(&batch.stream, length);
+
+    if (batch.messageCount == 0)
+        batch.firstMessageOffset = batch.stream.GetNumberOfBytesUsed();
+
+    batch.stream.Write(reinterpret_cast<const char *>(stream->GetData()), length);
+    batch.messageCount++;
+
+    // The message only gets a receipt of its own once the batch is sent, so just say it was queued
+    return length;
+}
+
+void PacketBatcher::flush()
+{
+    for (auto &batch : batches)
+        send(batch.first, batch.second);
+
+    batches.clear();
+}
+
+void PacketBatcher::flush(RakNet::RakNetGUID guid)
+{
+    auto it = batches.lower_bound(BatchKey(guid.g, std::numeric_limits<char>::min()));
+
+    while (it != batches.end() && it->first.first == guid.g)
+    {
+        send(it->first, it->second);
+        it = batches.erase(it);
+    }
+}
+
+bool PacketBatcher::unpack(const unsigned char *data, unsigned int length,
+                           std::vector<std::pair<const unsigned char *, unsigned int>> &messages)
+{
+    messages.clear();
+
+    if (length < 1 || data[0] != ID_PACKET_BATCH)
+        return false;
+
+    RakNet::BitStream bs(const_cast<unsigned char *>(data), length, false);
+    bs.IgnoreBytes(1);
+
+    while (bs.GetNumberOfUnreadBits() > 0)
+    {
+        uint32_t size;
+
+        if (!StringTables::readVarint(&bs, size) || size == 0 || size > BITS_TO_BYTES(bs.GetNumberOfUnreadBits()))
+        {
+            messages.clear();
+            return false;
+        }
+
+        messages.emplace_back(data + BITS_TO_BYTES(bs.GetReadOffset()), size);
+        bs.IgnoreBytes(size);
+    }
+
+    return !messages.empty();
+}
+
+void PacketBatcher::send(const BatchKey &key, Batch &batch)
+{
+    if (batch.messageCount == 0)
+        return;
+
+    const RakNet::RakNetGUID guid(key.first);
+
+    const unsigned int length = batch.stream.GetNumberOfBytesUsed();
+    const char *data = reinterpret_cast<const char *>(batch.stream.GetData());
+
+    // A single message doesn't need the batch around it
+    if (batch.messageCount == 1)
+        peer->Send(data + batch.firstMessageOffset, static_cast<int>(length - batch.firstMessageOffset),
+                   batch.priority, RELIABLE_ORDERED, key.second, guid, false);
+    else
+        peer->Send(data, static_cast<int>(length), batch.priority, RELIABLE_ORDERED, key.second, guid, false);
+
+    batch.stream.Reset();
+    batch.messageCount = 0;
+}
+
+void PacketBatcher::flushChannel(char orderChannel)
+{
+    for (auto it = batches.begin(); it != batches.end();)
+    {
+        if (it->first.second == orderChannel)
+        {
+            send(it->first, it->second);
+            it = batches.erase(it);
+        }
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef OPENMW_PACKETBATCHER_HPP
+#define OPENMW_PACKETBATCHER_HPP
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <RakNetTypes.h>
+#include <BitStream.h>
+#include <PacketPriority.h>
+
+namespace mwmp
+{
+    /**
+     * Coalesces the reliable ordered messages sent to a connection on the same ordering channel,
+     * so a burst of small packets goes out as one ID_PACKET_BATCH message instead of many.
+     * Messages with IMMEDIATE_PRIORITY are sent right away, after the batch they would overtake.
+     *
+     * A batch holds the ID_PACKET_BATCH byte followed by every message as a varint with its size
+     * and then its bytes. It is sent once it would grow past maxBatchSize or when it's flushed,
+     * which the owner does at least once per tick, so messages are never held back for longer.
+     * A batch that only ends up holding one message is sent as that message.
+     */
+    class PacketBatcher
+    {
+    public:
+        // Stay under the MTU, so a batch doesn't have to be split up by RakNet again
+        static const unsigned int maxBatchSize = 1200;
+
+        explicit PacketBatcher(RakNet::RakPeerInterface *peer);
+
+        RakNet::RakPeerInterface *getPeer() const
+        {
+            return peer;
+        }
+
+        /**
+         * Send a message the way RakPeerInterface::Send() would, but add it to the batch of its
+         * connection and channel if it can go out as part of one.
+         *
+         * Anything else sent on the same channel first flushes the batches it could overtake.
+         */
+        uint32_t send(const RakNet::BitStream *stream, PacketPriority priority, PacketReliability reliability,
+                      char orderChannel, const RakNet::AddressOrGUID &destination, bool broadcast);
+
+        // Send every batch
+        void flush();
+        // Send the batches of one connection, such as before it's closed
+        void flush(RakNet::RakNetGUID guid);
+
+        /**
+         * Split the data of an ID_PACKET_BATCH message into the messages it holds.
+         *
+         * \return False if the batch is malformed, in which case none of it should be used.
+         */
+        static bool unpack(const unsigned char *data, unsigned int length,
+                           std::vector<std::pair<const unsigned char *, unsigned int>> &messages);
+
+    private:
+        struct Batch
+        {
+            RakNet::BitStream stream;
+            PacketPriority priority;
+            unsigned int messageCount = 0;
+            // Where the first message's bytes start, after the batch's ID and their size
+            unsigned int firstMessageOffset = 0;
+        };
+
+        typedef std::pair<uint64_t, char> BatchKey;
+
+        void send(const BatchKey &key, Batch &batch);
+        void flushChannel(char orderChannel);
+
+        RakNet::RakPeerInterface *peer;
+        std::map<BatchKey, Batch> batches;
+    };
+}
+
+#endif //OPENMW_PACKETBATCHER_HPP
@@ -16,4 +16,5 @@ void PacketPlayerPosition::Packet(RakNet::BitStream *newBitstream, bool send)
 
     RW(player->position, send, 1);
     RW(player->direction, send, 1);
+    RW(player->positionTimestamp, send);
 }
@@ -0,0 +1,237 @@
+#include "PacketPlayerPositionCompact.hpp"
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace mwmp;
+
+namespace
+{
+    const double coordinateScale = 8.0;
+    const double turningScale = 8192.0;
+    const double pi = 3.14159265358979323846;
+
+    // Used in place of a NaN rotation, which the receiving side already knows to skip
+    const int16_t invalidTurning = std::numeric_limits<int16_t>::min();
+
+    int32_t quantizeCoordinate(float value)
+    {
+        if (std::isnan(value))
+            return 0;
+
+        double scaled = std::round(value * coordinateScale);
+        scaled = std::max(scaled, static_cast<double>(std::numeric_limits<int32_t>::min()));
+        scaled = std::min(scaled, static_cast<double>(std::numeric_limits<int32_t>::max()));
+        return static_cast<int32_t>(scaled);
+    }
+
+    uint16_t quantizeAngle(float angle)
+    {
+        if (std::isnan(angle))
+            return 0;
+
+        double turns = angle / (2 * pi);
+        turns -= std::floor(turns);
+        return static_cast<uint16_t>(static_cast<uint32_t>(std::lround(turns * 65536.0)) & 0xFFFF);
+    }
+
+    float dequantizeAngle(uint16_t value)
+    {
+        double angle = value * (2 * pi) / 65536.0;
+        if (angle >= pi)
+            angle -= 2 * pi;
+        return static_cast<float>(angle);
+    }
+
+    int8_t quantizeMovement(float value)
+    {
+        if (std::isnan(value))
+            return 0;
+
+        return static_cast<int8_t>(std::max(-127.0, std::min(127.0, std::round(value * 127.0))));
+    }
+
+    int16_t quantizeTurning(float value)
+    {
+        if (std::isnan(value))
+            return invalidTurning;
+
+        return static_cast<int16_t>(std::max(-32767.0, std::min(32767.0, std::round(value * turningScale))));
+    }
+
+    float dequantizeTurning(int16_t value)
+    {
+        if (value == invalidTurning)
+            return std::numeric_limits<float>::quiet_NaN();
+
+        return static_cast<float>(value / turningScale);
+    }
+
+    bool fitsDelta(int32_t value, int32_t baseline)
+    {
+        int64_t delta = static_cast<int64_t>(value) - baseline;
+        return delta >= std::numeric_limits<int16_t>::min() && delta <= std::numeric_limits<int16_t>::max();
+    }
+}
+
+PacketPlayerPositionCompact::PacketPlayerPositionCompact(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
+{
+    packetID = ID_PLAYER_POSITION_COMPACT;
+    priority = MEDIUM_PRIORITY;
+    reliability = UNRELIABLE_WITH_ACK_RECEIPT;
+    orderChannel = CHANNEL_PLAYER_POSITION;
+    isKeyframe = true;
+    endsMovement = false;
+}
+
+void PacketPlayerPositionCompact::setKeyframe(bool isKeyframe)
+{
+    this->isKeyframe = isKeyframe;
+    updateReliability();
+}
+
+void PacketPlayerPositionCompact::setEndsMovement(bool endsMovement)
+{
+    this->endsMovement = endsMovement;
+    updateReliability();
+}
+
+void PacketPlayerPositionCompact::updateReliability()
+{
+    // Keyframes are sent with a receipt so the server knows when it can start sending deltas
+    // against them, and the update that leaves a player standing still is never allowed to be
+    // lost, because nothing else will follow it to correct the position
+    if (isKeyframe)
+        reliability = endsMovement ? RELIABLE_WITH_ACK_RECEIPT : UNRELIABLE_WITH_ACK_RECEIPT;
+    else
+        reliability = endsMovement ? RELIABLE_SEQUENCED : UNRELIABLE_SEQUENCED;
+}
+
+bool PacketPlayerPositionCompact::updateBaseline(BasePlayer &player)
+{
+    PositionBaseline &baseline = player.positionBaseline;
+
+    bool needsKeyframe = !baseline.isValid || ++baseline.age >= keyframeInterval;
+
+    int32_t position[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        position[i] = quantizeCoordinate(player.position.pos[i]);
+
+        if (!needsKeyframe && !fitsDelta(position[i], baseline.position[i]))
+            needsKeyframe = true;
+    }
+
+    if (!needsKeyframe)
+        return false;
+
+    baseline.isValid = true;
+    baseline.keyframeId++;
+    baseline.age = 0;
+    std::copy(position, position + 3, baseline.position);
+    return true;
+}
+
+void PacketPlayerPositionCompact::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    PlayerPacket::Packet(newBitstream, send);
+
+    PositionBaseline &baseline = player->positionBaseline;
+
+    int32_t position[3] = {0, 0, 0};
+    int16_t delta[3] = {0, 0, 0};
+    uint16_t yaw = 0, pitch = 0;
+    int8_t movement[3] = {0, 0, 0};
+    int16_t turning[3] = {0, 0, 0};
+    uint8_t keyframeId = baseline.keyframeId;
+    uint32_t timestamp = player->positionTimestamp;
+
+    if (send)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            // Keyframes are resent until they are acknowledged, so they carry the baseline and
+            // the current delta from it like any other update instead of a new baseline
+            position[i] = baseline.position[i];
+            movement[i] = quantizeMovement(player->direction.pos[i]);
+            turning[i] = quantizeTurning(player->direction.rot[i]);
+
+            int32_t clamped = std::max<int32_t>(std::numeric_limits<int16_t>::min(),
+                std::min<int32_t>(std::numeric_limits<int16_t>::max(),
+                quantizeCoordinate(player->position.pos[i]) - baseline.position[i]));
+            delta[i] = static_cast<int16_t>(clamped);
+        }
+
+        pitch = quantizeAngle(player->position.rot[0]);
+        yaw = quantizeAngle(player->position.rot[2]);
+    }
+
+    bool isRead = RW(isKeyframe, send) && RW(keyframeId, send);
+
+    if (isKeyframe)
+    {
+        for (int i = 0; i < 3; ++i)
+            isRead = isRead && RW(position[i], send, true);
+    }
+
+    for (int i = 0; i < 3; ++i)
+        isRead = isRead && RW(delta[i], send, true);
+
+    isRead = isRead && RW(yaw, send) && RW(pitch, send);
+
+    for (int i = 0; i < 3; ++i)
+        isRead = isRead && RW(movement[i], send);
+
+    for (int i = 0; i < 3; ++i)
+        isRead = isRead && RW(turning[i], send, true);
+
+    isRead = isRead && RW(timestamp, send);
+
+    if (send)
+        return;
+
+    if (!isRead)
+    {
+        packetValid = false;
+        return;
+    }
+
+    if (isKeyframe)
+    {
+        // Keyframes aren't sequenced, so a resent one can arrive after newer updates
+        if (baseline.isValid && static_cast<int32_t>(timestamp - player->positionTimestamp) < 0)
+        {
+            packetValid = false;
+            return;
+        }
+
+        baseline.isValid = true;
+        baseline.keyframeId = keyframeId;
+        baseline.age = 0;
+        std::copy(position, position + 3, baseline.position);
+    }
+    else if (!baseline.isValid || baseline.keyframeId != keyframeId)
+    {
+        // The keyframe this delta was encoded against hasn't arrived yet, so skip
+        // updates until it does
+        packetValid = false;
+        return;
+    }
+
+    for (int i = 0; i < 3; ++i)
+        position[i] = baseline.position[i] + delta[i];
+
+    for (int i = 0; i < 3; ++i)
+    {
+        player->position.pos[i] = static_cast<float>(position[i] / coordinateScale);
+        player->direction.pos[i] = movement[i] / 127.0f;
+        player->direction.rot[i] = dequantizeTurning(turning[i]);
+    }
+
+    player->position.rot[0] = dequantizeAngle(pitch);
+    player->position.rot[1] = 0;
+    player->position.rot[2] = dequantizeAngle(yaw);
+    player->positionTimestamp = timestamp;
+}
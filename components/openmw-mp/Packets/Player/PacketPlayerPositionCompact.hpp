@@ -0,0 +1,41 @@
+#ifndef OPENMW_PACKETPLAYERPOSITIONCOMPACT_HPP
+#define OPENMW_PACKETPLAYERPOSITIONCOMPACT_HPP
+
+#include <components/openmw-mp/Packets/Player/PlayerPacket.hpp>
+
+namespace mwmp
+{
+    // A smaller form of PacketPlayerPosition that is only relayed by the server to clients
+    // that listed BaseSystem::COMPACT_POSITION in their handshake
+    //
+    // Coordinates are quantized to 1/8 of a unit, only yaw and pitch are kept from the rotation,
+    // and most packets only carry the difference from the last keyframe
+    //
+    // The server keeps sending a keyframe to a client until RakNet reports it as acknowledged,
+    // and only then switches that client over to deltas against it
+    class PacketPlayerPositionCompact : public PlayerPacket
+    {
+    public:
+        PacketPlayerPositionCompact(RakNet::RakPeerInterface *peer);
+
+        virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+
+        void setKeyframe(bool isKeyframe);
+        // Whether this update leaves the player standing still, which makes it reliable
+        void setEndsMovement(bool endsMovement);
+
+        // Start a new keyframe in the player's baseline if the current one is too old or the
+        // player has moved too far from it for a delta, returning whether one was started
+        static bool updateBaseline(BasePlayer &player);
+
+        static const unsigned int keyframeInterval = 30;
+
+    private:
+        void updateReliability();
+
+        bool isKeyframe;
+        bool endsMovement;
+    };
+}
+
+#endif //OPENMW_PACKETPLAYERPOSITIONCOMPACT_HPP
@@ -0,0 +1,171 @@
+#include "StringTables.hpp"
+
+using namespace mwmp;
+
+bool StringTableEncoder::encode(const std::string &str, uint32_t &index, bool &isNew)
+{
+    auto it = indexes.find(str);
+
+    if (it != indexes.end())
+    {
+        index = it->second;
+        isNew = false;
+        return true;
+    }
+
+    if (str.size() > maxEntryLength || indexes.size() >= capacity)
+        return false;
+
+    index = static_cast<uint32_t>(indexes.size());
+    isNew = true;
+    indexes.emplace(str, index);
+    return true;
+}
+
+bool StringTableEncoder::find(const std::string &str, uint32_t &index) const
+{
+    auto it = indexes.find(str);
+
+    if (it == indexes.end())
+        return false;
+
+    index = it->second;
+    return true;
+}
+
+bool StringTableDecoder::define(const std::string &str)
+{
+    const uint32_t index = size.load(std::memory_order_relaxed);
+
+    if (index >= StringTableEncoder::capacity)
+        return false;
+
+    std::unique_ptr<std::string[]> &chunk = chunks[index / chunkSize];
+
+    if (!chunk)
+        chunk.reset(new std::string[chunkSize]);
+
+    chunk[index % chunkSize] = str;
+
+    // Publish the entry only once it's been written, for threads already decoding earlier packets
+    size.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+bool StringTableDecoder::lookup(uint32_t index, std::string &str) const
+{
+    if (index >= size.load(std::memory_order_acquire))
+        return false;
+
+    str = chunks[index / chunkSize][index % chunkSize];
+    return true;
+}
+
+int StringTables::getChannel(RakNet::MessageID packetID)
+{
+    // Only reliable ordered packets can be used, since their definitions have to arrive in order
+    switch (packetID)
+    {
+        case ID_PLAYER_INVENTORY:
+        case ID_PLAYER_SPELLBOOK:
+            return CHANNEL_PLAYER;
+        case ID_CONTAINER:
+        case ID_OBJECT_PLACE:
+            return CHANNEL_OBJECT;
+        default:
+            return -1;
+    }
+}
+
+StringTableEncoder &StringTables::getEncoder(int channel)
+{
+    return encoders[channel];
+}
+
+const StringTableDecoder &StringTables::getDecoder(int channel) const
+{
+    return decoders[channel];
+}
+
+void StringTables::readDefinitions(const RakNet::Packet &packet)
+{
+    const int channel = getChannel(packet.data[0]);
+
+    if (channel == -1)
+        return;
+
+    RakNet::BitStream bsIn(&packet.data[1], packet.length - 1, false);
+    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+    uint32_t marker;
+
+    // Data requests are just a header
+    if (!readVarint(&bsIn, marker) || marker == 0)
+        return;
+
+    StringTableDecoder &decoder = decoders[channel];
+    RakNet::RakString rstr;
+
+    for (uint32_t i = 0; i < marker - 1; i++)
+    {
+        if (!rstr.DeserializeCompressed(&bsIn))
+            return;
+
+        rstr.Truncate(rstr.GetLength() > StringTableEncoder::maxEntryLength ? StringTableEncoder::maxEntryLength : rstr.GetLength());
+
+        if (!decoder.define(rstr.C_String()))
+            return;
+    }
+}
+
+void StringTables::writeDefinitions(RakNet::BitStream *bs, const std::vector<std::string> &definitions)
+{
+    writeVarint(bs, static_cast<uint32_t>(definitions.size()) + 1);
+
+    for (const auto &definition : definitions)
+        RakNet::RakString::SerializeCompressed(definition.c_str(), bs);
+}
+
+bool StringTables::skipDefinitions(RakNet::BitStream *bs, uint32_t definitionCount)
+{
+    RakNet::RakString rstr;
+
+    for (uint32_t i = 0; i < definitionCount; i++)
+    {
+        if (!rstr.DeserializeCompressed(bs))
+            return false;
+    }
+
+    return true;
+}
+
+void StringTables::writeVarint(RakNet::BitStream *bs, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        bs->Write(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+
+    bs->Write(static_cast<uint8_t>(value));
+}
+
+bool StringTables::readVarint(RakNet::BitStream *bs, uint32_t &value)
+{
+    value = 0;
+
+    for (unsigned int shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t byte;
+
+        if (!bs->Read(byte))
+            return false;
+
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
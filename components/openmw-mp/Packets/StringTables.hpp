@@ -0,0 +1,118 @@
+#ifndef OPENMW_STRINGTABLES_HPP
+#define OPENMW_STRINGTABLES_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <RakNetTypes.h>
+#include <BitStream.h>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+namespace mwmp
+{
+    /**
+     * Strings a connection has sent on one ordering channel, so packets can refer to them by index.
+     *
+     * Indexes are handed out in the order strings are first sent, which the receiving side's
+     * StringTableDecoder repeats as long as it learns the definitions of every packet sent on
+     * the channel, in the order they were sent.
+     */
+    class StringTableEncoder
+    {
+    public:
+        static const uint32_t capacity = 4096;
+        // Longer strings aren't likely to be ids, so they're always sent as text
+        static const std::string::size_type maxEntryLength = 64;
+
+        /**
+         * Get the index a string is known by, assigning it the next one if it's new.
+         *
+         * \return False if the string is too long or the table is full, in which case it has to
+         *         be sent as text.
+         */
+        bool encode(const std::string &str, uint32_t &index, bool &isNew);
+        // Get the index of a string that has already been sent, without assigning one otherwise
+        bool find(const std::string &str, uint32_t &index) const;
+
+        uint32_t size() const
+        {
+            return static_cast<uint32_t>(indexes.size());
+        }
+
+    private:
+        std::unordered_map<std::string, uint32_t> indexes;
+    };
+
+    /**
+     * The receiving side of a StringTableEncoder.
+     *
+     * Definitions are only ever added by the thread that receives packets, but strings can be
+     * looked up from others at the same time. Entries are never moved once defined, so lookups
+     * only need to know how many of them have been.
+     */
+    class StringTableDecoder
+    {
+    public:
+        StringTableDecoder() : size(0)
+        {
+
+        }
+
+        // Append the next definition, returning false if the table is already full
+        bool define(const std::string &str);
+        bool lookup(uint32_t index, std::string &str) const;
+
+    private:
+        static const uint32_t chunkSize = 256;
+
+        std::array<std::unique_ptr<std::string[]>, StringTableEncoder::capacity / chunkSize> chunks;
+        std::atomic<uint32_t> size;
+    };
+
+    /**
+     * The string tables kept for a connection, with one encoder for what is sent to it and one
+     * decoder for what is received from it on every ordering channel.
+     *
+     * Packets that can use them, listed in getChannel(), have a varint right after their header,
+     * which is 0 if their strings are sent as text and otherwise 1 more than the number of new
+     * strings defined by the packet, which then follow as compressed RakStrings. Every string
+     * in their data is then a varint holding 1 more than its index, or 0 followed by its text.
+     */
+    class StringTables
+    {
+    public:
+        // Get the ordering channel whose tables a packet's strings go through, or -1 if its
+        // strings are always sent as text
+        static int getChannel(RakNet::MessageID packetID);
+
+        StringTableEncoder &getEncoder(int channel);
+        const StringTableDecoder &getDecoder(int channel) const;
+
+        /**
+         * Learn the strings defined by a packet received from this connection.
+         *
+         * This has to happen for every packet the connection sends, in the order they arrive
+         * and before any of them are read, even for packets that will end up being ignored.
+         */
+        void readDefinitions(const RakNet::Packet &packet);
+
+        static void writeDefinitions(RakNet::BitStream *bs, const std::vector<std::string> &definitions);
+        static bool skipDefinitions(RakNet::BitStream *bs, uint32_t definitionCount);
+
+        static void writeVarint(RakNet::BitStream *bs, uint32_t value);
+        static bool readVarint(RakNet::BitStream *bs, uint32_t &value);
+
+    private:
+        static const int channelCount = CHANNEL_PLAYER_POSITION + 1;
+
+        std::array<StringTableEncoder, channelCount> encoders;
+        std::array<StringTableDecoder, channelCount> decoders;
+    };
+}
+
+#endif //OPENMW_STRINGTABLES_HPP
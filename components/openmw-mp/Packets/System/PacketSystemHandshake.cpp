@@ -19,4 +19,9 @@ void PacketSystemHandshake::Packet(RakNet::BitStream *newBitstream, bool send)
         packetValid = false;
         return;
     }
+
+    // Clients from before capabilities were added don't send them, so treat a missing
+    // field as support for none of them instead of as an invalid handshake
+    if (!RW(system->capabilities, send, true))
+        system->capabilities = 0;
 }
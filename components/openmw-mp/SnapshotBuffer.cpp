@@ -0,0 +1,250 @@
+#include "SnapshotBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace mwmp;
+
+namespace
+{
+    const double pi = 3.14159265358979323846;
+
+    // How quickly the clock offset creeps back up after a packet that arrived unusually early,
+    // so a route that has become slower for good is eventually accepted
+    const double clockOffsetRecovery = 1.0 / 512;
+
+    float interpolateAngle(float from, float to, double progress)
+    {
+        double difference = std::fmod(static_cast<double>(to) - from, 2 * pi);
+
+        if (difference > pi)
+            difference -= 2 * pi;
+        else if (difference < -pi)
+            difference += 2 * pi;
+
+        return static_cast<float>(from + difference * progress);
+    }
+}
+
+SnapshotBuffer::SnapshotBuffer()
+{
+    clear();
+}
+
+uint32_t SnapshotBuffer::getTimestamp()
+{
+    auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+double SnapshotBuffer::getTime()
+{
+    auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+}
+
+void SnapshotBuffer::add(const ESM::Position &position, uint32_t timestamp, double arrivalTime)
+{
+    const int32_t elapsed = static_cast<int32_t>(timestamp - newestTimestamp);
+    double time = newestTime + elapsed / 1000.0;
+
+    // Snapshots from a different clock, such as after an actor's authority has passed to another
+    // player, make the transit time jump by far more than any network would
+    if (hasClock && std::abs(arrivalTime - time - lastTransit) > maxTransitChange)
+        clear();
+
+    if (hasClock)
+    {
+        if (elapsed < 0)
+            return;
+
+        if (count > 0)
+        {
+            const Snapshot &newest = get(count - 1);
+            float distanceSquared = 0;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                const float difference = position.pos[i] - newest.position.pos[i];
+                distanceSquared += difference * difference;
+            }
+
+            // Start over from corrections and teleports instead of interpolating towards them
+            if (elapsed == 0 || distanceSquared > teleportDistance * teleportDistance)
+                count = 0;
+        }
+
+        // Transit times include the offset between the clocks, which cancels out of their differences
+        const double transit = arrivalTime - time;
+        jitter += (std::abs(transit - lastTransit) - jitter) / 16;
+        lastTransit = transit;
+
+        if (transit < clockOffset)
+            clockOffset = transit;
+        else
+            clockOffset += (transit - clockOffset) * clockOffsetRecovery;
+
+        // Senders stop sending while standing still, so don't let those pauses count as intervals
+        if (elapsed > 0)
+            sendInterval += (std::min(elapsed / 1000.0, maxPlayoutDelay) - sendInterval) / 8;
+    }
+    else
+    {
+        hasClock = true;
+        time = 0;
+        clockOffset = arrivalTime;
+        lastTransit = arrivalTime;
+    }
+
+    newestTimestamp = timestamp;
+    newestTime = time;
+
+    if (count == capacity)
+    {
+        first = (first + 1) % capacity;
+        --count;
+    }
+
+    Snapshot &snapshot = snapshots[(first + count) % capacity];
+    snapshot.position = position;
+    snapshot.time = time;
+    ++count;
+}
+
+bool SnapshotBuffer::sample(double time, ESM::Position &position)
+{
+    if (count == 0)
+        return false;
+
+    // Move the delay towards what the jitter calls for, but never by more than a tenth of the time
+    // that has passed, so playback only ever speeds up or slows down slightly while it adapts
+    const double targetDelay = std::max(minPlayoutDelay, std::min(maxPlayoutDelay, sendInterval + 3 * jitter));
+
+    if (hasSampled)
+    {
+        const double maxChange = std::max(0.0, time - lastSampleTime) / 10;
+        playoutDelay += std::max(-maxChange, std::min(maxChange, targetDelay - playoutDelay));
+    }
+    else
+    {
+        hasSampled = true;
+        playoutDelay = targetDelay;
+    }
+
+    lastSampleTime = time;
+
+    const double playoutTime = time - clockOffset - playoutDelay;
+    const Snapshot &oldest = get(0);
+    const Snapshot &newest = get(count - 1);
+
+    if (count == 1 || playoutTime <= oldest.time)
+    {
+        position = oldest.position;
+        return true;
+    }
+
+    if (playoutTime >= newest.time)
+    {
+        // Keep going for a little while in case the next snapshot is only late, then ease back to
+        // the newest position, since no snapshot is coming to correct a player who really stopped
+        const double ahead = playoutTime - newest.time;
+
+        position = newest.position;
+
+        if (ahead >= maxExtrapolation + extrapolationReturn)
+            return true;
+
+        float velocity[3];
+        getVelocity(count - 1, velocity);
+
+        double overshoot = std::min(ahead, maxExtrapolation);
+
+        if (ahead > maxExtrapolation)
+        {
+            const double progress = (ahead - maxExtrapolation) / extrapolationReturn;
+            overshoot *= 1 - progress * progress * (3 - 2 * progress);
+        }
+
+        for (int i = 0; i < 3; ++i)
+            position.pos[i] += static_cast<float>(velocity[i] * overshoot);
+
+        return true;
+    }
+
+    std::size_t i = count - 2;
+
+    while (get(i).time > playoutTime)
+        --i;
+
+    const Snapshot &from = get(i);
+    const Snapshot &to = get(i + 1);
+    const double span = to.time - from.time;
+    const double progress = (playoutTime - from.time) / span;
+
+    float fromVelocity[3];
+    float toVelocity[3];
+    getVelocity(i, fromVelocity);
+    getVelocity(i + 1, toVelocity);
+
+    // Cubic Hermite basis functions, with the velocities scaled to the span between the snapshots
+    const double squared = progress * progress;
+    const double cubed = squared * progress;
+    const double fromWeight = 2 * cubed - 3 * squared + 1;
+    const double fromTangentWeight = (cubed - 2 * squared + progress) * span;
+    const double toWeight = -2 * cubed + 3 * squared;
+    const double toTangentWeight = (cubed - squared) * span;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        position.pos[axis] = static_cast<float>(fromWeight * from.position.pos[axis] + fromTangentWeight * fromVelocity[axis] +
+            toWeight * to.position.pos[axis] + toTangentWeight * toVelocity[axis]);
+        position.rot[axis] = interpolateAngle(from.position.rot[axis], to.position.rot[axis], progress);
+    }
+
+    return true;
+}
+
+void SnapshotBuffer::clear()
+{
+    first = 0;
+    count = 0;
+    hasClock = false;
+    hasSampled = false;
+    newestTimestamp = 0;
+    newestTime = 0;
+    clockOffset = 0;
+    lastTransit = 0;
+    jitter = 0;
+    sendInterval = 0;
+    playoutDelay = minPlayoutDelay;
+    lastSampleTime = 0;
+}
+
+bool SnapshotBuffer::isEmpty() const
+{
+    return count == 0;
+}
+
+double SnapshotBuffer::getPlayoutDelay() const
+{
+    return playoutDelay;
+}
+
+const SnapshotBuffer::Snapshot &SnapshotBuffer::get(std::size_t i) const
+{
+    return snapshots[(first + i) % capacity];
+}
+
+void SnapshotBuffer::getVelocity(std::size_t i, float velocity[3]) const
+{
+    const std::size_t previous = i > 0 ? i - 1 : i;
+    const std::size_t next = i + 1 < count ? i + 1 : i;
+    const double span = get(next).time - get(previous).time;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        velocity[axis] = span > 0 ?
+            static_cast<float>((get(next).position.pos[axis] - get(previous).position.pos[axis]) / span) : 0.f;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef OPENMW_SNAPSHOTBUFFER_HPP
+#define OPENMW_SNAPSHOTBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <components/esm/defs.hpp>
+
+namespace mwmp
+{
+    /**
+     * The latest positions received for a player or actor simulated elsewhere, along with the times
+     * their sender took them at, played back with a delay that hides how unevenly they arrive.
+     *
+     * Timestamps are in milliseconds on the sender's own clock, so only their differences matter,
+     * while arrival and sampling times are in seconds on the receiver's clock. The delay adapts to
+     * the jitter measured between the two, and positions are interpolated along a Hermite curve
+     * through the snapshots around the playout time, or extrapolated for a short while past the
+     * newest one if the next is late, after which they ease back to and stay at the newest one.
+     */
+    class SnapshotBuffer
+    {
+    public:
+        static const std::size_t capacity = 32;
+
+        // Snapshots farther than this from the previous one are treated as teleports
+        static constexpr float teleportDistance = 500.f;
+        static constexpr double minPlayoutDelay = 0.03;
+        static constexpr double maxPlayoutDelay = 0.3;
+        static constexpr double maxExtrapolation = 0.1;
+        // How long it takes to get back to the newest snapshot once extrapolation has given up
+        static constexpr double extrapolationReturn = 0.2;
+        // Transit times changing by more than this mean the snapshots now come from another clock
+        static constexpr double maxTransitChange = 1.0;
+
+        SnapshotBuffer();
+
+        // A timestamp for a position being sent, on a clock that only ever goes forward
+        static uint32_t getTimestamp();
+        // The current time in seconds, for arrival and sampling times
+        static double getTime();
+
+        /**
+         * Add a position received at arrivalTime.
+         *
+         * Snapshots older than the newest one arrived out of order and are dropped, while one with the
+         * same timestamp as the newest is a correction the server made and replaces every snapshot,
+         * as does one far enough from the newest to be a teleport.
+         */
+        void add(const ESM::Position &position, uint32_t timestamp, double arrivalTime);
+
+        // Get the position to show at a time, returning false if no snapshots have been added
+        bool sample(double time, ESM::Position &position);
+
+        void clear();
+
+        bool isEmpty() const;
+        double getPlayoutDelay() const;
+
+    private:
+        struct Snapshot
+        {
+            ESM::Position position;
+            double time; // Seconds since the first snapshot on the sender's clock
+        };
+
+        const Snapshot &get(std::size_t i) const;
+        // Velocity at a snapshot, from the snapshots around it where there are any
+        void getVelocity(std::size_t i, float velocity[3]) const;
+
+        std::array<Snapshot, capacity> snapshots;
+        std::size_t first;
+        std::size_t count;
+
+        bool hasClock;
+        bool hasSampled;
+
+        uint32_t newestTimestamp;
+        double newestTime;
+
+        // The smallest transit time seen lately, which stands in for the offset between the clocks
+        double clockOffset;
+        double lastTransit;
+        double jitter;
+        double sendInterval;
+
+        double playoutDelay;
+        double lastSampleTime;
+    };
+}
+
+#endif //OPENMW_SNAPSHOTBUFFER_HPP
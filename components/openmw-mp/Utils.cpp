@@ -7,8 +7,10 @@
 #include <memory>
 #include <iostream>
 #include <sstream>
-#include <boost/crc.hpp>
+#include <array>
+#include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <iomanip>
 
 #ifdef _WIN32
@@ -156,21 +158,96 @@ long int Utils::getFileLength(const char* file)
     return size;
 }
 
-unsigned int ::Utils::crc32Checksum(const std::string &file)
+namespace
 {
-    boost::crc_32_type  crc32;
-    boost::filesystem::ifstream  ifs(file, std::ios_base::binary);
-    if (ifs)
+    typedef std::array<std::array<uint32_t, 256>, 8> Crc32Tables;
+
+    // Tables for processing 8 bytes at a time, where tables[n][b] is the CRC of byte b followed
+    // by n zero bytes
+    constexpr Crc32Tables makeCrc32Tables()
     {
-        do
+        Crc32Tables tables{};
+
+        for (uint32_t i = 0; i < 256; i++)
         {
-            char buffer[1024];
+            uint32_t crc = i;
+
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+
+            tables[0][i] = crc;
+        }
+
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (std::size_t table = 1; table < tables.size(); table++)
+                tables[table][i] = (tables[table - 1][i] >> 8) ^ tables[0][tables[table - 1][i] & 0xFF];
+        }
+
+        return tables;
+    }
+
+    constexpr Crc32Tables crc32Tables = makeCrc32Tables();
+
+    inline uint32_t readLittleEndian(const unsigned char *bytes)
+    {
+        return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+            static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+    }
+}
+
+uint32_t Utils::crc32(const void *data, std::size_t size, uint32_t crc)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+
+    for (; size >= 8; bytes += 8, size -= 8)
+    {
+        const uint32_t low = readLittleEndian(bytes) ^ crc;
+        const uint32_t high = readLittleEndian(bytes + 4);
 
-            ifs.read(buffer, 1024);
-            crc32.process_bytes( buffer, ifs.gcount() );
-        } while (ifs);
+        crc = crc32Tables[7][low & 0xFF] ^ crc32Tables[6][(low >> 8) & 0xFF] ^
+            crc32Tables[5][(low >> 16) & 0xFF] ^ crc32Tables[4][low >> 24] ^
+            crc32Tables[3][high & 0xFF] ^ crc32Tables[2][(high >> 8) & 0xFF] ^
+            crc32Tables[1][(high >> 16) & 0xFF] ^ crc32Tables[0][high >> 24];
     }
-    return crc32.checksum();
+
+    for (; size > 0; bytes++, size--)
+        crc = (crc >> 8) ^ crc32Tables[0][(crc ^ *bytes) & 0xFF];
+
+    return ~crc;
+}
+
+unsigned int ::Utils::crc32Checksum(const std::string &file)
+{
+    boost::system::error_code error;
+    const uintmax_t size = boost::filesystem::file_size(file, error);
+
+    // Empty files can't be mapped, and have a checksum of 0 anyway
+    if (error || size == 0)
+        return 0;
+
+    try
+    {
+        boost::iostreams::mapped_file_source mappedFile(file);
+        return crc32(mappedFile.data(), mappedFile.size());
+    }
+    catch (const std::exception &)
+    {
+        // Fall back to reading the file in chunks, such as when there's no room to map all of it
+    }
+
+    uint32_t crc = 0;
+    boost::filesystem::ifstream ifs(file, std::ios_base::binary);
+    std::vector<char> buffer(1 << 16);
+
+    while (ifs)
+    {
+        ifs.read(buffer.data(), buffer.size());
+        crc = crc32(buffer.data(), static_cast<std::size_t>(ifs.gcount()), crc);
+    }
+
+    return crc;
 }
 
 std::string Utils::getOperatingSystemType()
@@ -2,6 +2,8 @@
 #define UTILS_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -54,6 +56,8 @@ namespace Utils
 
     long int getFileLength(const char *file);
 
+    // Continue a CRC-32 with more data, starting from 0 for the first part
+    uint32_t crc32(const void *data, std::size_t size, uint32_t crc = 0);
     unsigned int crc32Checksum(const std::string &file);
 
     std::string getOperatingSystemType();
@@ -395,6 +395,13 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
             "NavMesh CacheHitRate",
+            "NavMesh DiskCacheSize",
+            "NavMesh DiskCachedTiles",
+            "NavMesh DiskCacheHitRate",
+            "",
+            "CellRef CacheSize",
+            "CellRef CachedContexts",
+            "CellRef CacheHitRate",
             "",
             "Mechanics Actors",
             "Mechanics Objects",